@@ -0,0 +1,56 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_WorldPosition;
+layout(location = 1) in vec2 a_LocalPosition;
+layout(location = 2) in vec4 a_Color;
+layout(location = 3) in vec2 a_ThicknessFade;
+layout(location = 4) in int a_EntityID;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+out vec2 v_LocalPosition;
+out vec4 v_Color;
+out flat float v_Thickness;
+out flat float v_Fade;
+out flat int v_EntityID;
+
+void main()
+{
+	v_LocalPosition = a_LocalPosition;
+	v_Color = a_Color;
+	v_Thickness = a_ThicknessFade.x;
+	v_Fade = a_ThicknessFade.y;
+	v_EntityID = a_EntityID;
+	gl_Position = u_ViewProjection * vec4(a_WorldPosition, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+layout(location = 0) out vec4 color;
+layout(location = 1) out int color2;
+
+in vec2 v_LocalPosition;
+in vec4 v_Color;
+in flat float v_Thickness;
+in flat float v_Fade;
+in flat int v_EntityID;
+
+void main()
+{
+	// Distance from the outer edge: 0 on the rim, 1 at the center
+	float distance = 1.0 - length(v_LocalPosition);
+	float circle = smoothstep(0.0, v_Fade, distance);
+	circle *= smoothstep(v_Thickness + v_Fade, v_Thickness, distance);
+
+	if (circle == 0.0)
+		discard;
+
+	color = v_Color;
+	color.a *= circle;
+	color2 = v_EntityID;
+}
@@ -0,0 +1,90 @@
+#type compute
+#version 450 core
+
+layout(local_size_x = 64) in;
+
+// Same memory layout as Hazel::MeshInstance (64 bytes)
+struct Instance
+{
+	vec4 Data0; // TransformX.xyz, TransformY.x
+	vec4 Data1; // TransformY.yz, TransformZ.xy
+	vec4 Data2; // TransformZ.z, Translation.xyz
+	uvec4 Data3; // Color, TexIndex, TilingFactor, EntityID
+};
+
+struct CullRun
+{
+	vec4 BoundsMin;
+	vec4 BoundsMax;
+	uint FirstInstance;
+	uint InstanceCount;
+	uint Padding0;
+	uint Padding1;
+};
+
+struct DrawCommand
+{
+	uint Count;
+	uint InstanceCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint BaseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer Instances { Instance u_Instances[]; };
+layout(std430, binding = 1) writeonly buffer VisibleInstances { Instance u_VisibleInstances[]; };
+layout(std430, binding = 2) readonly buffer Runs { CullRun u_Runs[]; };
+layout(std430, binding = 3) buffer Commands { DrawCommand u_Commands[]; };
+
+uniform int u_InstanceCount;
+uniform int u_RunCount;
+uniform vec4 u_Planes[6]; // xyz = inward normal, w = distance
+
+// Runs are sorted by FirstInstance, find the one containing this instance
+uint FindRun(uint instance)
+{
+	uint low = 0;
+	uint high = uint(u_RunCount) - 1;
+	while (low < high)
+	{
+		uint middle = (low + high + 1) / 2;
+		if (u_Runs[middle].FirstInstance <= instance)
+			low = middle;
+		else
+			high = middle - 1;
+	}
+	return low;
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_InstanceCount))
+		return;
+
+	Instance instance = u_Instances[index];
+	vec3 axisX = instance.Data0.xyz;
+	vec3 axisY = vec3(instance.Data0.w, instance.Data1.xy);
+	vec3 axisZ = vec3(instance.Data1.zw, instance.Data2.x);
+	vec3 translation = instance.Data2.yzw;
+
+	uint runIndex = FindRun(index);
+	CullRun run = u_Runs[runIndex];
+
+	// World space AABB of the transformed local box (center + absolute extents)
+	vec3 center = (run.BoundsMin.xyz + run.BoundsMax.xyz) * 0.5;
+	vec3 extents = (run.BoundsMax.xyz - run.BoundsMin.xyz) * 0.5;
+	vec3 worldCenter = axisX * center.x + axisY * center.y + axisZ * center.z + translation;
+	vec3 worldExtents = abs(axisX) * extents.x + abs(axisY) * extents.y + abs(axisZ) * extents.z;
+
+	for (int i = 0; i < 6; i++)
+	{
+		vec4 plane = u_Planes[i];
+		float radius = dot(worldExtents, abs(plane.xyz));
+		if (dot(plane.xyz, worldCenter) + plane.w + radius < 0.0)
+			return;
+	}
+
+	uint slot = atomicAdd(u_Commands[runIndex].InstanceCount, 1u);
+	u_VisibleInstances[run.FirstInstance + slot] = instance;
+}
@@ -0,0 +1,24 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_Position;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+// same expression as Texture.glsl so the color pass can test with GL_EQUAL
+invariant gl_Position;
+
+void main()
+{
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+void main()
+{
+}
@@ -0,0 +1,30 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_Position;
+
+layout(location = 2) in vec3 a_TransformX;
+layout(location = 3) in vec3 a_TransformY;
+layout(location = 4) in vec3 a_TransformZ;
+layout(location = 5) in vec3 a_Translation;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+// same expression as MeshInstanced.glsl so the color pass can test with GL_EQUAL
+invariant gl_Position;
+
+void main()
+{
+	vec3 position = a_TransformX * a_Position.x + a_TransformY * a_Position.y + a_TransformZ * a_Position.z + a_Translation;
+	gl_Position = u_ViewProjection * vec4(position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+void main()
+{
+}
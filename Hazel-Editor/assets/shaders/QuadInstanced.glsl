@@ -0,0 +1,57 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+
+layout(location = 2) in vec3 a_TransformX;
+layout(location = 3) in vec3 a_TransformY;
+layout(location = 4) in vec3 a_Translation;
+layout(location = 5) in int a_Color;
+layout(location = 6) in int a_TexIndex;
+layout(location = 7) in float a_TilingFactor;
+layout(location = 8) in int a_EntityID;
+layout(location = 9) in vec4 a_TexRect; // (min.xy, max.xy)
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out flat int v_TexIndex;
+out float v_TilingFactor;
+out flat int v_EntityID;
+
+void main()
+{
+	v_Color = unpackUnorm4x8(uint(a_Color));
+	v_TexCoord = mix(a_TexRect.xy, a_TexRect.zw, a_TexCoord);
+	v_TexIndex = a_TexIndex;
+	v_TilingFactor = a_TilingFactor;
+	v_EntityID = a_EntityID;
+
+	vec3 position = a_TransformX * a_Position.x + a_TransformY * a_Position.y + a_Translation;
+	gl_Position = u_ViewProjection * vec4(position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+layout(location = 0) out vec4 color;
+layout(location = 1) out int color2;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in flat int v_TexIndex;
+in float v_TilingFactor;
+in flat int v_EntityID;
+
+uniform sampler2D u_Textures[32];
+
+void main()
+{
+	color = texture(u_Textures[v_TexIndex], v_TexCoord * v_TilingFactor) * v_Color;
+	color2 = v_EntityID;
+}
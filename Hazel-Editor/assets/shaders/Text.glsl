@@ -0,0 +1,65 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in int a_EntityID;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out flat int v_EntityID;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_EntityID = a_EntityID;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+layout(location = 0) out vec4 color;
+layout(location = 1) out int color2;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in flat int v_EntityID;
+
+uniform sampler2D u_FontAtlas;
+uniform float u_DistanceRange;
+
+float median(float r, float g, float b)
+{
+	return max(min(r, g), min(max(r, g), b));
+}
+
+// Number of screen pixels covered by the atlas distance range at this fragment
+float screenPxRange()
+{
+	vec2 unitRange = vec2(u_DistanceRange) / vec2(textureSize(u_FontAtlas, 0));
+	vec2 screenTexSize = vec2(1.0) / fwidth(v_TexCoord);
+	return max(0.5 * dot(unitRange, screenTexSize), 1.0);
+}
+
+void main()
+{
+	vec3 msd = texture(u_FontAtlas, v_TexCoord).rgb;
+	float sd = median(msd.r, msd.g, msd.b);
+	float screenPxDistance = screenPxRange() * (sd - 0.5);
+	float opacity = clamp(screenPxDistance + 0.5, 0.0, 1.0);
+
+	if (opacity == 0.0)
+		discard;
+
+	color = v_Color;
+	color.a *= opacity;
+	color2 = v_EntityID;
+}
@@ -8,7 +8,13 @@ layout(location = 3) in float a_TexIndex;
 layout(location = 4) in float a_TilingFactor;
 layout(location = 5) in int a_EntityID;
 
-uniform mat4 u_ViewProjection;
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+// must match the depth pre-pass exactly for GL_EQUAL depth testing
+invariant gl_Position;
 //uniform mat4 u_Transform;
 
 out vec4 v_Color;
@@ -41,9 +47,14 @@ in float v_TilingFactor;
 in flat int v_EntityID;
 
 uniform sampler2D u_Textures[32];
+// overdraw heat map: every shaded fragment adds a constant color (additive blending)
+uniform int u_OverdrawView;
 
 void main()
 {
-	color = texture(u_Textures[int(v_TexIndex)], v_TexCoord * v_TilingFactor) * v_Color;
+	if (u_OverdrawView != 0)
+		color = vec4(0.1, 0.05, 0.02, 1.0);
+	else
+		color = texture(u_Textures[int(v_TexIndex)], v_TexCoord * v_TilingFactor) * v_Color;
 	color2 = v_EntityID;
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#type vertex
+#version 460 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+layout(location = 5) in int a_EntityID;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+//uniform mat4 u_Transform;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out flat float v_TexIndex;
+out float v_TilingFactor;
+out flat int v_EntityID;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = a_TexIndex;
+	v_TilingFactor = a_TilingFactor;
+	v_EntityID = a_EntityID;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+	//gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+layout(location = 0) out vec4 color;
+layout(location = 1) out int color2;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in flat float v_TexIndex;
+in float v_TilingFactor;
+in flat int v_EntityID;
+
+uniform sampler2DArray u_TexturePages[16];
+
+vec4 SampleTexture(int texIndex, vec2 texCoord)
+{
+	vec3 coord = vec3(texCoord, float(texIndex & 0xFF));
+	switch (texIndex >> 8)
+	{
+		case 0:  return texture(u_TexturePages[0], coord);
+		case 1:  return texture(u_TexturePages[1], coord);
+		case 2:  return texture(u_TexturePages[2], coord);
+		case 3:  return texture(u_TexturePages[3], coord);
+		case 4:  return texture(u_TexturePages[4], coord);
+		case 5:  return texture(u_TexturePages[5], coord);
+		case 6:  return texture(u_TexturePages[6], coord);
+		case 7:  return texture(u_TexturePages[7], coord);
+		case 8:  return texture(u_TexturePages[8], coord);
+		case 9:  return texture(u_TexturePages[9], coord);
+		case 10: return texture(u_TexturePages[10], coord);
+		case 11: return texture(u_TexturePages[11], coord);
+		case 12: return texture(u_TexturePages[12], coord);
+		case 13: return texture(u_TexturePages[13], coord);
+		case 14: return texture(u_TexturePages[14], coord);
+		case 15: return texture(u_TexturePages[15], coord);
+	}
+	return vec4(1.0);
+}
+
+void main()
+{
+	color = SampleTexture(int(v_TexIndex), v_TexCoord * v_TilingFactor) * v_Color;
+	color2 = v_EntityID;
+}
\ No newline at end of file
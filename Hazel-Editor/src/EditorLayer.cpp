@@ -101,6 +101,8 @@ namespace Hazel
 		// Clear our entity ID attachment to -1
 		m_Framebuffer->ClearAttachment(1, -1);
 
+		m_ActiveScene->SetShowPhysicsColliders(m_ShowPhysicsColliders);
+
 		switch (m_SceneState)
 		{
 		case SceneState::Edit:
@@ -240,6 +242,95 @@ namespace Hazel
 		ImGui::Text("Geometries: %d", stats->GeometryCount);
 		ImGui::Text("Vertices: %d", stats->VertexCount);
 		ImGui::Text("Indices: %d", stats->IndexCount);
+		ImGui::Text("Instances: %d", stats->InstanceCount);
+		ImGui::Text("Texture Binds: %d", stats->TextureBinds);
+		ImGui::Text("Upload: %.2f KB", stats->UploadBytes / 1024.0f);
+		ImGui::Text("Static Quads: %d (rebuilt chunks: %d)", stats->RetainedQuads, stats->RetainedRebuilds);
+		ImGui::Text("Submitted: %d (culled: %d)", stats->SubmittedCount, stats->CulledCount);
+		ImGui::Text("CPU Time: %.3f ms", stats->CPUTime);
+
+		// л2DıεύʽCPUչ / GPUʵ
+		bool instanced = Renderer2D::GetQuadSubmission() == Renderer2D::QuadSubmission::Instanced;
+		if (ImGui::Checkbox("Instanced Quads", &instanced))
+			Renderer2D::SetQuadSubmission(instanced ? Renderer2D::QuadSubmission::Instanced : Renderer2D::QuadSubmission::Batched);
+
+		// л3DύʽCPU任 / ͬʵ
+		bool instancedMeshes = Renderer3D::GetMeshSubmission() == Renderer3D::MeshSubmission::Instanced;
+		if (ImGui::Checkbox("Instanced Meshes", &instancedMeshes))
+			Renderer3D::SetMeshSubmission(instancedMeshes ? Renderer3D::MeshSubmission::Instanced : Renderer3D::MeshSubmission::Batched);
+		bool gpuCulling = Renderer3D::IsGPUCullingEnabled();
+		if (ImGui::Checkbox("GPU Culling", &gpuCulling))
+			Renderer3D::SetGPUCulling(gpuCulling);
+		// ĻϵĴСѡ LODԶ 256 Σ
+		bool meshLODs = Renderer3D::IsLODEnabled();
+		if (ImGui::Checkbox("Mesh LODs", &meshLODs))
+			Renderer3D::SetLODEnabled(meshLODs);
+		// ͸ɽԶԤȾɫͨÿֻɫһ
+		bool frontToBack = Renderer3D::IsFrontToBackSortingEnabled();
+		if (ImGui::Checkbox("Front-to-Back Sorting", &frontToBack))
+			Renderer3D::SetFrontToBackSorting(frontToBack);
+		bool depthPrepass = Renderer3D::IsDepthPrepassEnabled();
+		if (ImGui::Checkbox("Depth Pre-Pass", &depthPrepass))
+			Renderer3D::SetDepthPrepass(depthPrepass);
+		// ͼԽʾͬһرɫĴԽ
+		bool overdrawView = Renderer3D::IsOverdrawViewEnabled();
+		if (ImGui::Checkbox("Overdraw View", &overdrawView))
+			Renderer3D::SetOverdrawView(overdrawView);
+		if (overdrawView && m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f)
+			ImGui::Text("Overdraw: %.2f (%llu fragments)", stats->FragmentCount / (m_ViewportSize.x * m_ViewportSize.y), (unsigned long long)stats->FragmentCount);
+		// CPUڵ޳Ϊ Occluder դ 256x128 Ȼ壬ȫסύ
+		bool occlusionCulling = OcclusionCuller::IsEnabled();
+		if (ImGui::Checkbox("Occlusion Culling", &occlusionCulling))
+			OcclusionCuller::SetEnabled(occlusionCulling);
+		ImGui::Text("Occluded: %d (raster: %.3f ms)", stats->OccludedCount, stats->OcclusionTime);
+		ImGui::Text("Mesh Pool: %d meshes, %d vertices, %d indices", MeshPool::GetMeshCount(), MeshPool::GetVertexCount(), MeshPool::GetIndexCount());
+
+		// ˣͬߴϲ32Ҳ
+		bool textureArrays = Renderer2D::GetTextureBackend() == Renderer2D::TextureBackend::Arrays;
+		if (ImGui::Checkbox("Texture Arrays", &textureArrays))
+			Renderer2D::SetTextureBackend(textureArrays ? Renderer2D::TextureBackend::Arrays : Renderer2D::TextureBackend::Slots);
+
+		// ӳEndScene ʱ/ٺ͸鱣Զ
+		bool sortSprites = Renderer2D::GetSortMode() == Renderer2D::SortMode::Deferred;
+		if (ImGui::Checkbox("Sort Sprites", &sortSprites))
+			Renderer2D::SetSortMode(sortSprites ? Renderer2D::SortMode::Deferred : Renderer2D::SortMode::Immediate);
+
+		// ն㣺ɫ RGBA8뾫ȣ2D/3D ϴԼ
+		bool compactVertices = Renderer2D::GetVertexFormat() == VertexFormat::Compact;
+		if (ImGui::Checkbox("Compact Vertices", &compactVertices))
+		{
+			VertexFormat format = compactVertices ? VertexFormat::Compact : VertexFormat::Standard;
+			Renderer2D::SetVertexFormat(format);
+			Renderer3D::SetVertexFormat(format);
+		}
+
+		// ʱͼƽ̵ľҳ
+		bool spriteAtlas = TextureAtlas::IsEnabled();
+		if (ImGui::Checkbox("Sprite Atlas", &spriteAtlas))
+			TextureAtlas::SetEnabled(spriteAtlas);
+		ImGui::Text("Atlas Pages: %d, Sprites: %d, Pending: %d", TextureAtlas::GetPageCount(), TextureAtlas::GetSpriteCount(), TextureAtlas::GetPendingCount());
+
+		// ߶λ Box Collider 2D 2Dģʽ
+		ImGui::Checkbox("Show Physics Colliders", &m_ShowPhysicsColliders);
+
+		ImGui::Text("Vertex Transform: %s", BatchTransform::PathToString(BatchTransform::GetPath()));
+		ImGui::Text("Batch Workers: %d", ThreadPool::GetWorkerCount() + 1); // ߳
+		if (ImGui::Button("Run Transform Benchmark"))
+			BatchTransform::RunBenchmark(); // ̨
+		if (ImGui::Button("Run BVH Benchmark"))
+			Math::DynamicAABBTree::RunBenchmark();
+		if (ImGui::Button("Run Occlusion Benchmark"))
+			OcclusionCuller::RunBenchmark();
+
+		// ɫƻ棺պ´Ϊʱ̨
+		const ShaderLoadStats& shaderStats = Shader::GetLoadStats();
+		ImGui::Text("Shaders: %d cached, %d compiled, %.2f ms", shaderStats.CacheHits, shaderStats.CacheMisses, shaderStats.LoadTime);
+		if (ImGui::Button("Clear Shader Cache"))
+			Shader::ClearCache();
+		// ޸ assets/shaders µļԶں̨±
+		bool shaderHotReload = ShaderLibrary::IsHotReloadEnabled();
+		if (ImGui::Checkbox("Shader Hot Reload", &shaderHotReload))
+			ShaderLibrary::SetHotReloadEnabled(shaderHotReload);
 
 		ImGui::End();
 
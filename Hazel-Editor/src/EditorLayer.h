@@ -50,6 +50,7 @@ namespace Hazel
 		glm::vec2 m_ViewportBounds[2]; // ֱ𱣴ӿڵϽǺ½
 
 		int m_GizmoType = -1;
+		bool m_ShowPhysicsColliders = false;
 
 		enum class SceneState
 		{
@@ -7,6 +7,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "Hazel/Scene/Components.h"
+#include "Hazel/Renderer/MeshImporter.h"
 #include "Hazel/Scripting/ScriptEngine.h"
 
 namespace Hazel 
@@ -303,6 +304,8 @@ namespace Hazel
 			DisplayAddComponentEntry<CameraComponent>("Camera");
 			DisplayAddComponentEntry<ScriptComponent>("Script");
 			DisplayAddComponentEntry<SpriteRendererComponent>("Sprite Renderer");
+			DisplayAddComponentEntry<CircleRendererComponent>("Circle Renderer");
+			DisplayAddComponentEntry<TextComponent>("Text");
 			DisplayAddComponentEntry<MeshFilterComponent>("Mesh Filter");
 			DisplayAddComponentEntry<MeshRendererComponent>("Mesh Renderer");
 			DisplayAddComponentEntry<Rigidbody2DComponent>("Rigidbody 2D");
@@ -443,6 +446,24 @@ namespace Hazel
 					ImGui::EndDragDropTarget();
 				}
 				ImGui::DragFloat("Tiling Factor", &component.TilingFactor, 0.1f, 0.0f, 100.0f);
+				ImGui::Checkbox("Static", &component.Static);
+			});
+		DrawComponent<CircleRendererComponent>("Circle Renderer", entity, [](auto& component)
+			{
+				ImGui::ColorEdit4("Color", glm::value_ptr(component.Color));
+				ImGui::DragFloat("Thickness", &component.Thickness, 0.025f, 0.0f, 1.0f);
+				ImGui::DragFloat("Fade", &component.Fade, 0.00025f, 0.0f, 1.0f);
+			});
+		DrawComponent<TextComponent>("Text", entity, [](auto& component)
+			{
+				char buffer[1024];
+				memset(buffer, 0, sizeof(buffer));
+				std::strncpy(buffer, component.TextString.c_str(), sizeof(buffer) - 1);
+				if (ImGui::InputTextMultiline("Text String", buffer, sizeof(buffer)))
+					component.TextString = std::string(buffer);
+				ImGui::ColorEdit4("Color", glm::value_ptr(component.Color));
+				ImGui::DragFloat("Kerning", &component.Kerning, 0.025f);
+				ImGui::DragFloat("Line Spacing", &component.LineSpacing, 0.025f);
 			});
 		DrawComponent<MeshFilterComponent>("Mesh Filter", entity, [](auto& component)
 			{
@@ -470,6 +491,28 @@ namespace Hazel
 					}
 					ImGui::EndCombo();
 				}
+
+				//  OBJ/glTF ļΪ Custom 
+				ImGui::Button(component.MeshPath.empty() ? "Mesh" : std::filesystem::path(component.MeshPath).filename().string().c_str(), ImVec2(100.0f, 0.0f));
+				if (ImGui::BeginDragDropTarget())
+				{
+					if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
+					{
+						const wchar_t* path = (const wchar_t*)payload->Data;
+						std::filesystem::path meshPath = std::filesystem::path(g_AssetPath) / path;
+						Ref<Mesh> mesh = MeshImporter::IsSupported(meshPath) ? MeshImporter::Load(meshPath) : nullptr;
+
+						if (mesh)
+						{
+							component.GType = MeshFilterComponent::GeometryType::Custom;
+							component.MeshObj = mesh;
+							component.MeshPath = meshPath.string();
+						}
+						else
+							HZ_WARN("Could not load mesh {0}", meshPath.filename().string());
+					}
+					ImGui::EndDragDropTarget();
+				}
 			});
 		DrawComponent<MeshRendererComponent>("Mesh Renderer", entity, [](auto& component)
 			{
@@ -493,6 +536,7 @@ namespace Hazel
 					ImGui::EndDragDropTarget();
 				}
 				ImGui::DragFloat("Tiling Factor", &component.TilingFactor, 0.1f, 0.0f, 100.0f);
+				ImGui::Checkbox("Occluder", &component.Occluder);
 			});
 
 		DrawComponent<Rigidbody2DComponent>("Rigidbody 2D", entity, [](auto& component)
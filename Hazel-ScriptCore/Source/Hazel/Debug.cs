@@ -0,0 +1,21 @@
+﻿namespace Hazel
+{
+	// Debug primitives are queued by the scene and drawn once, in the current frame
+	public static class Debug
+	{
+		public static void DrawLine(Vector3 p0, Vector3 p1, Vector4 color)
+		{
+			InternalCalls.Debug_DrawLine(ref p0, ref p1, ref color);
+		}
+
+		public static void DrawRect(Vector3 center, Vector2 size, Vector4 color)
+		{
+			InternalCalls.Debug_DrawRect(ref center, ref size, ref color);
+		}
+
+		public static void DrawCircle(Vector3 center, float radius, Vector4 color, float thickness = 1.0f, float fade = 0.005f)
+		{
+			InternalCalls.Debug_DrawCircle(ref center, radius, ref color, thickness, fade);
+		}
+	}
+}
\ No newline at end of file
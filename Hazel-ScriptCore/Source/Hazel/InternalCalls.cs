@@ -21,5 +21,12 @@ namespace Hazel
 		internal extern static void Rigidbody2DComponent_ApplyLinearImpulseToCenter(ulong entityID, ref Vector2 impulse, bool wake);
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static bool Input_IsKeyDown(KeyCode keycode);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Debug_DrawLine(ref Vector3 p0, ref Vector3 p1, ref Vector4 color);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Debug_DrawRect(ref Vector3 center, ref Vector2 size, ref Vector4 color);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Debug_DrawCircle(ref Vector3 center, float radius, ref Vector4 color, float thickness, float fade);
 	}
 }
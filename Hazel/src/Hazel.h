@@ -8,10 +8,13 @@
 #include "Hazel/Core/Input.h"
 #include "Hazel/Core/KeyCodes.h"
 #include "Hazel/Core/MouseCodes.h"
+#include "Hazel/Core/ThreadPool.h"
 
 #include "Hazel/ImGui/ImGuiLayer.h"
 #include "Hazel/Utils/PlatformUtils.h"
 #include "Hazel/Math/Math.h"
+#include "Hazel/Math/Frustum.h"
+#include "Hazel/Math/DynamicAABBTree.h"
 
 #include "Hazel/Scene/Scene.h"
 #include "Hazel/Scene/Entity.h"
@@ -24,10 +27,18 @@
 #include "Hazel/Renderer/Renderer2D.h"
 #include "Hazel/Renderer/RenderCommand.h"
 #include "Hazel/Renderer/RenderStats.h"
+#include "Hazel/Renderer/BatchTransform.h"
+#include "Hazel/Renderer/SubTexture2D.h"
+#include "Hazel/Renderer/TextureAtlas.h"
 #include "Hazel/Renderer/Buffer.h"
+#include "Hazel/Renderer/UniformBuffer.h"
 #include "Hazel/Renderer/Framebuffer.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/Font.h"
+#include "Hazel/Renderer/MeshPool.h"
+#include "Hazel/Renderer/MeshImporter.h"
+#include "Hazel/Renderer/OcclusionCuller.h"
 #include "Hazel/Renderer/VertexArray.h"
 #include "Hazel/Renderer/EditorCamera.h"
 //#include "Hazel/Renderer/OrthoGraphicCamera.h"
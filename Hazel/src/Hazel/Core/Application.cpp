@@ -4,7 +4,9 @@
 #include "Hazel/Events/Event.h"
 #include "Hazel/Core/Log.h"
 #include "Hazel/Core/Input.h"
+#include "Hazel/Core/ThreadPool.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/Shader.h"
 #include "Hazel/Scripting/ScriptEngine.h"
 
 #include "Hazel/Utils/PlatformUtils.h"
@@ -25,6 +27,7 @@ namespace Hazel
 		m_Window->SetEventCallback(HZ_BIND_EVENT_FN(Application::OnEvent));
 		m_Window->SetVSync(true);
 
+		ThreadPool::Init();
 		Renderer::Init();
 		ScriptEngine::Init();
 
@@ -36,6 +39,7 @@ namespace Hazel
 	{
 		ScriptEngine::Shutdown();
 		Renderer::Shutdown();
+		ThreadPool::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -77,6 +81,9 @@ namespace Hazel
 			Timestep timestep = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			// Ϻ̨ɣأɫ
+			ShaderLibrary::Update();
+
 			for (Layer* layer : m_LayerStack)
 			{
 				layer->OnUpdate(timestep);
@@ -91,6 +98,7 @@ namespace Hazel
 			}
 
 			m_ImGuiLayer->End();
+			Renderer::EndFrame();
 			m_Window->OnUpdate();
 		}
 	}
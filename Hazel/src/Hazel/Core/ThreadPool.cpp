@@ -0,0 +1,136 @@
+#include "hzpch.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel
+{
+	struct ThreadPoolData
+	{
+		std::vector<std::thread> Workers;
+		std::mutex Mutex;
+		std::condition_variable WakeCondition; // Ҫ˳
+		std::condition_variable DoneCondition; // Ĺ̶߳˳
+
+		bool Stopping = false;
+		uint64_t Generation = 0; // ÿһ1
+		uint32_t ActiveWorkers = 0; // ִеǰĹ߳
+
+		// ǰ񣬽 ActiveWorkers Ϊ 0 ʱ߳޸
+		const std::function<void(uint32_t, uint32_t)>* Func = nullptr;
+		uint32_t Count = 0;
+		uint32_t Grain = 0;
+		uint32_t ChunkCount = 0;
+		std::atomic<uint32_t> NextChunk = 0;
+	};
+	static ThreadPoolData s_PoolData;
+
+	// ȡֱ꣬쵽̸ִ߳
+	static void RunChunks()
+	{
+		uint32_t chunk;
+		while ((chunk = s_PoolData.NextChunk.fetch_add(1, std::memory_order_relaxed)) < s_PoolData.ChunkCount)
+		{
+			uint32_t begin = chunk * s_PoolData.Grain;
+			uint32_t end = std::min(begin + s_PoolData.Grain, s_PoolData.Count);
+			(*s_PoolData.Func)(begin, end);
+		}
+	}
+
+	static void WorkerLoop()
+	{
+		uint64_t generation = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(s_PoolData.Mutex);
+				s_PoolData.WakeCondition.wait(lock, [&generation]() { return s_PoolData.Stopping || s_PoolData.Generation != generation; });
+				if (s_PoolData.Stopping)
+					return;
+
+				generation = s_PoolData.Generation;
+				s_PoolData.ActiveWorkers++;
+			}
+
+			RunChunks();
+
+			{
+				std::lock_guard<std::mutex> lock(s_PoolData.Mutex);
+				s_PoolData.ActiveWorkers--;
+			}
+			s_PoolData.DoneCondition.notify_one();
+		}
+	}
+
+	void ThreadPool::Init(uint32_t workerCount)
+	{
+		HZ_CORE_ASSERT(s_PoolData.Workers.empty(), "ThreadPool already initialized!");
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		s_PoolData.Stopping = false;
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_PoolData.Workers.emplace_back(WorkerLoop);
+
+		HZ_CORE_INFO("ThreadPool: {0} worker threads", workerCount);
+	}
+
+	void ThreadPool::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_PoolData.Mutex);
+			s_PoolData.Stopping = true;
+		}
+		s_PoolData.WakeCondition.notify_all();
+
+		for (std::thread& worker : s_PoolData.Workers)
+			worker.join();
+		s_PoolData.Workers.clear();
+	}
+
+	uint32_t ThreadPool::GetWorkerCount()
+	{
+		return (uint32_t)s_PoolData.Workers.size();
+	}
+
+	void ThreadPool::ParallelFor(uint32_t count, uint32_t minGrain, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		if (count == 0)
+			return;
+
+		// ÿ߳Լֵ4䣬ڸؾ
+		uint32_t threadCount = (uint32_t)s_PoolData.Workers.size() + 1;
+		uint32_t grain = std::max(std::max(minGrain, 1u), (count + threadCount * 4 - 1) / (threadCount * 4));
+		if (threadCount == 1 || count <= grain)
+		{
+			func(0, count);
+			return;
+		}
+
+		{
+			// һ񷢲Ĺܻ߳̿ RunChunks У˳ٸд
+			std::unique_lock<std::mutex> lock(s_PoolData.Mutex);
+			s_PoolData.DoneCondition.wait(lock, []() { return s_PoolData.ActiveWorkers == 0; });
+			s_PoolData.Func = &func;
+			s_PoolData.Count = count;
+			s_PoolData.Grain = grain;
+			s_PoolData.ChunkCount = (count + grain - 1) / grain;
+			s_PoolData.NextChunk.store(0, std::memory_order_relaxed);
+			s_PoolData.Generation++;
+		}
+		s_PoolData.WakeCondition.notify_all();
+
+		RunChunks();
+
+		// ȫ꣬ȴ쵽Ĺִ߳
+		std::unique_lock<std::mutex> lock(s_PoolData.Mutex);
+		s_PoolData.DoneCondition.wait(lock, []() { return s_PoolData.ActiveWorkers == 0; });
+	}
+}
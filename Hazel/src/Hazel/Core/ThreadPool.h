@@ -0,0 +1,21 @@
+#pragma once
+
+#include <functional>
+
+namespace Hazel
+{
+	// פ̳߳أĿǰֻṩ ParallelForȾɶݲ
+	// ̵ֻ߳ã߳ҲִУ֧Ƕ
+	class ThreadPool
+	{
+	public:
+		// workerCount Ϊ 0 ʱʹ (Ӳ߳ - 1) ߳
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		static uint32_t GetWorkerCount();
+
+		//  [0, count) зΪС minGrain 䣬е func(begin, end)ȫɺ󷵻
+		static void ParallelFor(uint32_t count, uint32_t minGrain, const std::function<void(uint32_t, uint32_t)>& func);
+	};
+}
@@ -0,0 +1,434 @@
+#include "hzpch.h"
+#include "DynamicAABBTree.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <random>
+
+namespace Hazel::Math
+{
+	static AABB Union(const AABB& a, const AABB& b)
+	{
+		return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+	}
+
+	DynamicAABBTree::DynamicAABBTree(float margin)
+		: m_Margin(margin)
+	{
+	}
+
+	int32_t DynamicAABBTree::AllocateNode()
+	{
+		if (m_FreeList == NullNode)
+		{
+			m_Nodes.emplace_back();
+			return (int32_t)m_Nodes.size() - 1;
+		}
+
+		int32_t node = m_FreeList;
+		m_FreeList = m_Nodes[node].Parent;
+		m_Nodes[node] = Node();
+		return node;
+	}
+
+	void DynamicAABBTree::FreeNode(int32_t node)
+	{
+		m_Nodes[node].Parent = m_FreeList;
+		m_Nodes[node].Height = -1;
+		m_FreeList = node;
+	}
+
+	int32_t DynamicAABBTree::CreateProxy(const AABB& box, uint32_t userData)
+	{
+		int32_t proxy = AllocateNode();
+		Node& node = m_Nodes[proxy];
+		node.Box = AABB(box.Min - glm::vec3(m_Margin), box.Max + glm::vec3(m_Margin));
+		node.Bounds = box;
+		node.UserData = userData;
+		node.Height = 0;
+		InsertLeaf(proxy);
+		m_ProxyCount++;
+		return proxy;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32_t proxy)
+	{
+		HZ_CORE_ASSERT(proxy >= 0 && proxy < (int32_t)m_Nodes.size() && m_Nodes[proxy].IsLeaf(), "Invalid proxy!");
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		m_ProxyCount--;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32_t proxy, const AABB& box)
+	{
+		HZ_CORE_ASSERT(proxy >= 0 && proxy < (int32_t)m_Nodes.size() && m_Nodes[proxy].IsLeaf(), "Invalid proxy!");
+		Node& node = m_Nodes[proxy];
+		node.Bounds = box;
+
+		// ڷŴΧڣҷŴΧûбҪĴ̫ࣨСҪսʱṹ
+		AABB fat(box.Min - glm::vec3(m_Margin), box.Max + glm::vec3(m_Margin));
+		if (node.Box.Contains(box))
+		{
+			AABB huge(fat.Min - glm::vec3(4.0f * m_Margin), fat.Max + glm::vec3(4.0f * m_Margin));
+			if (huge.Contains(node.Box))
+				return false;
+		}
+
+		RemoveLeaf(proxy);
+		m_Nodes[proxy].Box = fat;
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NullNode;
+		m_FreeList = NullNode;
+		m_ProxyCount = 0;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (m_Root == NullNode)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = NullNode;
+			return;
+		}
+
+		// ʽѡֵܽڵ㣺ڵǰڵ㴦ϲĴС½һӽڵʱֹͣ
+		const AABB leafBox = m_Nodes[leaf].Box;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+			float area = node.Box.GetSurfaceArea();
+			float combinedArea = Union(node.Box, leafBox).GetSurfaceArea();
+
+			// ½ڵĴۣԼ½ʱȰΧĴ
+			float cost = 2.0f * combinedArea;
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				const Node& childNode = m_Nodes[child];
+				float childArea = Union(childNode.Box, leafBox).GetSurfaceArea();
+				if (!childNode.IsLeaf())
+					childArea -= childNode.Box.GetSurfaceArea();
+				return childArea + inheritanceCost;
+			};
+			float cost1 = descendCost(node.Child1);
+			float cost2 = descendCost(node.Child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		int32_t sibling = index;
+		int32_t oldParent = m_Nodes[sibling].Parent;
+		int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Box = Union(leafBox, m_Nodes[sibling].Box);
+		m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+		m_Nodes[newParent].Child1 = sibling;
+		m_Nodes[newParent].Child2 = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if (oldParent == NullNode)
+			m_Root = newParent;
+		else if (m_Nodes[oldParent].Child1 == sibling)
+			m_Nodes[oldParent].Child1 = newParent;
+		else
+			m_Nodes[oldParent].Child2 = newParent;
+
+		Refit(m_Nodes[leaf].Parent);
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NullNode;
+			return;
+		}
+
+		// ڵֵܽڵ㶥
+		int32_t parent = m_Nodes[leaf].Parent;
+		int32_t grandParent = m_Nodes[parent].Parent;
+		int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		if (grandParent == NullNode)
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+			return;
+		}
+
+		if (m_Nodes[grandParent].Child1 == parent)
+			m_Nodes[grandParent].Child1 = sibling;
+		else
+			m_Nodes[grandParent].Child2 = sibling;
+		m_Nodes[sibling].Parent = grandParent;
+		FreeNode(parent);
+
+		Refit(grandParent);
+	}
+
+	//  index ƽⲢ°Χк͸߶
+	void DynamicAABBTree::Refit(int32_t index)
+	{
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			Node& node = m_Nodes[index];
+			const Node& child1 = m_Nodes[node.Child1];
+			const Node& child2 = m_Nodes[node.Child2];
+			node.Box = Union(child1.Box, child2.Box);
+			node.Height = 1 + std::max(child1.Height, child2.Height);
+
+			index = node.Parent;
+		}
+	}
+
+	// ߶Ȳ1ʱѽϸߵӽڵתתĸ
+	int32_t DynamicAABBTree::Balance(int32_t iA)
+	{
+		Node& A = m_Nodes[iA];
+		if (A.IsLeaf() || A.Height < 2)
+			return iA;
+
+		int32_t iB = A.Child1;
+		int32_t iC = A.Child2;
+		Node& B = m_Nodes[iB];
+		Node& C = m_Nodes[iC];
+
+		int32_t balance = C.Height - B.Height;
+		if (balance > 1)
+		{
+			// C ΪĸA Ϊ C ӽڵ
+			int32_t iF = C.Child1;
+			int32_t iG = C.Child2;
+			Node& F = m_Nodes[iF];
+			Node& G = m_Nodes[iG];
+
+			C.Child1 = iA;
+			C.Parent = A.Parent;
+			A.Parent = iC;
+
+			if (C.Parent == NullNode)
+				m_Root = iC;
+			else if (m_Nodes[C.Parent].Child1 == iA)
+				m_Nodes[C.Parent].Child1 = iC;
+			else
+				m_Nodes[C.Parent].Child2 = iC;
+
+			// C ϸߵڵ㣬ϰĽ A
+			if (F.Height > G.Height)
+			{
+				C.Child2 = iF;
+				A.Child2 = iG;
+				G.Parent = iA;
+				A.Box = Union(B.Box, G.Box);
+				C.Box = Union(A.Box, F.Box);
+				A.Height = 1 + std::max(B.Height, G.Height);
+				C.Height = 1 + std::max(A.Height, F.Height);
+			}
+			else
+			{
+				C.Child2 = iG;
+				A.Child2 = iF;
+				F.Parent = iA;
+				A.Box = Union(B.Box, F.Box);
+				C.Box = Union(A.Box, G.Box);
+				A.Height = 1 + std::max(B.Height, F.Height);
+				C.Height = 1 + std::max(A.Height, G.Height);
+			}
+			return iC;
+		}
+
+		if (balance < -1)
+		{
+			// B Ϊĸ
+			int32_t iD = B.Child1;
+			int32_t iE = B.Child2;
+			Node& D = m_Nodes[iD];
+			Node& E = m_Nodes[iE];
+
+			B.Child1 = iA;
+			B.Parent = A.Parent;
+			A.Parent = iB;
+
+			if (B.Parent == NullNode)
+				m_Root = iB;
+			else if (m_Nodes[B.Parent].Child1 == iA)
+				m_Nodes[B.Parent].Child1 = iB;
+			else
+				m_Nodes[B.Parent].Child2 = iB;
+
+			if (D.Height > E.Height)
+			{
+				B.Child2 = iD;
+				A.Child1 = iE;
+				E.Parent = iA;
+				A.Box = Union(C.Box, E.Box);
+				B.Box = Union(A.Box, D.Box);
+				A.Height = 1 + std::max(C.Height, E.Height);
+				B.Height = 1 + std::max(A.Height, D.Height);
+			}
+			else
+			{
+				B.Child2 = iE;
+				A.Child1 = iD;
+				D.Parent = iA;
+				A.Box = Union(C.Box, D.Box);
+				B.Box = Union(A.Box, E.Box);
+				A.Height = 1 + std::max(C.Height, D.Height);
+				B.Height = 1 + std::max(A.Height, E.Height);
+			}
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void DynamicAABBTree::RunBenchmark()
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		auto milliseconds = [](Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		};
+
+		for (uint32_t count : { 1000u, 10000u, 100000u })
+		{
+			// ܶȹ̶ÿƽռ 4x4x4 Ŀռ
+			std::mt19937 random(1234);
+			float extent = std::cbrt((float)count) * 4.0f;
+			std::uniform_real_distribution<float> position(-extent * 0.5f, extent * 0.5f);
+			std::uniform_real_distribution<float> size(0.25f, 1.0f);
+			std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+
+			std::vector<AABB> boxes(count);
+			for (AABB& box : boxes)
+			{
+				glm::vec3 center(position(random), position(random), position(random));
+				glm::vec3 half(size(random), size(random), size(random));
+				box = AABB(center - half, center + half);
+			}
+
+			DynamicAABBTree tree;
+			std::vector<int32_t> proxies(count);
+			auto start = Clock::now();
+			for (uint32_t i = 0; i < count; i++)
+				proxies[i] = tree.CreateProxy(boxes[i], i);
+			double buildTime = milliseconds(start);
+
+			// ÿ֡ 10% Сƶ 1/10 ˲Ƶ
+			uint32_t reinserted = 0;
+			start = Clock::now();
+			for (uint32_t i = 0; i < count; i += 10)
+			{
+				glm::vec3 offset = (i % 100 == 0)
+					? glm::vec3(position(random), position(random), position(random)) - boxes[i].Min
+					: glm::vec3(jitter(random), jitter(random), jitter(random));
+				boxes[i] = AABB(boxes[i].Min + offset, boxes[i].Max + offset);
+				reinserted += tree.MoveProxy(proxies[i], boxes[i]) ? 1 : 0;
+			}
+			double moveTime = milliseconds(start);
+
+			// ӳһ࿴ĵ͸׶
+			glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, extent * 0.5f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+			Frustum frustum(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, extent * 0.5f) * view);
+
+			const uint32_t iterations = 20;
+			uint32_t treeVisible = 0, linearVisible = 0;
+			start = Clock::now();
+			for (uint32_t i = 0; i < iterations; i++)
+				tree.Query(frustum, [&](uint32_t) { treeVisible++; return true; });
+			double treeFrustumTime = milliseconds(start) / iterations;
+
+			start = Clock::now();
+			for (uint32_t i = 0; i < iterations; i++)
+			{
+				for (const AABB& box : boxes)
+					linearVisible += frustum.Intersects(box) ? 1 : 0;
+			}
+			double linearFrustumTime = milliseconds(start) / iterations;
+
+			// СΧѯ
+			const uint32_t queries = 100;
+			std::vector<AABB> regions(queries);
+			std::vector<Ray> rays;
+			for (uint32_t i = 0; i < queries; i++)
+			{
+				glm::vec3 center(position(random), position(random), position(random));
+				regions[i] = AABB(center - glm::vec3(2.0f), center + glm::vec3(2.0f));
+				glm::vec3 direction = glm::vec3(position(random), position(random), position(random)) - center;
+				rays.emplace_back(center, glm::normalize(direction + glm::vec3(1e-3f)));
+			}
+
+			uint32_t treeOverlaps = 0, linearOverlaps = 0;
+			start = Clock::now();
+			for (const AABB& region : regions)
+				tree.Query(region, [&](uint32_t) { treeOverlaps++; return true; });
+			double treeQueryTime = milliseconds(start);
+
+			start = Clock::now();
+			for (const AABB& region : regions)
+			{
+				for (const AABB& box : boxes)
+					linearOverlaps += region.Overlaps(box) ? 1 : 0;
+			}
+			double linearQueryTime = milliseconds(start);
+
+			float treeDistanceSum = 0.0f, linearDistanceSum = 0.0f;
+			start = Clock::now();
+			for (const Ray& ray : rays)
+			{
+				float closest = std::numeric_limits<float>::max();
+				tree.Raycast(ray, closest, [&](uint32_t index, float maxDistance)
+					{
+						float distance;
+						if (ray.Intersects(boxes[index], maxDistance, distance))
+							closest = distance;
+						return std::min(maxDistance, closest);
+					});
+				if (closest < std::numeric_limits<float>::max())
+					treeDistanceSum += closest;
+			}
+			double treeRaycastTime = milliseconds(start);
+
+			start = Clock::now();
+			for (const Ray& ray : rays)
+			{
+				float closest = std::numeric_limits<float>::max();
+				for (const AABB& box : boxes)
+				{
+					float distance;
+					if (ray.Intersects(box, closest, distance))
+						closest = distance;
+				}
+				if (closest < std::numeric_limits<float>::max())
+					linearDistanceSum += closest;
+			}
+			double linearRaycastTime = milliseconds(start);
+
+			HZ_CORE_INFO("AABBTree {0} boxes: build {1:.2f} ms, move 10% {2:.3f} ms ({3} reinserted), height {4}",
+				count, buildTime, moveTime, reinserted, tree.GetHeight());
+			HZ_CORE_INFO("AABBTree {0} boxes: frustum {1:.3f} ms vs linear {2:.3f} ms ({3} visible)",
+				count, treeFrustumTime, linearFrustumTime, treeVisible / iterations);
+			HZ_CORE_INFO("AABBTree {0} boxes: {1} AABB queries {2:.3f} ms vs linear {3:.3f} ms, {1} raycasts {4:.3f} ms vs linear {5:.3f} ms",
+				count, queries, treeQueryTime, linearQueryTime, treeRaycastTime, linearRaycastTime);
+
+			if (treeVisible != linearVisible || treeOverlaps != linearOverlaps || std::abs(treeDistanceSum - linearDistanceSum) > 1e-3f * linearDistanceSum)
+				HZ_CORE_WARN("AABBTree {0} boxes: results differ from linear search!", count);
+		}
+	}
+}
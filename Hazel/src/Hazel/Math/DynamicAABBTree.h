@@ -0,0 +1,199 @@
+#pragma once
+
+#include "Hazel/Math/Frustum.h"
+
+#include <vector>
+
+namespace Hazel::Math
+{
+	// ̬Χв/ɾתƽ⣩
+	// ҶڵڰΧʵʰΧлϷŴ MarginڷŴΧƶʱֻʵʰΧУĶṹ
+	// ѯҶڵʹʵʰΧУصΪʱ userData
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr int32_t NullNode = -1;
+
+		DynamicAABBTree(float margin = 0.1f);
+
+		int32_t CreateProxy(const AABB& box, uint32_t userData);
+		void DestroyProxy(int32_t proxy);
+		// ΧгŴΧʱ²벢 trueֻʵʰΧ
+		bool MoveProxy(int32_t proxy, const AABB& box);
+		void Clear();
+
+		uint32_t GetUserData(int32_t proxy) const { return m_Nodes[proxy].UserData; }
+		const AABB& GetBounds(int32_t proxy) const { return m_Nodes[proxy].Bounds; }
+		uint32_t GetProxyCount() const { return m_ProxyCount; }
+		int32_t GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height; }
+
+		// callback(uint32_t userData) false ʱֹͣѯ
+		template<typename Callback>
+		void Query(const AABB& box, Callback&& callback) const;
+		template<typename Callback>
+		void Query(const Frustum& frustum, Callback&& callback) const;
+		// callback(uint32_t userData, float maxDistance) µ루иʱߣ 0 ֹͣ
+		template<typename Callback>
+		void Raycast(const Ray& ray, float maxDistance, Callback&& callback) const;
+
+		//  1k/10k/100k Χ϶ԱԱĹ/ƶ/ѯʱ־
+		static void RunBenchmark();
+
+	private:
+		struct Node
+		{
+			AABB Box;		// ҶڵΪŴİΧУڲڵΪӽڵĲ
+			AABB Bounds;	// ҶڵʵʰΧ
+			uint32_t UserData = 0;
+			int32_t Parent = NullNode; // нڵһ
+			int32_t Child1 = NullNode;
+			int32_t Child2 = NullNode;
+			int32_t Height = 0; // ҶڵΪ0нڵΪ-1
+
+			bool IsLeaf() const { return Child1 == NullNode; }
+		};
+
+		static constexpr uint32_t StackSize = 256;
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t node);
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		int32_t Balance(int32_t node);
+		void Refit(int32_t node);
+
+		template<typename Callback>
+		bool VisitLeaves(int32_t node, Callback& callback) const;
+
+	private:
+		std::vector<Node> m_Nodes;
+		int32_t m_Root = NullNode;
+		int32_t m_FreeList = NullNode;
+		uint32_t m_ProxyCount = 0;
+		float m_Margin;
+	};
+
+	template<typename Callback>
+	void DynamicAABBTree::Query(const AABB& box, Callback&& callback) const
+	{
+		if (m_Root == NullNode)
+			return;
+
+		int32_t stack[StackSize];
+		uint32_t top = 0;
+		stack[top++] = m_Root;
+		while (top > 0)
+		{
+			const Node& node = m_Nodes[stack[--top]];
+			if (!node.Box.Overlaps(box))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if (node.Bounds.Overlaps(box) && !callback(node.UserData))
+					return;
+			}
+			else
+			{
+				HZ_CORE_ASSERT(top + 2 <= StackSize, "DynamicAABBTree is too deep!");
+				stack[top++] = node.Child1;
+				stack[top++] = node.Child2;
+			}
+		}
+	}
+
+	template<typename Callback>
+	bool DynamicAABBTree::VisitLeaves(int32_t root, Callback& callback) const
+	{
+		int32_t stack[StackSize];
+		uint32_t top = 0;
+		stack[top++] = root;
+		while (top > 0)
+		{
+			const Node& node = m_Nodes[stack[--top]];
+			if (node.IsLeaf())
+			{
+				if (!callback(node.UserData))
+					return false;
+			}
+			else
+			{
+				HZ_CORE_ASSERT(top + 2 <= StackSize, "DynamicAABBTree is too deep!");
+				stack[top++] = node.Child1;
+				stack[top++] = node.Child2;
+			}
+		}
+		return true;
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::Query(const Frustum& frustum, Callback&& callback) const
+	{
+		if (m_Root == NullNode)
+			return;
+
+		int32_t stack[StackSize];
+		uint32_t top = 0;
+		stack[top++] = m_Root;
+		while (top > 0)
+		{
+			int32_t index = stack[--top];
+			const Node& node = m_Nodes[index];
+			Frustum::Containment containment = frustum.Classify(node.Box);
+			if (containment == Frustum::Containment::Outside)
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if ((containment == Frustum::Containment::Inside || frustum.Intersects(node.Bounds)) && !callback(node.UserData))
+					return;
+			}
+			else if (containment == Frustum::Containment::Inside)
+			{
+				// ׶ڣҶڵʵʰΧбȻҲڲ
+				if (!VisitLeaves(index, callback))
+					return;
+			}
+			else
+			{
+				HZ_CORE_ASSERT(top + 2 <= StackSize, "DynamicAABBTree is too deep!");
+				stack[top++] = node.Child1;
+				stack[top++] = node.Child2;
+			}
+		}
+	}
+
+	template<typename Callback>
+	void DynamicAABBTree::Raycast(const Ray& ray, float maxDistance, Callback&& callback) const
+	{
+		if (m_Root == NullNode)
+			return;
+
+		int32_t stack[StackSize];
+		uint32_t top = 0;
+		stack[top++] = m_Root;
+		while (top > 0)
+		{
+			const Node& node = m_Nodes[stack[--top]];
+			float distance;
+			if (!ray.Intersects(node.Box, maxDistance, distance))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if (!ray.Intersects(node.Bounds, maxDistance, distance))
+					continue;
+
+				maxDistance = callback(node.UserData, maxDistance);
+				if (maxDistance <= 0.0f)
+					return;
+			}
+			else
+			{
+				HZ_CORE_ASSERT(top + 2 <= StackSize, "DynamicAABBTree is too deep!");
+				stack[top++] = node.Child1;
+				stack[top++] = node.Child2;
+			}
+		}
+	}
+}
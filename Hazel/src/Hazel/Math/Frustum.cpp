@@ -0,0 +1,134 @@
+#include "hzpch.h"
+#include "Frustum.h"
+
+namespace Hazel::Math
+{
+	AABB AABB::Transform(const glm::mat4& transform) const
+	{
+		if (IsEmpty())
+			return AABB();
+
+		glm::vec3 center = (Min + Max) * 0.5f;
+		glm::vec3 extents = (Max - Min) * 0.5f;
+
+		glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+		glm::vec3 worldExtents =
+			glm::abs(glm::vec3(transform[0])) * extents.x +
+			glm::abs(glm::vec3(transform[1])) * extents.y +
+			glm::abs(glm::vec3(transform[2])) * extents.z;
+
+		return AABB(worldCenter - worldExtents, worldCenter + worldExtents);
+	}
+
+	bool Ray::Intersects(const AABB& box, float maxDistance, float& distance) const
+	{
+		if (box.IsEmpty())
+			return false;
+
+		// slab Ϊ0ʱõ infȽϽȻȷ
+		glm::vec3 inverse = 1.0f / Direction;
+		glm::vec3 t0 = (box.Min - Origin) * inverse;
+		glm::vec3 t1 = (box.Max - Origin) * inverse;
+		glm::vec3 tNear = glm::min(t0, t1);
+		glm::vec3 tFar = glm::max(t0, t1);
+
+		float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+		if (enter > exit)
+			return false;
+
+		distance = enter;
+		return true;
+	}
+
+	bool Ray::Intersects(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& distance) const
+	{
+		// Moller-Trumbore
+		glm::vec3 edge1 = v1 - v0;
+		glm::vec3 edge2 = v2 - v0;
+		glm::vec3 p = glm::cross(Direction, edge2);
+		float determinant = glm::dot(edge1, p);
+		if (std::abs(determinant) < 1e-8f)
+			return false;
+
+		float inverse = 1.0f / determinant;
+		glm::vec3 s = Origin - v0;
+		float u = glm::dot(s, p) * inverse;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		glm::vec3 q = glm::cross(s, edge1);
+		float v = glm::dot(Direction, q) * inverse;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		float t = glm::dot(edge2, q) * inverse;
+		if (t < 0.0f)
+			return false;
+
+		distance = t;
+		return true;
+	}
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		// Gribb-Hartmannüռ -w <= x,y,z <= wƽ漴4мӼǰ3Уglm д洢
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+			rows[i] = { viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] };
+
+		m_Planes[0] = rows[3] + rows[0]; // 
+		m_Planes[1] = rows[3] - rows[0]; // 
+		m_Planes[2] = rows[3] + rows[1]; // 
+		m_Planes[3] = rows[3] - rows[1]; // 
+		m_Planes[4] = rows[3] + rows[2]; // 
+		m_Planes[5] = rows[3] - rows[2]; // Զ
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		if (box.IsEmpty())
+			return false;
+
+		// ֻΧڷ߷ԶĶ㣬ҲƽʱӶ
+		for (const glm::vec4& plane : m_Planes)
+		{
+			glm::vec3 positive = {
+				plane.x >= 0.0f ? box.Max.x : box.Min.x,
+				plane.y >= 0.0f ? box.Max.y : box.Min.y,
+				plane.z >= 0.0f ? box.Max.z : box.Min.z
+			};
+			if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+				return false;
+		}
+		return true;
+	}
+
+	Frustum::Containment Frustum::Classify(const AABB& box) const
+	{
+		if (box.IsEmpty())
+			return Containment::Outside;
+
+		Containment result = Containment::Inside;
+		for (const glm::vec4& plane : m_Planes)
+		{
+			glm::vec3 positive = {
+				plane.x >= 0.0f ? box.Max.x : box.Min.x,
+				plane.y >= 0.0f ? box.Max.y : box.Min.y,
+				plane.z >= 0.0f ? box.Max.z : box.Min.z
+			};
+			if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+				return Containment::Outside;
+
+			// ĶҲڲʱȫڸƽڲ
+			glm::vec3 negative = {
+				plane.x >= 0.0f ? box.Min.x : box.Max.x,
+				plane.y >= 0.0f ? box.Min.y : box.Max.y,
+				plane.z >= 0.0f ? box.Min.z : box.Max.z
+			};
+			if (glm::dot(glm::vec3(plane), negative) + plane.w < 0.0f)
+				result = Containment::Intersects;
+		}
+		return result;
+	}
+}
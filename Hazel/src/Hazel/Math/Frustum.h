@@ -0,0 +1,89 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <limits>
+
+namespace Hazel::Math
+{
+	// ΧУĬϹΪպУMin > Max
+	struct AABB
+	{
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		AABB() = default;
+		AABB(const glm::vec3& min, const glm::vec3& max) : Min(min), Max(max) {}
+
+		bool IsEmpty() const { return Min.x > Max.x; }
+
+		void Merge(const AABB& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		// 任һռȡΧУ + ֵչİ볤
+		AABB Transform(const glm::mat4& transform) const;
+
+		bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+		}
+
+		bool Overlaps(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Max)) && glm::all(glm::greaterThanEqual(Max, other.Min));
+		}
+
+		float GetSurfaceArea() const
+		{
+			glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+	};
+
+	struct BoundingSphere
+	{
+		glm::vec3 Center = glm::vec3(0.0f);
+		float Radius = 0.0f;
+	};
+
+	//  Origin + t * DirectionDirection һʱ t Ϊ
+	struct Ray
+	{
+		glm::vec3 Origin;
+		glm::vec3 Direction;
+
+		Ray(const glm::vec3& origin, const glm::vec3& direction) : Origin(origin), Direction(direction) {}
+
+		// ΧཻںҲ㣩ҽ벻 maxDistance ʱ true
+		bool Intersects(const AABB& box, float maxDistance, float& distance) const;
+		// ཻʱ true
+		bool Intersects(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& distance) const;
+	};
+
+	//  ViewProjection ȡ6üƽ棬͸ͶӰͨ
+	class Frustum
+	{
+	public:
+		enum class Containment
+		{
+			Outside = 0, Intersects = 1, Inside = 2
+		};
+
+		Frustum() = default;
+		explicit Frustum(const glm::mat4& viewProjection);
+
+		// Χ׶ཻڲʱ trueزԣ׶丽Ϊཻ
+		bool Intersects(const AABB& box) const;
+		// ȫڲ޳ʱٲ
+		Containment Classify(const AABB& box) const;
+
+		const std::array<glm::vec4, 6>& GetPlanes() const { return m_Planes; }
+
+	private:
+		std::array<glm::vec4, 6> m_Planes; // xyz Ϊڵķߣ p ڲʱ dot(xyz, p) + w >= 0
+	};
+}
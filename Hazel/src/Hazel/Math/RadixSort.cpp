@@ -0,0 +1,60 @@
+#include "hzpch.h"
+#include "RadixSort.h"
+
+namespace Hazel::Math
+{
+	void RadixSort(uint64_t* keys, uint32_t* values, uint64_t* tmpKeys, uint32_t* tmpValues, uint32_t count)
+	{
+		if (count < 2)
+			return;
+
+		// һαͳȫ8ֽڵֱͼ
+		uint32_t histograms[8][256] = {};
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t key = keys[i];
+			for (uint32_t pass = 0; pass < 8; pass++)
+				histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+		}
+
+		uint64_t* srcKeys = keys;
+		uint32_t* srcValues = values;
+		uint64_t* dstKeys = tmpKeys;
+		uint32_t* dstValues = tmpValues;
+
+		for (uint32_t pass = 0; pass < 8; pass++)
+		{
+			uint32_t* histogram = histograms[pass];
+			uint32_t shift = pass * 8;
+
+			// мڸֽͬһ˲ı˳
+			if (histogram[(srcKeys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t n = histogram[i];
+				histogram[i] = offset;
+				offset += n;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t index = histogram[(srcKeys[i] >> shift) & 0xFF]++;
+				dstKeys[index] = srcKeys[i];
+				dstValues[index] = srcValues[i];
+			}
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcValues, dstValues);
+		}
+
+		// ʱʱƻ
+		if (srcKeys != keys)
+		{
+			memcpy(keys, srcKeys, count * sizeof(uint64_t));
+			memcpy(values, srcValues, count * sizeof(uint32_t));
+		}
+	}
+}
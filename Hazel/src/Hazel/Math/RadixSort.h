@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace Hazel::Math
+{
+	//  64 λ LSD ȶÿ8λvalues һƶ
+	// tmpKeys/tmpValues Ϊȳʱ壻мĳһֽͬʱ
+	void RadixSort(uint64_t* keys, uint32_t* values, uint64_t* tmpKeys, uint32_t* tmpValues, uint32_t count);
+
+	// ӳΪִС˳޷ƴ
+	inline uint32_t FloatToSortableBits(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(float));
+		// תλֻתλ
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+}
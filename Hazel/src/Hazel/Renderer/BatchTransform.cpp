@@ -0,0 +1,308 @@
+#include "hzpch.h"
+#include "BatchTransform.h"
+
+#include "Hazel/Renderer/Mesh.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <chrono>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define HZ_TARGET_AVX2
+#else
+	#define HZ_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace Hazel
+{
+	static_assert(sizeof(BatchVertex) == 48, "BatchTransform assumes a 48 byte interleaved vertex");
+	static_assert(sizeof(QuadVertex) == sizeof(BatchVertex), "QuadVertex must match BatchVertex layout");
+	static_assert(sizeof(CompactVertex) == 28, "CompactVertex must stay tightly packed");
+
+	static bool CPUSupportsAVX2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		bool fma = (info[2] & (1 << 12)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!fma || !osxsave || !avx)
+			return false;
+
+		// ϵͳҪлʱ YMM Ĵ
+		if ((_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+	}
+
+	static BatchTransform::Path DetectBestPath()
+	{
+		// x64 һ֧ SSE2
+		return CPUSupportsAVX2() ? BatchTransform::Path::AVX2 : BatchTransform::Path::SSE2;
+	}
+
+	static const bool s_SupportsAVX2 = CPUSupportsAVX2();
+	static BatchTransform::Path s_Path = DetectBestPath();
+
+	// ÿ㰴16ֽڷΪΣ[px py pz r] [g b a u] [v texIndex tiling entityID]
+	//  uv/λ޹صĲԤƴãѭֻҪ任λ
+	static void BuildConstants(const glm::vec4& color, float texIndex, float tilingFactor, int entityID, float* a, float* b, float* c)
+	{
+		a[0] = 0.0f; a[1] = 0.0f; a[2] = 0.0f; a[3] = color.r;
+		b[0] = color.g; b[1] = color.b; b[2] = color.a; b[3] = 0.0f;
+		c[0] = 0.0f; c[1] = texIndex; c[2] = tilingFactor;
+		memcpy(&c[3], &entityID, sizeof(int));
+	}
+
+	static void TransformScalar(BatchVertex* dst, const glm::mat4& transform,
+		const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+		const glm::vec4& color, float texIndex, float tilingFactor, int entityID)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			dst[i].Position = transform * positions[i];
+			dst[i].Color = color;
+			dst[i].TexCoord = texCoords[i];
+			dst[i].TexIndex = texIndex;
+			dst[i].TilingFactor = tilingFactor;
+			dst[i].EntityID = entityID;
+		}
+	}
+
+	static void TransformSSE2(BatchVertex* dst, const glm::mat4& transform,
+		const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+		const glm::vec4& color, float texIndex, float tilingFactor, int entityID)
+	{
+		alignas(16) float constA[4], constB[4], constC[4];
+		BuildConstants(color, texIndex, tilingFactor, entityID, constA, constB, constC);
+		const __m128 a0 = _mm_load_ps(constA);
+		const __m128 b0 = _mm_load_ps(constB);
+		const __m128 c0 = _mm_load_ps(constC);
+		const __m128 maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+		const __m128 col0 = _mm_loadu_ps(&transform[0][0]);
+		const __m128 col1 = _mm_loadu_ps(&transform[1][0]);
+		const __m128 col2 = _mm_loadu_ps(&transform[2][0]);
+		const __m128 col3 = _mm_loadu_ps(&transform[3][0]);
+
+		float* out = (float*)dst;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			__m128 p = _mm_loadu_ps(&positions[i].x);
+			__m128 r = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(col0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(col1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)))),
+				_mm_add_ps(_mm_mul_ps(col2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))), _mm_mul_ps(col3, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)))));
+
+			__m128 uv = _mm_castpd_ps(_mm_load_sd((const double*)&texCoords[i].x)); // [u v 0 0]
+
+			__m128 a = _mm_or_ps(_mm_and_ps(r, maskXYZ), a0);
+			__m128 b = _mm_or_ps(b0, _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(0, 2, 2, 2))); // [0 0 0 u]
+			__m128 c = _mm_or_ps(c0, _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(2, 2, 2, 1))); // [v 0 0 0]
+
+			_mm_stream_ps(out, a);
+			_mm_stream_ps(out + 4, b);
+			_mm_stream_ps(out + 8, c);
+			out += 12;
+		}
+	}
+
+	HZ_TARGET_AVX2 static void TransformAVX2(BatchVertex* dst, const glm::mat4& transform,
+		const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+		const glm::vec4& color, float texIndex, float tilingFactor, int entityID)
+	{
+		uint32_t i = 0;
+
+		// 256λʽ洢Ҫ32ֽڶ룬ʱSSEһ㣨48ֽڣ
+		if (count && ((uintptr_t)dst & 31))
+		{
+			TransformSSE2(dst, transform, positions, texCoords, 1, color, texIndex, tilingFactor, entityID);
+			i = 1;
+		}
+
+		alignas(16) float constA[4], constB[4], constC[4];
+		BuildConstants(color, texIndex, tilingFactor, entityID, constA, constB, constC);
+		const __m256 a0 = _mm256_broadcast_ps((const __m128*)constA);
+		const __m256 b0 = _mm256_broadcast_ps((const __m128*)constB);
+		const __m256 c0 = _mm256_broadcast_ps((const __m128*)constC);
+		const __m256 maskXYZ = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, 0, -1, -1, -1));
+		const __m256 maskX = _mm256_castsi256_ps(_mm256_set_epi32(0, 0, 0, -1, 0, 0, 0, -1));
+		const __m256 maskW = _mm256_castsi256_ps(_mm256_set_epi32(-1, 0, 0, 0, -1, 0, 0, 0));
+
+		// 128λͨһݾУһα任
+		const __m256 col0 = _mm256_broadcast_ps((const __m128*)&transform[0][0]);
+		const __m256 col1 = _mm256_broadcast_ps((const __m128*)&transform[1][0]);
+		const __m256 col2 = _mm256_broadcast_ps((const __m128*)&transform[2][0]);
+		const __m256 col3 = _mm256_broadcast_ps((const __m128*)&transform[3][0]);
+
+		float* out = (float*)(dst + i);
+		for (; i + 2 <= count; i += 2)
+		{
+			__m256 p = _mm256_loadu_ps(&positions[i].x); // [p0 | p1]
+			__m256 r = _mm256_mul_ps(col0, _mm256_permute_ps(p, 0x00));
+			r = _mm256_fmadd_ps(col1, _mm256_permute_ps(p, 0x55), r);
+			r = _mm256_fmadd_ps(col2, _mm256_permute_ps(p, 0xAA), r);
+			r = _mm256_fmadd_ps(col3, _mm256_permute_ps(p, 0xFF), r);
+
+			__m128 uv01 = _mm_loadu_ps(&texCoords[i].x); // [u0 v0 u1 v1]
+			__m256 uv = _mm256_insertf128_ps(_mm256_castps128_ps256(uv01), _mm_movehl_ps(uv01, uv01), 1);
+
+			// a/b/c ĵͨڶ0ͨڶ1
+			__m256 a = _mm256_or_ps(_mm256_and_ps(r, maskXYZ), a0);
+			__m256 b = _mm256_or_ps(b0, _mm256_and_ps(_mm256_permute_ps(uv, 0x00), maskW));
+			__m256 c = _mm256_or_ps(c0, _mm256_and_ps(_mm256_permute_ps(uv, 0x55), maskX));
+
+			// ڴе˳Ϊ a0 b0 c0 a1 b1 c1
+			_mm256_stream_ps(out, _mm256_permute2f128_ps(a, b, 0x20));
+			_mm256_stream_ps(out + 8, _mm256_permute2f128_ps(c, a, 0x30));
+			_mm256_stream_ps(out + 16, _mm256_permute2f128_ps(b, c, 0x31));
+			out += 24;
+		}
+
+		if (i < count)
+			TransformSSE2(dst + i, transform, positions + i, texCoords + i, count - i, color, texIndex, tilingFactor, entityID);
+	}
+
+	void BatchTransform::Transform(BatchVertex* dst, const glm::mat4& transform,
+		const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+		const glm::vec4& color, float texIndex, float tilingFactor, int entityID)
+	{
+		Transform(s_Path, dst, transform, positions, texCoords, count, color, texIndex, tilingFactor, entityID);
+	}
+
+	void BatchTransform::Transform(Path path, BatchVertex* dst, const glm::mat4& transform,
+		const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+		const glm::vec4& color, float texIndex, float tilingFactor, int entityID)
+	{
+		// ʽ洢Ҫ16ֽڶ
+		if ((uintptr_t)dst & 15)
+			path = Path::Scalar;
+
+		switch (path)
+		{
+		case Path::AVX2:
+			TransformAVX2(dst, transform, positions, texCoords, count, color, texIndex, tilingFactor, entityID);
+			return;
+		case Path::SSE2:
+			TransformSSE2(dst, transform, positions, texCoords, count, color, texIndex, tilingFactor, entityID);
+			return;
+		case Path::Scalar:
+			TransformScalar(dst, transform, positions, texCoords, count, color, texIndex, tilingFactor, entityID);
+			return;
+		}
+	}
+
+	void BatchTransform::TransformCompact(CompactVertex* dst, const glm::mat4& transform,
+		const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+		const glm::vec4& color, float texIndex, float tilingFactor, int entityID)
+	{
+		CompactVertex vertex;
+		vertex.Color = glm::packUnorm4x8(color);
+		vertex.TexIndex = (uint16_t)texIndex;
+		vertex.TilingFactor = glm::packHalf1x16(tilingFactor);
+		vertex.EntityID = entityID;
+
+		// ջƴһдӳڴֻᱻ˳д
+		for (uint32_t i = 0; i < count; i++)
+		{
+			vertex.Position = transform * positions[i];
+			vertex.TexCoord = glm::packHalf2x16(texCoords[i]);
+			dst[i] = vertex;
+		}
+	}
+
+	void BatchTransform::Fence()
+	{
+		_mm_sfence();
+	}
+
+	BatchTransform::Path BatchTransform::GetPath()
+	{
+		return s_Path;
+	}
+
+	void BatchTransform::SetPath(Path path)
+	{
+		HZ_CORE_ASSERT(IsSupported(path), "BatchTransform path is not supported by this CPU!");
+		if (IsSupported(path))
+			s_Path = path;
+	}
+
+	bool BatchTransform::IsSupported(Path path)
+	{
+		switch (path)
+		{
+		case Path::Scalar: return true;
+		case Path::SSE2:   return true;
+		case Path::AVX2:   return s_SupportsAVX2;
+		}
+		return false;
+	}
+
+	const char* BatchTransform::PathToString(Path path)
+	{
+		switch (path)
+		{
+		case Path::Scalar: return "Scalar";
+		case Path::SSE2:   return "SSE2";
+		case Path::AVX2:   return "AVX2";
+		}
+		return "Unknown";
+	}
+
+	void BatchTransform::RunBenchmark(uint32_t iterations)
+	{
+		Ref<Mesh> mesh = MeshLibrary::GetSphereMesh();
+		const std::vector<glm::vec4>& positions = mesh->GetVertices();
+		const std::vector<glm::vec2>& texCoords = mesh->GetTextureCoords();
+		uint32_t count = (uint32_t)positions.size();
+
+		std::vector<BatchVertex> output(count);
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), { 1.0f, 2.0f, 3.0f })
+			* glm::rotate(glm::mat4(1.0f), 0.5f, { 0.0f, 1.0f, 0.0f })
+			* glm::scale(glm::mat4(1.0f), { 2.0f, 2.0f, 2.0f });
+		glm::vec4 color = { 0.2f, 0.4f, 0.6f, 1.0f };
+
+		for (Path path : { Path::Scalar, Path::SSE2, Path::AVX2 })
+		{
+			if (!IsSupported(path))
+			{
+				HZ_CORE_INFO("BatchTransform {0}: not supported", PathToString(path));
+				continue;
+			}
+
+			auto start = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < iterations; i++)
+				Transform(path, output.data(), transform, positions.data(), texCoords.data(), count, color, 1.0f, 1.0f, (int)i);
+			Fence();
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+			double verticesPerSecond = (double)count * iterations / elapsed.count();
+			HZ_CORE_INFO("BatchTransform {0}: {1:.1f} M vertices/s ({2} vertices x {3}, {4:.2f} ms)",
+				PathToString(path), verticesPerSecond / 1e6, count, iterations, elapsed.count() * 1000.0);
+		}
+
+		std::vector<CompactVertex> compactOutput(count);
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < iterations; i++)
+			TransformCompact(compactOutput.data(), transform, positions.data(), texCoords.data(), count, color, 1.0f, 1.0f, (int)i);
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+		double verticesPerSecond = (double)count * iterations / elapsed.count();
+		HZ_CORE_INFO("BatchTransform Compact: {0:.1f} M vertices/s ({1} vertices x {2}, {3:.2f} ms, {4} bytes/vertex)",
+			verticesPerSecond / 1e6, count, iterations, elapsed.count() * 1000.0, sizeof(CompactVertex));
+	}
+}
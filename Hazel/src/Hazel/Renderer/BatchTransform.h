@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Hazel/Renderer/Geometry/Geometry.h"
+
+namespace Hazel
+{
+	// 任һģͿռ䶥任ռ䣬дɽ BatchVertex/QuadVertex48ֽڣ
+	// дʹʽ洢ƹ棩Ŀͨʽ㻺ӳڴ
+	class BatchTransform
+	{
+	public:
+		enum class Path
+		{
+			Scalar = 0, SSE2 = 1, AVX2 = 2
+		};
+
+		static void Transform(BatchVertex* dst, const glm::mat4& transform,
+			const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+			const glm::vec4& color, float texIndex, float tilingFactor, int entityID);
+		static void Transform(Path path, BatchVertex* dst, const glm::mat4& transform,
+			const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+			const glm::vec4& color, float texIndex, float tilingFactor, int entityID);
+
+		// дɽն㣺ɫ//ƽϵдʱѹ붥޹صĲÿεֻѹһ
+		static void TransformCompact(CompactVertex* dst, const glm::mat4& transform,
+			const glm::vec4* positions, const glm::vec2* texCoords, uint32_t count,
+			const glm::vec4& color, float texIndex, float tilingFactor, int entityID);
+
+		// ʽ洢ύǰ sfence 
+		static void Fence();
+
+		// ĬʹCPUֵ֧·
+		static Path GetPath();
+		static void SetPath(Path path);
+		static bool IsSupported(Path path);
+		static const char* PathToString(Path path);
+
+		// ÿֵ֧·Լն㣩任嶥ɴΣ / ־
+		static void RunBenchmark(uint32_t iterations = 2000);
+	};
+}
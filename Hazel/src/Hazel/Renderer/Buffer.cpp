@@ -38,14 +38,30 @@ namespace Hazel
 			return nullptr;
 	}
 
-	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t count)
+	Ref<StreamingVertexBuffer> StreamingVertexBuffer::Create(uint32_t regionSize, uint32_t regionCount, bool readable)
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::None: HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported! ")
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLStreamingVertexBuffer>(regionSize, regionCount, readable);
+		case RendererAPI::API::DirectX: HZ_CORE_ASSERT(false, "RendererAPI::DirectX is currently not supported! ")
+			return nullptr;
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown Renderer API!")
+			return nullptr;
+	}
+
+	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t count, IndexFormat format)
 	{
 		switch (RendererAPI::GetAPI())
 		{
 		case RendererAPI::API::None:	HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported! ")
 			return nullptr;
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLIndexBuffer>(indices, count);
+			return CreateRef<OpenGLIndexBuffer>(indices, count, format);
 		case RendererAPI::API::DirectX:	HZ_CORE_ASSERT(false, "RendererAPI::DirectX is currently not supported! ")
 			return nullptr;
 		}
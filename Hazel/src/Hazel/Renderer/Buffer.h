@@ -4,7 +4,9 @@ namespace Hazel
 {
 	enum class ShaderDataType
 	{
-		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+		// ͣɫа float/vec ȡӲתUByte4 ͨ normalized ʹã
+		Half, Half2, Half4, UByte4, UShort
 	};
 
 	static uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -22,6 +24,11 @@ namespace Hazel
 		case ShaderDataType::Int3:     return 4 * 3;
 		case ShaderDataType::Int4:     return 4 * 4;
 		case ShaderDataType::Bool:     return 1;
+		case ShaderDataType::Half:     return 2;
+		case ShaderDataType::Half2:    return 2 * 2;
+		case ShaderDataType::Half4:    return 2 * 4;
+		case ShaderDataType::UByte4:   return 4;
+		case ShaderDataType::UShort:   return 2;
 		}
 		HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 		return 0;
@@ -57,6 +64,11 @@ namespace Hazel
 			case ShaderDataType::Int3:    return 3;
 			case ShaderDataType::Int4:    return 4;
 			case ShaderDataType::Bool:    return 1;
+			case ShaderDataType::Half:    return 1;
+			case ShaderDataType::Half2:   return 2;
+			case ShaderDataType::Half4:   return 4;
+			case ShaderDataType::UByte4:  return 4;
+			case ShaderDataType::UShort:  return 1;
 			}
 			HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			return 0;
@@ -76,6 +88,10 @@ namespace Hazel
 		uint32_t GetStride() const { return m_Stride; }
 		const std::vector<BufferElement>& GetElements() const { return m_Elements; }
 
+		// 0 ʾ𶥵ȡ1 ʾʵȡʵƣ
+		uint32_t GetDivisor() const { return m_Divisor; }
+		void SetDivisor(uint32_t divisor) { m_Divisor = divisor; }
+
 		std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
 		std::vector<BufferElement>::iterator end() { return m_Elements.end(); }
 		std::vector<BufferElement>::const_iterator begin() const { return m_Elements.begin(); }
@@ -97,6 +113,7 @@ namespace Hazel
 	private:
 		std::vector<BufferElement> m_Elements;
 		uint32_t m_Stride = 0;
+		uint32_t m_Divisor = 0;
 	};
 
 	class VertexBuffer
@@ -107,13 +124,45 @@ namespace Hazel
 		virtual void Unbind() const = 0;
 
 		virtual void SetData(const void* data, uint32_t size) const = 0;
+		// д [offset, offset + size) ֽڣݱֲ
+		virtual void SetSubData(const void* data, uint32_t size, uint32_t offset) const = 0;
 		virtual const BufferLayout& GetLayout() const = 0;
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 
+		virtual uint32_t GetRendererID() const = 0;
+
 		static Ref<VertexBuffer> Create(uint32_t size);
 		static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
 	};
 
+	// ʽ㻺壺־ӳ䣬Ϊ֡ѭʹ
+	// һ֡ڵĸύڵǰд룬֡ʱһդһдʱǰ
+	// ٴдĳǰȴդCPUGPUڶȡ
+	class StreamingVertexBuffer : public VertexBuffer
+	{
+	public:
+		// дλõĵַavailable Ϊǰʣֽ
+		// ʣ಻ minSize ʱһGPUڶȡȵȴ
+		virtual void* Map(uint32_t minSize, uint32_t& available) = 0;
+		// дλ֮ size ֽڽһλύдλúƣڻеֽƫ
+		virtual uint32_t Commit(uint32_t size) = 0;
+		// ÿ֡һΣ֡дդһ֡һʼ
+		virtual void EndFrame() = 0;
+
+		virtual uint32_t GetRegionIndex() const = 0;
+		virtual uint32_t GetRegionSize() const = 0;
+		virtual uint32_t GetWriteOffset() const = 0; // һдڻеֽƫ
+
+		// readable Ϊ true ʱӳҲɶڻضGPUдݣդɺȡ
+		static Ref<StreamingVertexBuffer> Create(uint32_t regionSize, uint32_t regionCount = 3, bool readable = false);
+	};
+
+	// GPU ϵȣС 65536 ʱ 16 λԴʹ
+	enum class IndexFormat
+	{
+		UInt16 = 0, UInt32 = 1
+	};
+
 	class IndexBuffer
 	{
 	public:
@@ -121,7 +170,12 @@ namespace Hazel
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 		virtual uint32_t GetCount() const = 0;
+		virtual IndexFormat GetFormat() const = 0;
+
+		// дӵ offset ʼ count 16 λʽϴʱת
+		virtual void SetSubData(const uint32_t* indices, uint32_t count, uint32_t offset) = 0;
 
-		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
+		// indices Ϊʱֻ count Ŀռ
+		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count, IndexFormat format = IndexFormat::UInt32);
 	};
 }
\ No newline at end of file
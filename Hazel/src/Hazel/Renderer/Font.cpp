@@ -0,0 +1,246 @@
+#include "hzpch.h"
+#include "Font.h"
+
+// imgui_draw.cpp еʵ static ģﵥһ
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+
+#include <fstream>
+
+namespace Hazel
+{
+	struct FontData
+	{
+		std::vector<unsigned char> FileData; // stbtt_fontinfo ֱļݣͬ
+		stbtt_fontinfo Info;
+		float Scale = 0.0f; // 嵥λ -> 
+	};
+
+	static Ref<Font> s_DefaultFont;
+
+	// ɾ볡ʱλͼ
+	struct GlyphBitmap
+	{
+		uint32_t Codepoint;
+		unsigned char* Pixels;
+		int Width, Height;
+		uint32_t X = 0, Y = 0; // ͼеλ
+	};
+
+	// ߶ȴӴСаڷţŲʱ false
+	static bool PackShelves(std::vector<GlyphBitmap>& bitmaps, uint32_t atlasSize)
+	{
+		const uint32_t gap = 1;
+		uint32_t x = 0, y = 0, rowHeight = 0;
+		for (GlyphBitmap& bitmap : bitmaps)
+		{
+			if (x + bitmap.Width > atlasSize)
+			{
+				x = 0;
+				y += rowHeight + gap;
+				rowHeight = 0;
+			}
+			if (y + bitmap.Height > atlasSize)
+				return false;
+
+			bitmap.X = x;
+			bitmap.Y = y;
+			x += bitmap.Width + gap;
+			rowHeight = std::max(rowHeight, (uint32_t)bitmap.Height);
+		}
+		return true;
+	}
+
+	Font::Font(const std::filesystem::path& path)
+		: m_Data(CreateScope<FontData>())
+	{
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (!stream)
+		{
+			HZ_CORE_ERROR("Font: could not open '{0}'", path.string());
+			return;
+		}
+		m_Data->FileData.resize((size_t)stream.tellg());
+		stream.seekg(0);
+		stream.read((char*)m_Data->FileData.data(), m_Data->FileData.size());
+
+		const unsigned char* fileData = m_Data->FileData.data();
+		stbtt_fontinfo& info = m_Data->Info;
+		if (!stbtt_InitFont(&info, fileData, stbtt_GetFontOffsetForIndex(fileData, 0)))
+		{
+			HZ_CORE_ERROR("Font: failed to parse '{0}'", path.string());
+			return;
+		}
+
+		const float pixelsPerEm = (float)PixelsPerEm;
+		float scale = stbtt_ScaleForMappingEmToPixels(&info, pixelsPerEm);
+		m_Data->Scale = scale;
+
+		int ascent, descent, lineGap;
+		stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+		m_LineHeight = (ascent - descent + lineGap) * scale / pixelsPerEm;
+
+		// 볡ڱԵΪ 128ÿ 128 / paddingǱԵ padding 
+		const int padding = DistanceRange / 2;
+		const float pixelDistScale = 128.0f / padding;
+
+		std::vector<GlyphBitmap> bitmaps;
+		for (uint32_t codepoint = 32; codepoint < 256; codepoint++)
+		{
+			if (codepoint >= 127 && codepoint < 160) // ַ
+				continue;
+
+			int glyphIndex = stbtt_FindGlyphIndex(&info, (int)codepoint);
+			if (glyphIndex == 0)
+				continue;
+
+			int advance, leftSideBearing;
+			stbtt_GetGlyphHMetrics(&info, glyphIndex, &advance, &leftSideBearing);
+
+			Glyph glyph = {};
+			glyph.Advance = advance * scale / pixelsPerEm;
+
+			int width, height, xoff, yoff;
+			unsigned char* pixels = stbtt_GetGlyphSDF(&info, scale, glyphIndex, padding, 128, pixelDistScale, &width, &height, &xoff, &yoff);
+			if (pixels)
+			{
+				// λͼ y £תΪ y ϵ em λ
+				glyph.Visible = true;
+				glyph.Plane = {
+					xoff / pixelsPerEm, -(yoff + height) / pixelsPerEm,
+					(xoff + width) / pixelsPerEm, -yoff / pixelsPerEm
+				};
+				bitmaps.push_back({ codepoint, pixels, width, height });
+			}
+			m_Glyphs[codepoint] = glyph;
+		}
+
+		std::sort(bitmaps.begin(), bitmaps.end(), [](const GlyphBitmap& a, const GlyphBitmap& b) { return a.Height > b.Height; });
+		uint32_t atlasSize = 256;
+		while (!PackShelves(bitmaps, atlasSize))
+			atlasSize *= 2;
+
+		// 볡д RGB ͨ0ڵײλͼ·ת
+		std::vector<uint32_t> atlas(atlasSize * atlasSize, 0xff000000);
+		for (GlyphBitmap& bitmap : bitmaps)
+		{
+			for (int row = 0; row < bitmap.Height; row++)
+			{
+				const unsigned char* src = bitmap.Pixels + row * bitmap.Width;
+				uint32_t* dst = atlas.data() + (bitmap.Y + bitmap.Height - 1 - row) * atlasSize + bitmap.X;
+				for (int column = 0; column < bitmap.Width; column++)
+				{
+					uint32_t distance = src[column];
+					dst[column] = 0xff000000 | (distance << 16) | (distance << 8) | distance;
+				}
+			}
+			stbtt_FreeSDF(bitmap.Pixels, nullptr);
+
+			m_Glyphs[bitmap.Codepoint].TexRect = glm::vec4(
+				bitmap.X, bitmap.Y, bitmap.X + bitmap.Width, bitmap.Y + bitmap.Height) / (float)atlasSize;
+		}
+
+		m_AtlasTexture = Texture2D::Create(atlasSize, atlasSize);
+		m_AtlasTexture->SetData(atlas.data(), atlasSize * atlasSize * sizeof(uint32_t));
+		HZ_CORE_INFO("Font: loaded '{0}', {1} glyphs in a {2}x{2} atlas", path.filename().string(), m_Glyphs.size(), atlasSize);
+	}
+
+	Font::~Font() = default;
+
+	const Font::Glyph* Font::GetGlyph(uint32_t codepoint) const
+	{
+		auto it = m_Glyphs.find(codepoint);
+		return it != m_Glyphs.end() ? &it->second : nullptr;
+	}
+
+	// һ UTF-8 ַǷз U+FFFD ֻǰһֽ
+	static uint32_t DecodeUTF8(const char*& it, const char* end)
+	{
+		uint8_t lead = (uint8_t)*it++;
+		if (lead < 0x80)
+			return lead;
+
+		int length = (lead & 0xe0) == 0xc0 ? 1 : (lead & 0xf0) == 0xe0 ? 2 : (lead & 0xf8) == 0xf0 ? 3 : -1;
+		if (length < 0 || end - it < length)
+			return 0xfffd;
+
+		uint32_t codepoint = lead & (0x3f >> length);
+		for (int i = 0; i < length; i++)
+		{
+			uint8_t next = (uint8_t)it[i];
+			if ((next & 0xc0) != 0x80)
+				return 0xfffd;
+			codepoint = (codepoint << 6) | (next & 0x3f);
+		}
+		it += length;
+		return codepoint;
+	}
+
+	void Font::Layout(const std::string& text, float kerning, float lineSpacing, std::vector<GlyphQuad>& quads) const
+	{
+		if (!IsLoaded())
+			return;
+
+		const Glyph* space = GetGlyph(' ');
+		const Glyph* fallback = GetGlyph('?');
+		const float scale = m_Data->Scale / (float)PixelsPerEm;
+
+		float x = 0.0f, y = 0.0f;
+		uint32_t previous = 0;
+		const char* it = text.data();
+		const char* end = it + text.size();
+		while (it < end)
+		{
+			uint32_t codepoint = DecodeUTF8(it, end);
+			if (codepoint == '\r')
+				continue;
+
+			if (codepoint == '\n')
+			{
+				x = 0.0f;
+				y -= m_LineHeight + lineSpacing;
+				previous = 0;
+				continue;
+			}
+
+			if (codepoint == '\t')
+			{
+				if (space)
+					x += 4.0f * (space->Advance + kerning);
+				previous = 0;
+				continue;
+			}
+
+			const Glyph* glyph = GetGlyph(codepoint);
+			if (!glyph)
+			{
+				glyph = fallback;
+				codepoint = '?';
+			}
+			if (!glyph)
+				continue;
+
+			if (previous)
+				x += stbtt_GetCodepointKernAdvance(&m_Data->Info, (int)previous, (int)codepoint) * scale;
+
+			if (glyph->Visible)
+				quads.push_back({ glyph->Plane + glm::vec4(x, y, x, y), glyph->TexRect });
+
+			x += glyph->Advance + kerning;
+			previous = codepoint;
+		}
+	}
+
+	Ref<Font> Font::GetDefault()
+	{
+		if (!s_DefaultFont)
+			s_DefaultFont = CreateRef<Font>("assets/fonts/opensans/OpenSans-Regular.ttf");
+		return s_DefaultFont;
+	}
+
+	void Font::ReleaseDefault()
+	{
+		s_DefaultFont = nullptr;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+
+namespace Hazel
+{
+	struct FontData;
+
+	// һıΣPlane Ϊַԭλ (left, bottom, right, top)λΪ em
+	struct GlyphQuad
+	{
+		glm::vec4 Plane;
+		glm::vec4 TexRect; // (min.xy, max.xy)
+	};
+
+	// ʱΪɾ볡ͼLatin-1 ַַ֮Ű
+	// ͼ RGB ͨͬһзž볡ɫͨ볡ȡֵ
+	class Font
+	{
+	public:
+		static constexpr uint32_t PixelsPerEm = 40;
+		static constexpr uint32_t DistanceRange = 8; // 볡ǵطΧԵһ룩
+
+		Font(const std::filesystem::path& path);
+		~Font();
+
+		bool IsLoaded() const { return m_AtlasTexture != nullptr; }
+		const Ref<Texture2D>& GetAtlasTexture() const { return m_AtlasTexture; }
+		float GetLineHeight() const { return m_LineHeight; }
+
+		// Ű UTF-8 ַ׷ӵ quadskerning Ϊ־࣬lineSpacing Ϊоࣨem
+		void Layout(const std::string& text, float kerning, float lineSpacing, std::vector<GlyphQuad>& quads) const;
+
+		// Դ OpenSans Regularһʹʱ
+		static Ref<Font> GetDefault();
+		static void ReleaseDefault();
+
+	private:
+		struct Glyph
+		{
+			glm::vec4 Plane;	// ԱλõηΧ (left, bottom, right, top)em
+			glm::vec4 TexRect;
+			float Advance;
+			bool Visible;		// ոûβı
+		};
+
+		const Glyph* GetGlyph(uint32_t codepoint) const;
+
+	private:
+		Scope<FontData> m_Data;
+		std::unordered_map<uint32_t, Glyph> m_Glyphs;
+		Ref<Texture2D> m_AtlasTexture;
+		float m_LineHeight = 0.0f;
+	};
+}
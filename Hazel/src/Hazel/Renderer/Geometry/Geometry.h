@@ -12,4 +12,38 @@ struct BatchVertex
 	float TexIndex;
 	float TilingFactor;
 	int EntityID;
-};
\ No newline at end of file
+};
+
+namespace Hazel
+{
+	// ն㣨28ֽڣɫ RGBA8ƽϵΪ뾫ȸ㣬Ϊ uint16
+	// ɫ BatchVertex ͬɶԸʽת
+	struct CompactVertex
+	{
+		glm::vec3 Position;
+		uint32_t Color;			// RGBA8 unorm
+		uint32_t TexCoord;		// half2
+		uint16_t TexIndex;
+		uint16_t TilingFactor;	// half
+		int EntityID;
+	};
+
+	// ʵ64ֽڣģ;ǰкƽƣ񶥵㳣פGPUʵչ
+	struct MeshInstance
+	{
+		glm::vec3 TransformX;	// transform[0]
+		glm::vec3 TransformY;	// transform[1]
+		glm::vec3 TransformZ;	// transform[2]
+		glm::vec3 Translation;	// transform[3]
+		uint32_t Color;			// RGBA8
+		int TexIndex;
+		float TilingFactor;
+		int EntityID; // Editor-only
+	};
+
+	// Standard: BatchVertex / QuadVertex48ֽڣCompact: CompactVertex
+	enum class VertexFormat
+	{
+		Standard = 0, Compact = 1
+	};
+}
@@ -15,6 +15,19 @@ namespace Hazel
 		int EntityID; // Editor-only
 	};
 
+	// ʵʱÿıεݣλı z = 0ֻҪ任ĵ013
+	struct QuadInstance
+	{
+		glm::vec3 TransformX;	// transform[0]
+		glm::vec3 TransformY;	// transform[1]
+		glm::vec3 Translation;	// transform[3]
+		uint32_t Color;			// RGBA8
+		int TexIndex;
+		float TilingFactor;
+		int EntityID; // Editor-only
+		glm::vec4 TexRect;		// 귶Χ (min.xy, max.xy)ͼеֻռһ
+	};
+
 	class Quad
 	{
 	public:
@@ -21,73 +21,93 @@ namespace Hazel
 		static constexpr int numLatLines = 32;
 		static constexpr int numLongLines = 64;
 	public:
+		// LOD ÿγߺ;룬Ϊһ 1/44096 -> 1024 -> 256
+		static constexpr int LODCount = 3;
+
 		static const std::vector<glm::vec4>& GetVertices()
 		{
 			static std::vector<glm::vec4> vertices;
-			constexpr float radius = 1;
 			if (vertices.empty())
+				BuildVertices(numLatLines, numLongLines, vertices);
+			return vertices;
+		}
+		static const std::vector<uint32_t>& GetIndices()
+		{
+			static std::vector<uint32_t> indices;
+			if (indices.empty())
+				BuildIndices(numLatLines, numLongLines, indices);
+			return indices;
+		}
+		static const std::vector<glm::vec2>& GetTextureCoords()
+		{
+			static std::vector<glm::vec2> textureCoords;
+			if (textureCoords.empty())
+				BuildTextureCoords(numLatLines, numLongLines, textureCoords);
+			return textureCoords;
+		}
+		static constexpr int GetVertexCount() { return (numLatLines + 1) * (numLongLines + 1); }
+		static constexpr int GetIndexCount() { return numLatLines * numLongLines * 6; }
+
+		// ɵ level  LOD 棨 0 ͬ
+		static void GenerateLOD(int level, std::vector<glm::vec4>& vertices, std::vector<uint32_t>& indices, std::vector<glm::vec2>& textureCoords)
+		{
+			int latLines = numLatLines >> level;
+			int longLines = numLongLines >> level;
+			BuildVertices(latLines, longLines, vertices);
+			BuildIndices(latLines, longLines, indices);
+			BuildTextureCoords(latLines, longLines, textureCoords);
+		}
+	private:
+		static void BuildVertices(int latLines, int longLines, std::vector<glm::vec4>& vertices)
+		{
+			constexpr float radius = 1;
+			for (int i = 0; i <= latLines; ++i)
 			{
-				for (unsigned int i = 0; i <= numLatLines; ++i)
-				{
-					float stackAngle = glm::pi<float>() / 2 - i * glm::pi<float>() / numLatLines; //  /2  -/2
-					float xy = radius * cosf(stackAngle);            // ǰԲİ뾶
-					float z = radius * sinf(stackAngle);             // ǰ z ߶
+				float stackAngle = glm::pi<float>() / 2 - i * glm::pi<float>() / latLines; //  /2  -/2
+				float xy = radius * cosf(stackAngle);            // ǰԲİ뾶
+				float z = radius * sinf(stackAngle);             // ǰ z ߶
 
-					for (unsigned int j = 0; j <= numLongLines; ++j)
-					{
-						float sectorAngle = j * 2 * glm::pi<float>() / numLongLines; //  0  2
+				for (int j = 0; j <= longLines; ++j)
+				{
+					float sectorAngle = j * 2 * glm::pi<float>() / longLines; //  0  2
 
-						float x = xy * cosf(sectorAngle);
-						float y = xy * sinf(sectorAngle);
+					float x = xy * cosf(sectorAngle);
+					float y = xy * sinf(sectorAngle);
 
-						vertices.emplace_back(x, y, z, 1.0f);
-					}
+					vertices.emplace_back(x, y, z, 1.0f);
 				}
 			}
-			return vertices;
 		}
-		static const std::vector<uint32_t>& GetIndices()
+		static void BuildIndices(int latLines, int longLines, std::vector<uint32_t>& indices)
 		{
-			static std::vector<uint32_t> indices;
-			if (indices.empty())
+			for (int i = 0; i < latLines; i++)
 			{
-				for (int i = 0; i < numLatLines; i++)
+				for (int j = 0; j < longLines; j++)
 				{
-					for (int j = 0; j < numLongLines; j++)
-					{
-						int first = i * (numLongLines + 1) + j;
-						int second = first + numLongLines + 1;
+					int first = i * (longLines + 1) + j;
+					int second = first + longLines + 1;
 
-						// ιı
-						indices.push_back(first);
-						indices.push_back(second);
-						indices.push_back(first + 1);
-						indices.push_back(second);
-						indices.push_back(second + 1);
-						indices.push_back(first + 1);
-					}
+					// ιı
+					indices.push_back(first);
+					indices.push_back(second);
+					indices.push_back(first + 1);
+					indices.push_back(second);
+					indices.push_back(second + 1);
+					indices.push_back(first + 1);
 				}
 			}
-			return indices;
 		}
-		static const std::vector<glm::vec2>& GetTextureCoords()
+		static void BuildTextureCoords(int latLines, int longLines, std::vector<glm::vec2>& textureCoords)
 		{
-			static std::vector<glm::vec2> textureCoords;
-			if (textureCoords.empty())
+			for (int i = 0; i <= latLines; i++)
 			{
-				for (int i = 0; i <= numLatLines; i++)
+				for (int j = 0; j <= longLines; j++)
 				{
-					for (int j = 0; j <= numLongLines; j++)
-					{
-						float u = (float)j / numLongLines;
-						float v = (float)i / numLatLines;
-						textureCoords.emplace_back(u, v);
-					}
+					float u = (float)j / longLines;
+					float v = (float)i / latLines;
+					textureCoords.emplace_back(u, v);
 				}
 			}
-			return textureCoords;
 		}
-		static constexpr int GetVertexCount() { return (numLatLines + 1) * (numLongLines + 1); }
-		static constexpr int GetIndexCount() { return numLatLines * numLongLines * 6; }
 	};
 }
\ No newline at end of file
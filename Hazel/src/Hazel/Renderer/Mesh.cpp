@@ -2,6 +2,8 @@
 
 #include "Mesh.h"
 #include "Hazel/Renderer/Geometry/Geometry.h"
+#include "Hazel/Renderer/MeshOptimizer.h"
+#include "Hazel/Renderer/MeshSimplifier.h"
 
 namespace Hazel
 {
@@ -14,6 +16,87 @@ namespace Hazel
 		m_Indices = indices;
 		m_TextureCoords = textureCoords;
 		m_MeshType = MeshType::StaticBatchable;
+		MeshOptimizer::Optimize(m_Vertices, m_TextureCoords, m_Indices);
+
+		// Χ԰ΧΪģ뾶ȡԶľ
+		m_Bounds = Math::AABB();
+		for (const glm::vec4& vertex : m_Vertices)
+			m_Bounds.Merge({ glm::vec3(vertex), glm::vec3(vertex) });
+
+		m_BoundingSphere = {};
+		if (!m_Bounds.IsEmpty())
+		{
+			m_BoundingSphere.Center = (m_Bounds.Min + m_Bounds.Max) * 0.5f;
+			for (const glm::vec4& vertex : m_Vertices)
+				m_BoundingSphere.Radius = std::max(m_BoundingSphere.Radius, glm::distance(m_BoundingSphere.Center, glm::vec3(vertex)));
+		}
+	}
+
+	void Mesh::LoadCookedGeometry(
+		std::vector<glm::vec4> vertices,
+		std::vector<uint32_t> indices,
+		std::vector<glm::vec2> textureCoords,
+		const Math::AABB& bounds,
+		const Math::BoundingSphere& boundingSphere)
+	{
+		m_Vertices = std::move(vertices);
+		m_Indices = std::move(indices);
+		m_TextureCoords = std::move(textureCoords);
+		m_MeshType = MeshType::StaticBatchable;
+		m_Bounds = bounds;
+		m_BoundingSphere = boundingSphere;
+	}
+
+	void Mesh::AddLOD(const Ref<Mesh>& mesh, float screenSize)
+	{
+		HZ_CORE_ASSERT(m_LODs.empty() || screenSize < m_LODs.back().ScreenSize, "LOD screen sizes must decrease!");
+		m_LODs.push_back({ mesh, screenSize });
+	}
+
+	void Mesh::GenerateLODs(uint32_t levelCount, float reduction)
+	{
+		m_LODs.clear();
+
+		std::vector<uint32_t> indices = m_Indices;
+		float screenSize = 0.5f;
+		for (uint32_t level = 1; level < levelCount; level++)
+		{
+			uint32_t targetIndexCount = (uint32_t)(indices.size() * reduction) / 3 * 3;
+			std::vector<uint32_t> simplified = MeshSimplifier::Simplify(m_Vertices, indices, targetIndexCount);
+			if (simplified.empty() || simplified.size() > indices.size() * 3 / 4) // ӷ/߽࣬򻯲ȥ
+				break;
+			indices = std::move(simplified);
+
+			// ֻõĶ
+			std::vector<uint32_t> remap(m_Vertices.size(), UINT32_MAX);
+			std::vector<glm::vec4> vertices;
+			std::vector<glm::vec2> textureCoords;
+			std::vector<uint32_t> lodIndices(indices.size());
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				uint32_t index = indices[i];
+				if (remap[index] == UINT32_MAX)
+				{
+					remap[index] = (uint32_t)vertices.size();
+					vertices.push_back(m_Vertices[index]);
+					textureCoords.push_back(m_TextureCoords[index]);
+				}
+				lodIndices[i] = remap[index];
+			}
+
+			Ref<Mesh> lod = CreateRef<Mesh>();
+			lod->LoadBaseGeometry(vertices, lodIndices, textureCoords);
+			lod->SetMeshType(m_MeshType);
+			m_LODs.push_back({ lod, screenSize });
+			screenSize *= 0.5f;
+		}
+	}
+
+	const Ref<Mesh>& Mesh::GetLOD(const Ref<Mesh>& mesh, uint32_t level)
+	{
+		if (level == 0 || mesh->m_LODs.empty())
+			return mesh;
+		return mesh->m_LODs[std::min(level, (uint32_t)mesh->m_LODs.size()) - 1].MeshObj;
 	}
 
 	Ref<Mesh> MeshLibrary::s_CubeMesh = nullptr;
@@ -43,6 +126,20 @@ namespace Hazel
 				Sphere::GetIndices(),
 				Sphere::GetTextureCoords()
 			);
+
+			// ;ȵľγΪ LOD һ 256 
+			const float screenSizes[] = { 0.4f, 0.15f };
+			for (int level = 1; level < Sphere::LODCount; level++)
+			{
+				std::vector<glm::vec4> vertices;
+				std::vector<uint32_t> indices;
+				std::vector<glm::vec2> textureCoords;
+				Sphere::GenerateLOD(level, vertices, indices, textureCoords);
+
+				Ref<Mesh> lod = CreateRef<Mesh>();
+				lod->LoadBaseGeometry(vertices, indices, textureCoords);
+				s_SphereMesh->AddLOD(lod, screenSizes[level - 1]);
+			}
 		}
 		return s_SphereMesh;
 	}
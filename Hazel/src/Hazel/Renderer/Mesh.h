@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Hazel/Math/Frustum.h"
+#include "Hazel/Renderer/Buffer.h"
+
 #include <glm/glm.hpp>
 
 namespace Hazel
@@ -14,21 +17,52 @@ namespace Hazel
     class Mesh 
     {
     public:
+        // ʱ MeshOptimizer κͶ˳Ż㻺Ȼƣֵ봫Ĳͬ
         void LoadBaseGeometry(
             const std::vector<glm::vec4>& vertices,
             const std::vector<uint32_t>& indices,
             const std::vector<glm::vec2>& textureCoords);
+        // ѾŻļΣ決棩˳ͼΧ
+        void LoadCookedGeometry(
+            std::vector<glm::vec4> vertices,
+            std::vector<uint32_t> indices,
+            std::vector<glm::vec2> textureCoords,
+            const Math::AABB& bounds,
+            const Math::BoundingSphere& boundingSphere);
         const std::vector<glm::vec4>& GetVertices() const { return m_Vertices; }
         const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
         const std::vector<glm::vec2>& GetTextureCoords() const { return m_TextureCoords; }
         size_t GetVertexCount() const { return m_Vertices.size(); }
         size_t GetIndexCount() const { return m_Indices.size(); }
+        // ϴGPUʱõխʽ
+        IndexFormat GetIndexFormat() const { return m_Vertices.size() <= 65536 ? IndexFormat::UInt16 : IndexFormat::UInt32; }
+        // ģͿռİΧΧ򣬼ؼʱ
+        const Math::AABB& GetBounds() const { return m_Bounds; }
+        const Math::BoundingSphere& GetBoundingSphere() const { return m_BoundingSphere; }
         MeshType GetMeshType() const { return m_MeshType; }
         void SetMeshType(MeshType meshType) { m_MeshType = meshType; }
+
+        // LOD ͶӰĻϵİΧֱռӿڸ߶ȵıС ScreenSize ʱʹøü
+        struct LOD
+        {
+            Ref<Mesh> MeshObj;
+            float ScreenSize;
+        };
+        // Ӿϸֲڵ˳ӣScreenSize 𼶼С
+        void AddLOD(const Ref<Mesh>& mesh, float screenSize);
+        //  QEM ۵𼶼򻯵ǰΣ滻е LOD ÿԼΪһ reduction 
+        void GenerateLODs(uint32_t levelCount = 3, float reduction = 0.25f);
+        const std::vector<LOD>& GetLODs() const { return m_LODs; }
+        uint32_t GetLODCount() const { return (uint32_t)m_LODs.size() + 1; }
+        //  level 0 Ϊ mesh 
+        static const Ref<Mesh>& GetLOD(const Ref<Mesh>& mesh, uint32_t level);
     private:
         std::vector<glm::vec4> m_Vertices;
         std::vector<uint32_t> m_Indices;
         std::vector<glm::vec2> m_TextureCoords;
+        Math::AABB m_Bounds;
+        Math::BoundingSphere m_BoundingSphere;
+        std::vector<LOD> m_LODs; //  1 
         MeshType m_MeshType;
     };
 
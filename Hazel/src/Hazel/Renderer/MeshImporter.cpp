@@ -0,0 +1,891 @@
+#include "hzpch.h"
+#include "MeshImporter.h"
+
+#include "Hazel/Utils/PlatformUtils.h"
+
+#include <yaml-cpp/yaml.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <fstream>
+
+namespace Hazel
+{
+	// Żǰļ
+	struct ImportedGeometry
+	{
+		std::vector<glm::vec4> Vertices;
+		std::vector<uint32_t> Indices;
+		std::vector<glm::vec2> TextureCoords;
+	};
+
+	/* ===================決==================== */
+
+	// ļ֣CookedMeshHeaderLODCount  CookedLOD֮ 16 ֽڶݿ
+	// ÿ LOD Ϊλãvec4꣨vec2 IndexFormat Ϊ 16  32 λ
+	struct CookedMeshHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		uint64_t SourceSize;
+		int64_t SourceWriteTime;	// Դļһʱټϣ
+		uint32_t LODCount;
+		uint32_t Reserved;
+	};
+	static_assert(sizeof(CookedMeshHeader) == 40, "CookedMeshHeader must be tightly packed");
+
+	struct CookedLOD
+	{
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+		uint32_t Format;			// IndexFormat
+		float ScreenSize;			//  0 ʹ
+		uint64_t VertexOffset;
+		uint64_t TexCoordOffset;
+		uint64_t IndexOffset;
+		glm::vec3 BoundsMin;
+		glm::vec3 BoundsMax;
+		glm::vec3 SphereCenter;
+		float SphereRadius;
+	};
+	static_assert(sizeof(CookedLOD) == 80, "CookedLOD must be tightly packed");
+
+	static constexpr char CookedMagic[4] = { 'H', 'Z', 'M', 'S' };
+	static constexpr uint32_t MaxCookedLODs = 8;
+
+	static std::unordered_map<std::string, std::weak_ptr<Mesh>> s_LoadedMeshes;
+
+	// FNV-1a 64 λ
+	static uint64_t HashBytes(const uint8_t* data, size_t size)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static float GetMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	static bool ReadBlob(const MappedFile& file, uint64_t offset, size_t size, void* destination)
+	{
+		if (offset > file.GetSize() || size > file.GetSize() - offset)
+			return false;
+		std::memcpy(destination, file.GetData() + offset, size);
+		return true;
+	}
+
+	static Ref<Mesh> ReadCookedLOD(const MappedFile& file, const CookedLOD& lod)
+	{
+		std::vector<glm::vec4> vertices(lod.VertexCount);
+		std::vector<glm::vec2> textureCoords(lod.VertexCount);
+		std::vector<uint32_t> indices(lod.IndexCount);
+		if (!ReadBlob(file, lod.VertexOffset, vertices.size() * sizeof(glm::vec4), vertices.data())
+			|| !ReadBlob(file, lod.TexCoordOffset, textureCoords.size() * sizeof(glm::vec2), textureCoords.data()))
+			return nullptr;
+
+		if (lod.Format == (uint32_t)IndexFormat::UInt16)
+		{
+			std::vector<uint16_t> narrow(lod.IndexCount);
+			if (!ReadBlob(file, lod.IndexOffset, narrow.size() * sizeof(uint16_t), narrow.data()))
+				return nullptr;
+			std::copy(narrow.begin(), narrow.end(), indices.begin());
+		}
+		else if (!ReadBlob(file, lod.IndexOffset, indices.size() * sizeof(uint32_t), indices.data()))
+			return nullptr;
+
+		for (uint32_t index : indices)
+		{
+			if (index >= lod.VertexCount)
+				return nullptr;
+		}
+
+		Ref<Mesh> mesh = CreateRef<Mesh>();
+		mesh->LoadCookedGeometry(std::move(vertices), std::move(indices), std::move(textureCoords),
+			Math::AABB(lod.BoundsMin, lod.BoundsMax), { lod.SphereCenter, lod.SphereRadius });
+		return mesh;
+	}
+
+	// 治ڡ汾Դļһʱ nullptr
+	static Ref<Mesh> LoadCooked(const std::filesystem::path& cookedPath, const std::filesystem::path& sourcePath,
+		uint64_t sourceSize, int64_t sourceWriteTime)
+	{
+		MappedFile file;
+		if (!file.Open(cookedPath) || file.GetSize() < sizeof(CookedMeshHeader))
+			return nullptr;
+
+		CookedMeshHeader header;
+		std::memcpy(&header, file.GetData(), sizeof(header));
+		if (std::memcmp(header.Magic, CookedMagic, sizeof(CookedMagic)) != 0 || header.Version != MeshImporter::CookedVersion
+			|| header.SourceSize != sourceSize || header.LODCount == 0 || header.LODCount > MaxCookedLODs)
+			return nullptr;
+
+		// ޸ʱ˵û䣨¼ʱԿʹû
+		bool touched = header.SourceWriteTime != sourceWriteTime;
+		if (touched)
+		{
+			MappedFile source;
+			if (!source.Open(sourcePath) || HashBytes(source.GetData(), source.GetSize()) != header.SourceHash)
+				return nullptr;
+		}
+
+		std::vector<CookedLOD> lods(header.LODCount);
+		if (!ReadBlob(file, sizeof(CookedMeshHeader), lods.size() * sizeof(CookedLOD), lods.data()))
+			return nullptr;
+
+		Ref<Mesh> mesh = ReadCookedLOD(file, lods[0]);
+		for (uint32_t level = 1; mesh && level < header.LODCount; level++)
+		{
+			Ref<Mesh> lod = ReadCookedLOD(file, lods[level]);
+			if (!lod)
+				return nullptr;
+			mesh->AddLOD(lod, lods[level].ScreenSize);
+		}
+		file.Close();
+
+		if (mesh && touched)
+		{
+			header.SourceWriteTime = sourceWriteTime;
+			std::fstream stream(cookedPath, std::ios::in | std::ios::out | std::ios::binary);
+			stream.write((const char*)&header, sizeof(header));
+		}
+		return mesh;
+	}
+
+	static void Cook(const std::filesystem::path& cookedPath, const Ref<Mesh>& mesh, uint64_t sourceHash, uint64_t sourceSize, int64_t sourceWriteTime)
+	{
+		CookedMeshHeader header = {};
+		std::memcpy(header.Magic, CookedMagic, sizeof(CookedMagic));
+		header.Version = MeshImporter::CookedVersion;
+		header.SourceHash = sourceHash;
+		header.SourceSize = sourceSize;
+		header.SourceWriteTime = sourceWriteTime;
+		header.LODCount = std::min(mesh->GetLODCount(), MaxCookedLODs);
+
+		auto align = [](uint64_t offset) { return (offset + 15) & ~(uint64_t)15; };
+
+		std::vector<CookedLOD> lods(header.LODCount);
+		uint64_t offset = align(sizeof(CookedMeshHeader) + lods.size() * sizeof(CookedLOD));
+		for (uint32_t level = 0; level < header.LODCount; level++)
+		{
+			const Mesh& lodMesh = *Mesh::GetLOD(mesh, level);
+			CookedLOD& lod = lods[level];
+			lod.VertexCount = (uint32_t)lodMesh.GetVertexCount();
+			lod.IndexCount = (uint32_t)lodMesh.GetIndexCount();
+			lod.Format = (uint32_t)lodMesh.GetIndexFormat();
+			lod.ScreenSize = level > 0 ? mesh->GetLODs()[level - 1].ScreenSize : 1.0f;
+			lod.BoundsMin = lodMesh.GetBounds().Min;
+			lod.BoundsMax = lodMesh.GetBounds().Max;
+			lod.SphereCenter = lodMesh.GetBoundingSphere().Center;
+			lod.SphereRadius = lodMesh.GetBoundingSphere().Radius;
+
+			lod.VertexOffset = offset;
+			offset = align(offset + lod.VertexCount * sizeof(glm::vec4));
+			lod.TexCoordOffset = offset;
+			offset = align(offset + lod.VertexCount * sizeof(glm::vec2));
+			lod.IndexOffset = offset;
+			offset = align(offset + lod.IndexCount * (lodMesh.GetIndexFormat() == IndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t)));
+		}
+
+		// дʱļ滻дһʧܲ𻵵Ļ
+		std::filesystem::path tempPath = cookedPath;
+		tempPath += ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				HZ_CORE_WARN("MeshImporter: could not write cooked mesh '{0}'", cookedPath.string());
+				return;
+			}
+
+			auto writeAt = [&stream](uint64_t position, const void* data, size_t size)
+			{
+				// ϶
+				static const char zeros[16] = {};
+				uint64_t current = (uint64_t)stream.tellp();
+				if (position > current)
+					stream.write(zeros, position - current);
+				stream.write((const char*)data, size);
+			};
+
+			writeAt(0, &header, sizeof(header));
+			writeAt(sizeof(header), lods.data(), lods.size() * sizeof(CookedLOD));
+			for (uint32_t level = 0; level < header.LODCount; level++)
+			{
+				const Mesh& lodMesh = *Mesh::GetLOD(mesh, level);
+				const CookedLOD& lod = lods[level];
+				writeAt(lod.VertexOffset, lodMesh.GetVertices().data(), lod.VertexCount * sizeof(glm::vec4));
+				writeAt(lod.TexCoordOffset, lodMesh.GetTextureCoords().data(), lod.VertexCount * sizeof(glm::vec2));
+				if (lod.Format == (uint32_t)IndexFormat::UInt16)
+				{
+					std::vector<uint16_t> narrow(lod.IndexCount);
+					for (uint32_t i = 0; i < lod.IndexCount; i++)
+						narrow[i] = (uint16_t)lodMesh.GetIndices()[i];
+					writeAt(lod.IndexOffset, narrow.data(), narrow.size() * sizeof(uint16_t));
+				}
+				else
+					writeAt(lod.IndexOffset, lodMesh.GetIndices().data(), lod.IndexCount * sizeof(uint32_t));
+			}
+			if (!stream)
+			{
+				HZ_CORE_WARN("MeshImporter: could not write cooked mesh '{0}'", cookedPath.string());
+				return;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, cookedPath, error);
+		if (error)
+			HZ_CORE_WARN("MeshImporter: could not write cooked mesh '{0}': {1}", cookedPath.string(), error.message());
+	}
+
+	/* ===================OBJ==================== */
+
+	static void SkipSpaces(const char*& cursor, const char* end)
+	{
+		while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+			cursor++;
+	}
+
+	static void SkipLine(const char*& cursor, const char* end)
+	{
+		while (cursor < end && *cursor != '\n')
+			cursor++;
+		if (cursor < end)
+			cursor++;
+	}
+
+	static bool ParseFloat(const char*& cursor, const char* end, float& value)
+	{
+		SkipSpaces(cursor, end);
+		if (cursor < end && *cursor == '+')
+			cursor++;
+		auto [next, error] = std::from_chars(cursor, end, value);
+		if (error != std::errc())
+			return false;
+		cursor = next;
+		return true;
+	}
+
+	static bool ParseInt(const char*& cursor, const char* end, int64_t& value)
+	{
+		auto [next, error] = std::from_chars(cursor, end, value);
+		if (error != std::errc())
+			return false;
+		cursor = next;
+		return true;
+	}
+
+	// OBJ  1 ʼʾԵǰĩβ
+	static bool ResolveObjIndex(int64_t index, size_t count, uint32_t& result)
+	{
+		int64_t resolved = index > 0 ? index - 1 : (int64_t)count + index;
+		if (index == 0 || resolved < 0 || resolved >= (int64_t)count)
+			return false;
+		result = (uint32_t)resolved;
+		return true;
+	}
+
+	// ɨӳļݣΰǻλúͬĽǺϲΪͬһ
+	static bool ParseOBJ(const uint8_t* data, size_t size, ImportedGeometry& geometry)
+	{
+		std::vector<glm::vec4> positions;
+		std::vector<glm::vec2> textureCoords;
+		std::unordered_map<uint64_t, uint32_t> vertexMap;
+		std::vector<uint32_t> polygon;
+
+		const char* cursor = (const char*)data;
+		const char* end = cursor + size;
+		uint32_t line = 0;
+		while (cursor < end)
+		{
+			line++;
+			SkipSpaces(cursor, end);
+			if (end - cursor >= 2 && cursor[0] == 'v' && (cursor[1] == ' ' || cursor[1] == '\t'))
+			{
+				cursor += 2;
+				glm::vec4 position(0.0f, 0.0f, 0.0f, 1.0f);
+				if (!ParseFloat(cursor, end, position.x) || !ParseFloat(cursor, end, position.y) || !ParseFloat(cursor, end, position.z))
+				{
+					HZ_CORE_ERROR("MeshImporter: invalid vertex on line {0}", line);
+					return false;
+				}
+				positions.push_back(position);
+			}
+			else if (end - cursor >= 3 && cursor[0] == 'v' && cursor[1] == 't' && (cursor[2] == ' ' || cursor[2] == '\t'))
+			{
+				cursor += 3;
+				glm::vec2 textureCoord(0.0f);
+				if (!ParseFloat(cursor, end, textureCoord.x))
+				{
+					HZ_CORE_ERROR("MeshImporter: invalid texture coordinate on line {0}", line);
+					return false;
+				}
+				ParseFloat(cursor, end, textureCoord.y); // v ʡ
+				textureCoords.push_back(textureCoord);
+			}
+			else if (end - cursor >= 2 && cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t'))
+			{
+				cursor += 2;
+				polygon.clear();
+				while (true)
+				{
+					SkipSpaces(cursor, end);
+					if (cursor >= end || *cursor == '\r' || *cursor == '\n' || *cursor == '#')
+						break;
+
+					// vv/vtv/vt/vn  v//vn߲ʹ
+					int64_t positionIndex = 0, textureIndex = 0, normalIndex = 0;
+					uint32_t position, texture = UINT32_MAX;
+					bool valid = ParseInt(cursor, end, positionIndex) && ResolveObjIndex(positionIndex, positions.size(), position);
+					if (valid && cursor < end && *cursor == '/')
+					{
+						cursor++;
+						if (cursor < end && *cursor != '/')
+							valid = ParseInt(cursor, end, textureIndex) && ResolveObjIndex(textureIndex, textureCoords.size(), texture);
+						if (valid && cursor < end && *cursor == '/')
+						{
+							cursor++;
+							valid = ParseInt(cursor, end, normalIndex);
+						}
+					}
+					if (!valid)
+					{
+						HZ_CORE_ERROR("MeshImporter: invalid face on line {0}", line);
+						return false;
+					}
+
+					uint64_t key = ((uint64_t)position << 32) | texture;
+					auto [it, inserted] = vertexMap.try_emplace(key, (uint32_t)geometry.Vertices.size());
+					if (inserted)
+					{
+						geometry.Vertices.push_back(positions[position]);
+						geometry.TextureCoords.push_back(texture != UINT32_MAX ? textureCoords[texture] : glm::vec2(0.0f));
+					}
+					polygon.push_back(it->second);
+				}
+
+				for (size_t i = 2; i < polygon.size(); i++)
+					geometry.Indices.insert(geometry.Indices.end(), { polygon[0], polygon[i - 1], polygon[i] });
+			}
+			SkipLine(cursor, end);
+		}
+		return true;
+	}
+
+	/* ===================glTF==================== */
+
+	// ݣ.glb Ķƿֱָӳڴ棬ȡ Storage
+	struct GLTFBuffer
+	{
+		const uint8_t* Data = nullptr;
+		size_t Size = 0;
+		std::vector<uint8_t> Storage;
+	};
+
+	struct GLTFDocument
+	{
+		YAML::Node Json; // JSON  YAML Ӽֱ yaml-cpp 
+		std::vector<GLTFBuffer> Buffers;
+	};
+
+	static bool DecodeBase64(const std::string& text, size_t begin, std::vector<uint8_t>& output)
+	{
+		auto decode = [](char c) -> int
+		{
+			if (c >= 'A' && c <= 'Z') return c - 'A';
+			if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+			if (c >= '0' && c <= '9') return c - '0' + 52;
+			if (c == '+') return 62;
+			if (c == '/') return 63;
+			return -1;
+		};
+
+		uint32_t bits = 0;
+		int bitCount = 0;
+		for (size_t i = begin; i < text.size() && text[i] != '='; i++)
+		{
+			int value = decode(text[i]);
+			if (value < 0)
+				return false;
+			bits = (bits << 6) | (uint32_t)value;
+			bitCount += 6;
+			if (bitCount >= 8)
+			{
+				bitCount -= 8;
+				output.push_back((uint8_t)(bits >> bitCount));
+			}
+		}
+		return true;
+	}
+
+	static std::string DecodeURI(const std::string& uri)
+	{
+		std::string result;
+		for (size_t i = 0; i < uri.size(); i++)
+		{
+			if (uri[i] == '%' && i + 2 < uri.size())
+			{
+				result += (char)std::stoi(uri.substr(i + 1, 2), nullptr, 16);
+				i += 2;
+			}
+			else
+				result += uri[i];
+		}
+		return result;
+	}
+
+	static bool LoadGLTFBuffers(GLTFDocument& document, const std::filesystem::path& path, const uint8_t* binaryChunk, size_t binaryChunkSize)
+	{
+		const YAML::Node& buffers = document.Json["buffers"];
+		document.Buffers.resize(buffers ? buffers.size() : 0);
+		for (size_t i = 0; i < document.Buffers.size(); i++)
+		{
+			GLTFBuffer& buffer = document.Buffers[i];
+			const YAML::Node& node = buffers[i];
+			if (!node["uri"])
+			{
+				// .glb û uri ĵһ弴ƿ
+				if (i != 0 || !binaryChunk)
+				{
+					HZ_CORE_ERROR("MeshImporter: buffer {0} has no data", i);
+					return false;
+				}
+				buffer.Data = binaryChunk;
+				buffer.Size = binaryChunkSize;
+				continue;
+			}
+
+			std::string uri = node["uri"].as<std::string>();
+			if (uri.compare(0, 5, "data:") == 0)
+			{
+				size_t comma = uri.find(";base64,");
+				if (comma == std::string::npos || !DecodeBase64(uri, comma + 8, buffer.Storage))
+				{
+					HZ_CORE_ERROR("MeshImporter: buffer {0} has an unsupported data URI", i);
+					return false;
+				}
+			}
+			else
+			{
+				std::filesystem::path bufferPath = path.parent_path() / std::filesystem::u8path(DecodeURI(uri));
+				std::ifstream stream(bufferPath, std::ios::binary | std::ios::ate);
+				if (!stream)
+				{
+					HZ_CORE_ERROR("MeshImporter: could not open buffer '{0}'", bufferPath.string());
+					return false;
+				}
+				buffer.Storage.resize((size_t)stream.tellg());
+				stream.seekg(0);
+				stream.read((char*)buffer.Storage.data(), buffer.Storage.size());
+			}
+			buffer.Data = buffer.Storage.data();
+			buffer.Size = buffer.Storage.size();
+		}
+		return true;
+	}
+
+	static uint32_t GetComponentSize(uint32_t componentType)
+	{
+		switch (componentType)
+		{
+		case 5120: case 5121: return 1; // BYTE, UNSIGNED_BYTE
+		case 5122: case 5123: return 2; // SHORT, UNSIGNED_SHORT
+		case 5125: case 5126: return 4; // UNSIGNED_INT, FLOAT
+		}
+		return 0;
+	}
+
+	static uint32_t GetComponentCount(const std::string& type)
+	{
+		if (type == "SCALAR") return 1;
+		if (type == "VEC2") return 2;
+		if (type == "VEC3") return 3;
+		if (type == "VEC4") return 4;
+		return 0;
+	}
+
+	// ȡһͰ normalized Ƿһ
+	static float ReadComponent(const uint8_t* data, uint32_t componentType, bool normalized)
+	{
+		switch (componentType)
+		{
+		case 5120: { int8_t v; std::memcpy(&v, data, 1); return normalized ? std::max(v / 127.0f, -1.0f) : (float)v; }
+		case 5121: { uint8_t v = *data; return normalized ? v / 255.0f : (float)v; }
+		case 5122: { int16_t v; std::memcpy(&v, data, 2); return normalized ? std::max(v / 32767.0f, -1.0f) : (float)v; }
+		case 5123: { uint16_t v; std::memcpy(&v, data, 2); return normalized ? v / 65535.0f : (float)v; }
+		case 5125: { uint32_t v; std::memcpy(&v, data, 4); return (float)v; }
+		case 5126: { float v; std::memcpy(&v, data, 4); return v; }
+		}
+		return 0.0f;
+	}
+
+	// λݣصһԪصĵַstride ΪԪصļ
+	static const uint8_t* LocateAccessor(const GLTFDocument& document, const YAML::Node& accessor, uint32_t elementSize, uint32_t count, uint32_t& stride)
+	{
+		if (accessor["sparse"])
+			HZ_CORE_WARN("MeshImporter: sparse accessors are not supported, using the base data");
+		if (!accessor["bufferView"])
+			return nullptr;
+
+		const YAML::Node& view = document.Json["bufferViews"][accessor["bufferView"].as<uint32_t>()];
+		if (!view || view["buffer"].as<uint32_t>() >= document.Buffers.size())
+			return nullptr;
+
+		const GLTFBuffer& buffer = document.Buffers[view["buffer"].as<uint32_t>()];
+		uint64_t offset = (view["byteOffset"] ? view["byteOffset"].as<uint64_t>() : 0)
+			+ (accessor["byteOffset"] ? accessor["byteOffset"].as<uint64_t>() : 0);
+		stride = view["byteStride"] ? view["byteStride"].as<uint32_t>() : elementSize;
+		uint64_t required = count > 0 ? (uint64_t)stride * (count - 1) + elementSize : 0;
+		if (offset + required > buffer.Size)
+			return nullptr;
+		return buffer.Data + offset;
+	}
+
+	static bool ReadFloatAccessor(const GLTFDocument& document, uint32_t accessorIndex, uint32_t componentCount, std::vector<float>& output)
+	{
+		const YAML::Node& accessor = document.Json["accessors"][accessorIndex];
+		if (!accessor)
+			return false;
+
+		uint32_t componentType = accessor["componentType"].as<uint32_t>();
+		uint32_t count = accessor["count"].as<uint32_t>();
+		uint32_t componentSize = GetComponentSize(componentType);
+		if (componentSize == 0 || GetComponentCount(accessor["type"].as<std::string>()) != componentCount)
+			return false;
+
+		bool normalized = accessor["normalized"] && accessor["normalized"].as<bool>();
+		uint32_t stride;
+		const uint8_t* data = LocateAccessor(document, accessor, componentSize * componentCount, count, stride);
+		output.assign((size_t)count * componentCount, 0.0f);
+		if (!data)
+			return !accessor["bufferView"]; // ûлͼķȫΪ 0
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			for (uint32_t c = 0; c < componentCount; c++)
+				output[(size_t)i * componentCount + c] = ReadComponent(data + (size_t)i * stride + c * componentSize, componentType, normalized);
+		}
+		return true;
+	}
+
+	static bool ReadIndexAccessor(const GLTFDocument& document, uint32_t accessorIndex, std::vector<uint32_t>& output)
+	{
+		const YAML::Node& accessor = document.Json["accessors"][accessorIndex];
+		if (!accessor)
+			return false;
+
+		uint32_t componentType = accessor["componentType"].as<uint32_t>();
+		uint32_t count = accessor["count"].as<uint32_t>();
+		uint32_t componentSize = GetComponentSize(componentType);
+		if (componentType != 5121 && componentType != 5123 && componentType != 5125)
+			return false;
+
+		uint32_t stride;
+		const uint8_t* data = LocateAccessor(document, accessor, componentSize, count, stride);
+		if (!data)
+			return false;
+
+		output.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const uint8_t* element = data + (size_t)i * stride;
+			if (componentType == 5121)
+				output[i] = *element;
+			else if (componentType == 5123)
+			{
+				uint16_t value;
+				std::memcpy(&value, element, sizeof(value));
+				output[i] = value;
+			}
+			else
+				std::memcpy(&output[i], element, sizeof(uint32_t));
+		}
+		return true;
+	}
+
+	static glm::mat4 GetNodeTransform(const YAML::Node& node)
+	{
+		if (const YAML::Node& matrix = node["matrix"])
+		{
+			glm::mat4 transform;
+			for (int i = 0; i < 16; i++)
+				glm::value_ptr(transform)[i] = matrix[i].as<float>(); //  glm һ
+			return transform;
+		}
+
+		glm::vec3 translation(0.0f), scale(1.0f);
+		glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+		if (const YAML::Node& t = node["translation"])
+			translation = { t[0].as<float>(), t[1].as<float>(), t[2].as<float>() };
+		if (const YAML::Node& r = node["rotation"])
+			rotation = glm::quat(r[3].as<float>(), r[0].as<float>(), r[1].as<float>(), r[2].as<float>()); // glTF Ϊ (x, y, z, w)
+		if (const YAML::Node& s = node["scale"])
+			scale = { s[0].as<float>(), s[1].as<float>(), s[2].as<float>() };
+		return glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+	}
+
+	static bool AppendGLTFMesh(const GLTFDocument& document, uint32_t meshIndex, const glm::mat4& transform, ImportedGeometry& geometry)
+	{
+		const YAML::Node& mesh = document.Json["meshes"][meshIndex];
+		if (!mesh)
+			return false;
+
+		// 任ᷭתγ򣬽ָ
+		bool mirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+		std::vector<float> positions, textureCoords;
+		std::vector<uint32_t> indices;
+		for (const YAML::Node& primitive : mesh["primitives"])
+		{
+			if (primitive["mode"] && primitive["mode"].as<uint32_t>() != 4)
+			{
+				HZ_CORE_WARN("MeshImporter: skipping a non-triangle primitive in mesh {0}", meshIndex);
+				continue;
+			}
+
+			const YAML::Node& attributes = primitive["attributes"];
+			if (!attributes["POSITION"] || !ReadFloatAccessor(document, attributes["POSITION"].as<uint32_t>(), 3, positions))
+			{
+				HZ_CORE_ERROR("MeshImporter: mesh {0} has invalid positions", meshIndex);
+				return false;
+			}
+			uint32_t vertexCount = (uint32_t)positions.size() / 3;
+
+			textureCoords.clear();
+			if (attributes["TEXCOORD_0"] && !ReadFloatAccessor(document, attributes["TEXCOORD_0"].as<uint32_t>(), 2, textureCoords))
+			{
+				HZ_CORE_ERROR("MeshImporter: mesh {0} has invalid texture coordinates", meshIndex);
+				return false;
+			}
+
+			if (primitive["indices"])
+			{
+				if (!ReadIndexAccessor(document, primitive["indices"].as<uint32_t>(), indices))
+				{
+					HZ_CORE_ERROR("MeshImporter: mesh {0} has invalid indices", meshIndex);
+					return false;
+				}
+			}
+			else
+			{
+				indices.resize(vertexCount);
+				for (uint32_t i = 0; i < vertexCount; i++)
+					indices[i] = i;
+			}
+
+			uint32_t baseVertex = (uint32_t)geometry.Vertices.size();
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				geometry.Vertices.push_back(transform * glm::vec4(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], 1.0f));
+				// glTF ԭϽǣʱ·ת
+				geometry.TextureCoords.push_back(textureCoords.empty() ? glm::vec2(0.0f)
+					: glm::vec2(textureCoords[i * 2], 1.0f - textureCoords[i * 2 + 1]));
+			}
+			for (size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+				{
+					HZ_CORE_ERROR("MeshImporter: mesh {0} has out of range indices", meshIndex);
+					return false;
+				}
+				uint32_t second = mirrored ? 2 : 1, third = mirrored ? 1 : 2;
+				geometry.Indices.insert(geometry.Indices.end(),
+					{ baseVertex + indices[i], baseVertex + indices[i + second], baseVertex + indices[i + third] });
+			}
+		}
+		return true;
+	}
+
+	static bool AppendGLTFNode(const GLTFDocument& document, uint32_t nodeIndex, const glm::mat4& parentTransform, uint32_t depth, ImportedGeometry& geometry)
+	{
+		const YAML::Node& node = document.Json["nodes"][nodeIndex];
+		if (!node || depth > 64)
+			return false;
+
+		glm::mat4 transform = parentTransform * GetNodeTransform(node);
+		if (node["mesh"] && !AppendGLTFMesh(document, node["mesh"].as<uint32_t>(), transform, geometry))
+			return false;
+
+		for (const YAML::Node& child : node["children"])
+		{
+			if (!AppendGLTFNode(document, child.as<uint32_t>(), transform, depth + 1, geometry))
+				return false;
+		}
+		return true;
+	}
+
+	static bool ParseGLTF(const std::filesystem::path& path, const uint8_t* data, size_t size, ImportedGeometry& geometry)
+	{
+		GLTFDocument document;
+		const uint8_t* binaryChunk = nullptr;
+		size_t binaryChunkSize = 0;
+		std::string json;
+
+		// .glb12 ֽļͷ֮ JSON ͿѡĶƿ飬ÿ 8 ֽڿͷ
+		uint32_t magic = 0;
+		if (size >= 12)
+			std::memcpy(&magic, data, sizeof(magic));
+		if (magic == 0x46546C67) // "glTF"
+		{
+			size_t offset = 12;
+			while (offset + 8 <= size)
+			{
+				uint32_t chunkLength, chunkType;
+				std::memcpy(&chunkLength, data + offset, sizeof(chunkLength));
+				std::memcpy(&chunkType, data + offset + 4, sizeof(chunkType));
+				offset += 8;
+				if (chunkLength > size - offset)
+					break;
+
+				if (chunkType == 0x4E4F534A) // "JSON"
+					json.assign((const char*)data + offset, chunkLength);
+				else if (chunkType == 0x004E4942 && !binaryChunk) // "BIN"
+				{
+					binaryChunk = data + offset;
+					binaryChunkSize = chunkLength;
+				}
+				offset += chunkLength;
+			}
+		}
+		else
+			json.assign((const char*)data, size);
+
+		try
+		{
+			document.Json = YAML::Load(json);
+		}
+		catch (const YAML::Exception& e)
+		{
+			HZ_CORE_ERROR("MeshImporter: failed to parse glTF JSON: {0}", e.what());
+			return false;
+		}
+
+		try
+		{
+			if (!LoadGLTFBuffers(document, path, binaryChunk, binaryChunkSize))
+				return false;
+
+			// ĬϳĽڵûгʱֱӺϲ
+			const YAML::Node& scenes = document.Json["scenes"];
+			if (scenes && scenes.size() > 0)
+			{
+				uint32_t sceneIndex = document.Json["scene"] ? document.Json["scene"].as<uint32_t>() : 0;
+				for (const YAML::Node& node : scenes[sceneIndex]["nodes"])
+				{
+					if (!AppendGLTFNode(document, node.as<uint32_t>(), glm::mat4(1.0f), 0, geometry))
+						return false;
+				}
+			}
+			else
+			{
+				const YAML::Node& meshes = document.Json["meshes"];
+				for (uint32_t i = 0; meshes && i < meshes.size(); i++)
+				{
+					if (!AppendGLTFMesh(document, i, glm::mat4(1.0f), geometry))
+						return false;
+				}
+			}
+		}
+		catch (const YAML::Exception& e)
+		{
+			HZ_CORE_ERROR("MeshImporter: invalid glTF document: {0}", e.what());
+			return false;
+		}
+		return true;
+	}
+
+	/* ===================MeshImporter==================== */
+
+	static std::string GetExtension(const std::filesystem::path& path)
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+		return extension;
+	}
+
+	bool MeshImporter::IsSupported(const std::filesystem::path& path)
+	{
+		std::string extension = GetExtension(path);
+		return extension == ".obj" || extension == ".gltf" || extension == ".glb";
+	}
+
+	std::filesystem::path MeshImporter::GetCookedPath(const std::filesystem::path& path)
+	{
+		std::filesystem::path cookedPath = path;
+		cookedPath += ".hzmesh";
+		return cookedPath;
+	}
+
+	Ref<Mesh> MeshImporter::Load(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		std::string key = std::filesystem::weakly_canonical(path, error).string();
+		auto it = s_LoadedMeshes.find(key);
+		if (it != s_LoadedMeshes.end())
+		{
+			if (Ref<Mesh> mesh = it->second.lock())
+				return mesh;
+		}
+
+		if (!IsSupported(path))
+		{
+			HZ_CORE_ERROR("MeshImporter: unsupported mesh format '{0}'", path.string());
+			return nullptr;
+		}
+
+		uint64_t sourceSize = std::filesystem::file_size(path, error);
+		if (error)
+		{
+			HZ_CORE_ERROR("MeshImporter: could not open '{0}'", path.string());
+			return nullptr;
+		}
+		int64_t sourceWriteTime = (int64_t)std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+		auto start = std::chrono::steady_clock::now();
+		std::filesystem::path cookedPath = GetCookedPath(path);
+		Ref<Mesh> mesh = LoadCooked(cookedPath, path, sourceSize, sourceWriteTime);
+		if (mesh)
+		{
+			HZ_CORE_INFO("MeshImporter: loaded cooked '{0}' ({1} vertices, {2} LODs) in {3:.2f} ms",
+				cookedPath.filename().string(), mesh->GetVertexCount(), mesh->GetLODCount(), GetMilliseconds(start));
+		}
+		else
+		{
+			MappedFile source;
+			if (!source.Open(path))
+			{
+				HZ_CORE_ERROR("MeshImporter: could not open '{0}'", path.string());
+				return nullptr;
+			}
+
+			ImportedGeometry geometry;
+			bool parsed = GetExtension(path) == ".obj"
+				? ParseOBJ(source.GetData(), source.GetSize(), geometry)
+				: ParseGLTF(path, source.GetData(), source.GetSize(), geometry);
+			if (!parsed || geometry.Indices.empty())
+			{
+				HZ_CORE_ERROR("MeshImporter: failed to import '{0}'", path.string());
+				return nullptr;
+			}
+
+			mesh = CreateRef<Mesh>();
+			mesh->LoadBaseGeometry(geometry.Vertices, geometry.Indices, geometry.TextureCoords);
+			mesh->GenerateLODs();
+			Cook(cookedPath, mesh, HashBytes(source.GetData(), source.GetSize()), sourceSize, sourceWriteTime);
+			HZ_CORE_INFO("MeshImporter: imported '{0}' ({1} vertices, {2} triangles, {3} LODs) in {4:.2f} ms",
+				path.filename().string(), mesh->GetVertexCount(), mesh->GetIndexCount() / 3, mesh->GetLODCount(), GetMilliseconds(start));
+		}
+
+		s_LoadedMeshes[key] = mesh;
+		return mesh;
+	}
+}
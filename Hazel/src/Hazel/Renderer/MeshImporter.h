@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Hazel/Renderer/Mesh.h"
+
+#include <filesystem>
+
+namespace Hazel
+{
+	//  OBJ  glTF 2.0.gltf/.glbļͼԪڵ任ϲΪһλ + һ꣩
+	// һεԴļд決棨Դļ + .hzmesh LOD Ķ/ݿͰΧ
+	// ֮ʱӳ仺ļֱӿݿ飬ٽԴļԴļСݹϣ仯ʱµ
+	class MeshImporter
+	{
+	public:
+		// ʽ̣ŻLOD ɣ仯ʱһɻԶʧЧ
+		static constexpr uint32_t CookedVersion = 1;
+
+		static bool IsSupported(const std::filesystem::path& path);
+		static std::filesystem::path GetCookedPath(const std::filesystem::path& path);
+
+		// ͬһ·Աʱֱӷʧܷ nullptr
+		static Ref<Mesh> Load(const std::filesystem::path& path);
+	};
+}
@@ -0,0 +1,297 @@
+#include "hzpch.h"
+#include "MeshOptimizer.h"
+
+namespace Hazel
+{
+	// FIFO 㻺棺δʱдʱƽʱӣʱСڻСڻ
+	class VertexCache
+	{
+	public:
+		VertexCache(uint32_t vertexCount, uint32_t cacheSize)
+			: m_Timestamps(vertexCount, 0), m_Time(cacheSize + 1), m_CacheSize(cacheSize) {}
+
+		uint32_t AddTriangle(const uint32_t* triangle)
+		{
+			uint32_t misses = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				uint32_t vertex = triangle[k];
+				if (m_Time - m_Timestamps[vertex] > m_CacheSize)
+				{
+					m_Timestamps[vertex] = m_Time++;
+					misses++;
+				}
+			}
+			return misses;
+		}
+
+		void Reset()
+		{
+			// ƽʱʹжʧЧʱ
+			m_Time += m_CacheSize + 1;
+		}
+
+	private:
+		std::vector<uint32_t> m_Timestamps;
+		uint32_t m_Time;
+		uint32_t m_CacheSize;
+	};
+
+	MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+	{
+		CacheStats stats;
+		if (indices.empty() || vertexCount == 0)
+			return stats;
+
+		VertexCache cache(vertexCount, cacheSize);
+		uint32_t misses = 0;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+			misses += cache.AddTriangle(&indices[i]);
+
+		stats.ACMR = (float)misses / (float)(indices.size() / 3);
+		stats.ATVR = (float)misses / (float)vertexCount;
+		return stats;
+	}
+
+	std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize)
+	{
+		const uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+		std::vector<uint32_t> result;
+		result.reserve(triangleCount * 3);
+		if (triangleCount == 0)
+			return result;
+
+		//  -> ڽӱliveCounts Ϊδ
+		std::vector<uint32_t> liveCounts(vertexCount, 0);
+		for (size_t i = 0; i < triangleCount * 3; i++)
+			liveCounts[indices[i]]++;
+
+		std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+		for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+			adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveCounts[vertex];
+		std::vector<uint32_t> adjacency(triangleCount * 3);
+		{
+			std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < triangleCount * 3; i++)
+				adjacency[cursor[indices[i]]++] = (uint32_t)(i / 3);
+		}
+
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> deadEnds;	// Ķ㣬ʱ
+		std::vector<uint32_t> candidates;
+		uint32_t time = cacheSize + 1;
+		uint32_t cursor = 0;			// ҲҲʱ˳ɨ
+
+		// ȻĶ㣬ɨʣඥ
+		auto skipDeadEnd = [&]() -> int64_t
+		{
+			while (!deadEnds.empty())
+			{
+				uint32_t vertex = deadEnds.back();
+				deadEnds.pop_back();
+				if (liveCounts[vertex] > 0)
+					return vertex;
+			}
+			for (; cursor < vertexCount; cursor++)
+			{
+				if (liveCounts[cursor] > 0)
+					return cursor;
+			}
+			return -1;
+		};
+
+		int64_t fanning = skipDeadEnd();
+		while (fanning >= 0)
+		{
+			candidates.clear();
+			for (uint32_t k = adjacencyOffsets[fanning]; k < adjacencyOffsets[fanning + 1]; k++)
+			{
+				uint32_t triangle = adjacency[k];
+				if (emitted[triangle])
+					continue;
+
+				for (int v = 0; v < 3; v++)
+				{
+					uint32_t vertex = indices[triangle * 3 + v];
+					result.push_back(vertex);
+					deadEnds.push_back(vertex);
+					candidates.push_back(vertex);
+					liveCounts[vertex]--;
+					if (time - timestamps[vertex] > cacheSize)
+						timestamps[vertex] = time++;
+				}
+				emitted[triangle] = true;
+			}
+
+			// һģȳȫʣκڻеĺѡ뻺
+			int64_t next = -1;
+			int64_t bestPriority = -1;
+			for (uint32_t vertex : candidates)
+			{
+				if (liveCounts[vertex] == 0)
+					continue;
+
+				int64_t priority = 0;
+				if (time - timestamps[vertex] + 2 * liveCounts[vertex] <= cacheSize)
+					priority = time - timestamps[vertex];
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					next = vertex;
+				}
+			}
+			fanning = next >= 0 ? next : skipDeadEnd();
+		}
+
+		return result;
+	}
+
+	std::vector<uint32_t> MeshOptimizer::OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<glm::vec4>& vertices,
+		float threshold, uint32_t cacheSize)
+	{
+		const uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+		const uint32_t vertexCount = (uint32_t)vertices.size();
+		if (triangleCount <= 1)
+			return indices;
+
+		// Ӳ߽磺㶼δеΣTipsify ݻ¿ʼ֮以˳Ӱ컺
+		std::vector<uint32_t> hardClusters;
+		{
+			VertexCache cache(vertexCount, cacheSize);
+			for (uint32_t triangle = 0; triangle < triangleCount; triangle++)
+			{
+				if (cache.AddTriangle(&indices[triangle * 3]) == 3)
+					hardClusters.push_back(triangle);
+			}
+		}
+		hardClusters.push_back(triangleCount);
+
+		// ߽磺ش仺濪ʼۼƵ ACMR ص threshold ʱз֣ȡϸ
+		std::vector<uint32_t> clusters;
+		{
+			VertexCache cache(vertexCount, cacheSize);
+			for (size_t c = 0; c + 1 < hardClusters.size(); c++)
+			{
+				uint32_t begin = hardClusters[c], end = hardClusters[c + 1];
+
+				cache.Reset();
+				uint32_t clusterMisses = 0;
+				for (uint32_t triangle = begin; triangle < end; triangle++)
+					clusterMisses += cache.AddTriangle(&indices[triangle * 3]);
+				float targetACMR = threshold * (float)clusterMisses / (float)(end - begin);
+
+				cache.Reset();
+				uint32_t start = begin, misses = 0;
+				clusters.push_back(begin);
+				for (uint32_t triangle = begin; triangle < end; triangle++)
+				{
+					misses += cache.AddTriangle(&indices[triangle * 3]);
+					if (triangle + 1 < end && (float)misses <= targetACMR * (float)(triangle + 1 - start))
+					{
+						start = triangle + 1;
+						misses = 0;
+						clusters.push_back(start);
+						cache.Reset();
+					}
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		// ȨģصĺͷͬȨ
+		struct Cluster
+		{
+			uint32_t Begin, End;
+			float SortKey;
+		};
+		std::vector<glm::vec3> centroids(clusters.size() - 1, glm::vec3(0.0f));
+		std::vector<glm::vec3> normals(clusters.size() - 1, glm::vec3(0.0f));
+		std::vector<float> areas(clusters.size() - 1, 0.0f);
+		glm::vec3 meshCentroid(0.0f);
+		float meshArea = 0.0f;
+		for (size_t c = 0; c + 1 < clusters.size(); c++)
+		{
+			for (uint32_t triangle = clusters[c]; triangle < clusters[c + 1]; triangle++)
+			{
+				glm::vec3 p0 = vertices[indices[triangle * 3]];
+				glm::vec3 p1 = vertices[indices[triangle * 3 + 1]];
+				glm::vec3 p2 = vertices[indices[triangle * 3 + 2]];
+				glm::vec3 normal = glm::cross(p1 - p0, p2 - p0); // Ϊ
+				float area = glm::length(normal) * 0.5f;
+
+				centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+				normals[c] += normal;
+				areas[c] += area;
+			}
+			meshCentroid += centroids[c];
+			meshArea += areas[c];
+		}
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
+
+		std::vector<Cluster> sorted(clusters.size() - 1);
+		for (size_t c = 0; c + 1 < clusters.size(); c++)
+		{
+			glm::vec3 centroid = areas[c] > 0.0f ? centroids[c] / areas[c] : vertices[indices[clusters[c] * 3]];
+			float normalLength = glm::length(normals[c]);
+			glm::vec3 normal = normalLength > 0.0f ? normals[c] / normalLength : glm::vec3(0.0f);
+			sorted[c] = { clusters[c], clusters[c + 1], glm::dot(centroid - meshCentroid, normal) };
+		}
+		std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.SortKey > b.SortKey; });
+
+		std::vector<uint32_t> result;
+		result.reserve(triangleCount * 3);
+		for (const Cluster& cluster : sorted)
+			result.insert(result.end(), indices.begin() + cluster.Begin * 3, indices.begin() + cluster.End * 3);
+		return result;
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(std::vector<glm::vec4>& vertices, std::vector<glm::vec2>& textureCoords, std::vector<uint32_t>& indices)
+	{
+		std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+		std::vector<glm::vec4> orderedVertices;
+		std::vector<glm::vec2> orderedTextureCoords;
+		orderedVertices.reserve(vertices.size());
+		orderedTextureCoords.reserve(textureCoords.size());
+
+		for (uint32_t& index : indices)
+		{
+			if (remap[index] == UINT32_MAX)
+			{
+				remap[index] = (uint32_t)orderedVertices.size();
+				orderedVertices.push_back(vertices[index]);
+				if (index < textureCoords.size())
+					orderedTextureCoords.push_back(textureCoords[index]);
+			}
+			index = remap[index];
+		}
+
+		vertices = std::move(orderedVertices);
+		textureCoords = std::move(orderedTextureCoords);
+	}
+
+	void MeshOptimizer::Optimize(std::vector<glm::vec4>& vertices, std::vector<glm::vec2>& textureCoords, std::vector<uint32_t>& indices)
+	{
+		const uint32_t vertexCount = (uint32_t)vertices.size();
+		if (indices.size() < 3)
+			return;
+
+		CacheStats before = AnalyzeVertexCache(indices, vertexCount);
+		std::vector<uint32_t> optimized = OptimizeVertexCache(indices, vertexCount);
+		optimized = OptimizeOverdraw(optimized, vertices);
+
+		// ûбʱԭ˳˳Ѿ㹻ã
+		CacheStats after = AnalyzeVertexCache(optimized, vertexCount);
+		if (after.ACMR < before.ACMR)
+			indices = std::move(optimized);
+		else
+			after = before;
+
+		OptimizeVertexFetch(vertices, textureCoords, indices);
+		after.ATVR = AnalyzeVertexCache(indices, (uint32_t)vertices.size()).ATVR;
+
+		HZ_CORE_INFO("MeshOptimizer: {0} vertices, {1} triangles, ACMR {2:.3f} -> {3:.3f}, ATVR {4:.3f} -> {5:.3f}",
+			vertices.size(), indices.size() / 3, before.ACMR, after.ACMR, before.ATVR, after.ATVR);
+	}
+}
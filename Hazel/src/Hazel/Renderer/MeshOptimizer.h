@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Hazel
+{
+	// غŻ㻺Ѻõ˳TipsifyٹȻơʹ˳Ŷ
+	// ֻıκͶ˳򣬲ıμ
+	class MeshOptimizer
+	{
+	public:
+		// ģı任󶥵㻺СFIFO
+		static constexpr uint32_t CacheSize = 16;
+
+		struct CacheStats
+		{
+			float ACMR = 0.0f; // ƽÿεĻδ0.5 ~ 3
+			float ATVR = 0.0f; // δ / ֵΪ 1
+		};
+
+		static CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = CacheSize);
+
+		// TipsifySander 2007ΧƵǰĶΣٴӸĶѡһڻе
+		static std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = CacheSize);
+		// ڻŻ˳зδأACMR ԭ threshold ԶĵĴȻ
+		static std::vector<uint32_t> OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<glm::vec4>& vertices,
+			float threshold = 1.05f, uint32_t cacheSize = CacheSize);
+		// ״γֵ˳Ŷ㣬δõĶ㱻ɾ
+		static void OptimizeVertexFetch(std::vector<glm::vec4>& vertices, std::vector<glm::vec2>& textureCoords, std::vector<uint32_t>& indices);
+
+		// ִŻǰ ACMR/ATVR
+		static void Optimize(std::vector<glm::vec4>& vertices, std::vector<glm::vec2>& textureCoords, std::vector<uint32_t>& indices);
+	};
+}
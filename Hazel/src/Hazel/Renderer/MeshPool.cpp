@@ -0,0 +1,147 @@
+#include "hzpch.h"
+#include "MeshPool.h"
+
+namespace Hazel
+{
+	struct MeshPoolData
+	{
+		struct Entry
+		{
+			std::weak_ptr<Mesh> Handle; // жǷ٣ַܱã
+			MeshAllocation Allocation;
+		};
+
+		std::unordered_map<const Mesh*, Entry> Entries;
+
+		// CPUʱϴ
+		std::vector<MeshPool::Vertex> Vertices;
+		std::vector<uint32_t> Indices;
+
+		Ref<VertexBuffer> VB;
+		Ref<IndexBuffer> IB;
+		uint32_t VertexCapacity = 0;
+		uint32_t IndexCapacity = 0;
+		//  BaseVertex񶼲 65536 ʱ 16 λ
+		IndexFormat Format = IndexFormat::UInt16;
+		uint32_t Generation = 0;
+	};
+	static MeshPoolData s_PoolData;
+
+	static uint32_t Grow(uint32_t capacity, uint32_t initialCapacity, uint32_t required)
+	{
+		capacity = std::max(capacity, initialCapacity);
+		while (capacity < required)
+			capacity *= 2;
+		return capacity;
+	}
+
+	static void Reallocate(uint32_t vertexCapacity, uint32_t indexCapacity)
+	{
+		s_PoolData.VertexCapacity = vertexCapacity;
+		s_PoolData.IndexCapacity = indexCapacity;
+
+		s_PoolData.VB = VertexBuffer::Create(vertexCapacity * sizeof(MeshPool::Vertex));
+		s_PoolData.VB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexCoord"}
+		});
+		s_PoolData.IB = IndexBuffer::Create(nullptr, indexCapacity, s_PoolData.Format);
+
+		if (!s_PoolData.Vertices.empty())
+			s_PoolData.VB->SetSubData(s_PoolData.Vertices.data(), (uint32_t)(s_PoolData.Vertices.size() * sizeof(MeshPool::Vertex)), 0);
+		if (!s_PoolData.Indices.empty())
+			s_PoolData.IB->SetSubData(s_PoolData.Indices.data(), (uint32_t)s_PoolData.Indices.size(), 0);
+
+		s_PoolData.Generation++;
+		HZ_CORE_INFO("MeshPool: reallocated to {0} vertices, {1} {2}-bit indices", vertexCapacity, indexCapacity,
+			s_PoolData.Format == IndexFormat::UInt16 ? 16 : 32);
+	}
+
+	const MeshAllocation& MeshPool::Get(const Ref<Mesh>& mesh)
+	{
+		auto it = s_PoolData.Entries.find(mesh.get());
+		if (it != s_PoolData.Entries.end() && !it->second.Handle.expired())
+			return it->second.Allocation;
+
+		const std::vector<glm::vec4>& positions = mesh->GetVertices();
+		const std::vector<glm::vec2>& texCoords = mesh->GetTextureCoords();
+		const std::vector<uint32_t>& indices = mesh->GetIndices();
+
+		MeshPoolData::Entry& entry = s_PoolData.Entries[mesh.get()];
+		entry.Handle = mesh;
+		entry.Allocation = {
+			(uint32_t)s_PoolData.Vertices.size(), (uint32_t)positions.size(),
+			(uint32_t)s_PoolData.Indices.size(), (uint32_t)indices.size(),
+			mesh->GetBounds()
+		};
+
+		for (size_t i = 0; i < positions.size(); i++)
+			s_PoolData.Vertices.push_back({ glm::vec3(positions[i]), texCoords[i] });
+		s_PoolData.Indices.insert(s_PoolData.Indices.end(), indices.begin(), indices.end());
+
+		// һҪ 32 λʱлΪ 32 λ
+		bool widen = mesh->GetIndexFormat() == IndexFormat::UInt32 && s_PoolData.Format == IndexFormat::UInt16;
+		if (widen)
+			s_PoolData.Format = IndexFormat::UInt32;
+
+		uint32_t vertexCount = (uint32_t)s_PoolData.Vertices.size();
+		uint32_t indexCount = (uint32_t)s_PoolData.Indices.size();
+		if (widen || vertexCount > s_PoolData.VertexCapacity || indexCount > s_PoolData.IndexCapacity)
+		{
+			Reallocate(Grow(s_PoolData.VertexCapacity, InitialVertexCapacity, vertexCount),
+				Grow(s_PoolData.IndexCapacity, InitialIndexCapacity, indexCount));
+		}
+		else
+		{
+			// ֻϴĲ
+			const MeshAllocation& allocation = entry.Allocation;
+			s_PoolData.VB->SetSubData(s_PoolData.Vertices.data() + allocation.BaseVertex,
+				allocation.VertexCount * sizeof(Vertex), allocation.BaseVertex * sizeof(Vertex));
+			s_PoolData.IB->SetSubData(s_PoolData.Indices.data() + allocation.FirstIndex, allocation.IndexCount, allocation.FirstIndex);
+		}
+		return entry.Allocation;
+	}
+
+	const Ref<VertexBuffer>& MeshPool::GetVertexBuffer()
+	{
+		return s_PoolData.VB;
+	}
+
+	const Ref<IndexBuffer>& MeshPool::GetIndexBuffer()
+	{
+		return s_PoolData.IB;
+	}
+
+	uint32_t MeshPool::GetGeneration()
+	{
+		return s_PoolData.Generation;
+	}
+
+	void MeshPool::Clear()
+	{
+		s_PoolData.Entries.clear();
+		s_PoolData.Vertices.clear();
+		s_PoolData.Indices.clear();
+		s_PoolData.VB = nullptr;
+		s_PoolData.IB = nullptr;
+		s_PoolData.VertexCapacity = 0;
+		s_PoolData.IndexCapacity = 0;
+		s_PoolData.Format = IndexFormat::UInt16;
+		s_PoolData.Generation++;
+	}
+
+	uint32_t MeshPool::GetMeshCount()
+	{
+		return (uint32_t)s_PoolData.Entries.size();
+	}
+
+	uint32_t MeshPool::GetVertexCount()
+	{
+		return (uint32_t)s_PoolData.Vertices.size();
+	}
+
+	uint32_t MeshPool::GetIndexCount()
+	{
+		return (uint32_t)s_PoolData.Indices.size();
+	}
+}
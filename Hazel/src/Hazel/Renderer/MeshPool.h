@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Hazel/Renderer/Buffer.h"
+#include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Math/Frustum.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel
+{
+	// ڹеλãƫƣʱ BaseVertex λ
+	struct MeshAllocation
+	{
+		uint32_t BaseVertex;
+		uint32_t VertexCount;
+		uint32_t FirstIndex;
+		uint32_t IndexCount;
+		Math::AABB Bounds; // ģͿռΧ
+	};
+
+	// ȫأĶ㣨λ + ꣩ӷ鹲壬һ
+	// һαʱϴ֮פҪ 32 λʱCPUϴ
+	// ռõĿռ䲻գClear ·
+	class MeshPool
+	{
+	public:
+		static constexpr uint32_t InitialVertexCapacity = 1 << 16;
+		static constexpr uint32_t InitialIndexCapacity = 1 << 18;
+
+		struct Vertex
+		{
+			glm::vec3 Position;
+			glm::vec2 TexCoord;
+		};
+
+		// ڳеλãڳУͬһַʱϴ
+		static const MeshAllocation& Get(const Ref<Mesh>& mesh);
+
+		static const Ref<VertexBuffer>& GetVertexBuffer();
+		static const Ref<IndexBuffer>& GetIndexBuffer();
+		// ÿ´ʱһûĶҪ֮ؽ
+		static uint32_t GetGeneration();
+
+		static void Clear();
+
+		static uint32_t GetMeshCount();
+		static uint32_t GetVertexCount();
+		static uint32_t GetIndexCount();
+	};
+}
@@ -0,0 +1,234 @@
+#include "hzpch.h"
+#include "MeshSimplifier.h"
+
+namespace Hazel
+{
+	// Գ 4x4 󣬵㵽һƽƽļȨ
+	struct Quadric
+	{
+		double A2 = 0, AB = 0, AC = 0, AD = 0;
+		double B2 = 0, BC = 0, BD = 0;
+		double C2 = 0, CD = 0;
+		double D2 = 0;
+
+		void AddPlane(const glm::dvec3& n, double d, double weight)
+		{
+			A2 += weight * n.x * n.x; AB += weight * n.x * n.y; AC += weight * n.x * n.z; AD += weight * n.x * d;
+			B2 += weight * n.y * n.y; BC += weight * n.y * n.z; BD += weight * n.y * d;
+			C2 += weight * n.z * n.z; CD += weight * n.z * d;
+			D2 += weight * d * d;
+		}
+
+		Quadric& operator+=(const Quadric& other)
+		{
+			A2 += other.A2; AB += other.AB; AC += other.AC; AD += other.AD;
+			B2 += other.B2; BC += other.BC; BD += other.BD;
+			C2 += other.C2; CD += other.CD;
+			D2 += other.D2;
+			return *this;
+		}
+
+		double Evaluate(const glm::dvec3& p) const
+		{
+			return A2 * p.x * p.x + 2.0 * AB * p.x * p.y + 2.0 * AC * p.x * p.z + 2.0 * AD * p.x
+				+ B2 * p.y * p.y + 2.0 * BC * p.y * p.z + 2.0 * BD * p.y
+				+ C2 * p.z * p.z + 2.0 * CD * p.z
+				+ D2;
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t From, To;
+		double Cost;
+	};
+
+	struct PositionHash
+	{
+		size_t operator()(const glm::vec3& p) const
+		{
+			return std::hash<float>()(p.x) ^ (std::hash<float>()(p.y) * 31) ^ (std::hash<float>()(p.z) * 131);
+		}
+	};
+
+	std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<glm::vec4>& vertices, const std::vector<uint32_t>& indices, uint32_t targetIndexCount)
+	{
+		const uint32_t vertexCount = (uint32_t)vertices.size();
+		std::vector<uint32_t> result = indices;
+		if (result.size() <= targetIndexCount)
+			return result;
+
+		// λͬĶ㣨UV ӷࣩΪһ飬˶
+		std::vector<uint32_t> groups(vertexCount);
+		std::vector<uint32_t> groupSizes;
+		{
+			std::unordered_map<glm::vec3, uint32_t, PositionHash> positionGroups;
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				auto [it, inserted] = positionGroups.try_emplace(glm::vec3(vertices[i]), (uint32_t)groupSizes.size());
+				if (inserted)
+					groupSizes.push_back(0);
+				groups[i] = it->second;
+				groupSizes[it->second]++;
+			}
+		}
+		const uint32_t groupCount = (uint32_t)groupSizes.size();
+
+		auto position = [&](uint32_t vertex) { return glm::dvec3(vertices[vertex]); };
+
+		// ӷ춥㲻ƶֻһʹõıǿű߽磬ͬƶ
+		std::vector<bool> locked(groupCount);
+		for (uint32_t group = 0; group < groupCount; group++)
+			locked[group] = groupSizes[group] > 1;
+
+		std::unordered_map<uint64_t, uint32_t> edgeUses;
+		for (size_t i = 0; i + 2 < result.size(); i += 3)
+		{
+			for (int e = 0; e < 3; e++)
+			{
+				uint32_t a = groups[result[i + e]], b = groups[result[i + (e + 1) % 3]];
+				if (a != b)
+					edgeUses[((uint64_t)std::min(a, b) << 32) | std::max(a, b)]++;
+			}
+		}
+		for (const auto& [edge, uses] : edgeUses)
+		{
+			if (uses == 1)
+			{
+				locked[(uint32_t)(edge >> 32)] = true;
+				locked[(uint32_t)edge] = true;
+			}
+		}
+
+		// ÿƽ水Ȩۼӵ
+		std::vector<Quadric> quadrics(groupCount);
+		for (size_t i = 0; i + 2 < result.size(); i += 3)
+		{
+			glm::dvec3 p0 = position(result[i]), p1 = position(result[i + 1]), p2 = position(result[i + 2]);
+			glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+			double length = glm::length(normal);
+			if (length <= 0.0)
+				continue;
+
+			normal /= length;
+			Quadric quadric;
+			quadric.AddPlane(normal, -glm::dot(normal, p0), length * 0.5);
+			for (int k = 0; k < 3; k++)
+				quadrics[groups[result[i + k]]] += quadric;
+		}
+
+		std::vector<uint32_t> adjacencyOffsets, adjacency;
+		std::vector<Collapse> collapses;
+		std::vector<bool> touched;
+		std::vector<uint32_t> remap(vertexCount);
+
+		// ÿڻڵĶϰ۴С۵ֱﵽĿ޷
+		for (uint32_t pass = 0; pass < 64 && result.size() > targetIndexCount; pass++)
+		{
+			//  -> ڽӱ
+			adjacencyOffsets.assign(vertexCount + 1, 0);
+			for (uint32_t index : result)
+				adjacencyOffsets[index + 1]++;
+			for (uint32_t i = 0; i < vertexCount; i++)
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+			adjacency.resize(result.size());
+			{
+				std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (size_t i = 0; i < result.size(); i++)
+					adjacency[cursor[result[i]]++] = (uint32_t)(i / 3);
+			}
+
+			collapses.clear();
+			for (size_t i = 0; i + 2 < result.size(); i += 3)
+			{
+				for (int e = 0; e < 3; e++)
+				{
+					uint32_t from = result[i + e], to = result[i + (e + 1) % 3];
+					for (int direction = 0; direction < 2; direction++, std::swap(from, to))
+					{
+						uint32_t fromGroup = groups[from], toGroup = groups[to];
+						if (locked[fromGroup] || fromGroup == toGroup)
+							continue;
+
+						Quadric quadric = quadrics[fromGroup];
+						quadric += quadrics[toGroup];
+						collapses.push_back({ from, to, quadric.Evaluate(position(to)) });
+					}
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+			for (uint32_t i = 0; i < vertexCount; i++)
+				remap[i] = i;
+			touched.assign(vertexCount, false);
+
+			uint32_t trianglesToRemove = (uint32_t)(result.size() - targetIndexCount + 2) / 3;
+			uint32_t removed = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (touched[collapse.From] || touched[collapse.To])
+					continue;
+
+				// ۵ηĿλõλ˻ɾ
+				uint32_t toGroup = groups[collapse.To];
+				uint32_t degenerate = 0;
+				bool flipped = false;
+				for (uint32_t k = adjacencyOffsets[collapse.From]; k < adjacencyOffsets[collapse.From + 1] && !flipped; k++)
+				{
+					const uint32_t* triangle = &result[adjacency[k] * 3];
+					if (groups[triangle[0]] == toGroup || groups[triangle[1]] == toGroup || groups[triangle[2]] == toGroup)
+					{
+						degenerate++;
+						continue;
+					}
+
+					glm::dvec3 before[3], after[3];
+					for (int v = 0; v < 3; v++)
+					{
+						before[v] = position(triangle[v]);
+						after[v] = triangle[v] == collapse.From ? position(collapse.To) : before[v];
+					}
+					glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+					glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+					flipped = glm::dot(normalBefore, normalAfter) <= 0.0;
+				}
+				if (flipped)
+					continue;
+
+				remap[collapse.From] = collapse.To;
+				quadrics[toGroup] += quadrics[groups[collapse.From]];
+
+				// ֲ޸۵ΧΣ֤ķȻЧ
+				for (uint32_t k = adjacencyOffsets[collapse.From]; k < adjacencyOffsets[collapse.From + 1]; k++)
+				{
+					const uint32_t* triangle = &result[adjacency[k] * 3];
+					touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+				}
+				touched[collapse.To] = true;
+
+				removed += degenerate;
+				if (removed >= trianglesToRemove)
+					break;
+			}
+
+			// Ӧ۵ɾ˻λͬ
+			size_t writeIndex = 0;
+			for (size_t i = 0; i + 2 < result.size(); i += 3)
+			{
+				uint32_t a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+				if (groups[a] == groups[b] || groups[b] == groups[c] || groups[c] == groups[a])
+					continue;
+
+				result[writeIndex++] = a;
+				result[writeIndex++] = b;
+				result[writeIndex++] = c;
+			}
+
+			if (writeIndex == result.size())
+				break;
+			result.resize(writeIndex);
+		}
+
+		return result;
+	}
+}
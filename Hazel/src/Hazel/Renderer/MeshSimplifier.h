@@ -0,0 +1,17 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Hazel
+{
+	// Garland-Heckbert QEM۵
+	// ֻ۵ڶϡ¶㣬걣ԭֵUV ӷͿű߽ϵĶ㲻ƶ
+	class MeshSimplifier
+	{
+	public:
+		// 򻯵 targetIndexCount ޷۵ʱǰص vertices
+		static std::vector<uint32_t> Simplify(const std::vector<glm::vec4>& vertices, const std::vector<uint32_t>& indices, uint32_t targetIndexCount);
+	};
+}
@@ -0,0 +1,389 @@
+#include "hzpch.h"
+#include "OcclusionCuller.h"
+
+#include "Hazel/Core/ThreadPool.h"
+#include "Hazel/Renderer/Mesh.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <random>
+#include <emmintrin.h>
+
+namespace Hazel
+{
+	static_assert(OcclusionCuller::Width % OcclusionCuller::TileSize == 0 && OcclusionCuller::Height % OcclusionCuller::TileSize == 0,
+		"Occlusion buffer must be a whole number of tiles");
+	static_assert(OcclusionCuller::TileSize % 4 == 0, "Tiles are rasterized 4 pixels at a time");
+
+	// ĻռΣߺ A * x + B * y + C ڲǸΪĻռƽ
+	struct OccluderTriangle
+	{
+		float A[3], B[3], C[3];
+		float Z0, DzDx, DzDy;			// z(x, y) = Z0 + DzDx * x + DzDy * y
+		int32_t MinX, MinY, MaxX, MaxY;	// ıǵطΧ䣬ѲüĻ
+	};
+
+	struct OcclusionData
+	{
+		static constexpr uint32_t TilesX = OcclusionCuller::Width / OcclusionCuller::TileSize;
+		static constexpr uint32_t TilesY = OcclusionCuller::Height / OcclusionCuller::TileSize;
+
+		bool Enabled = true;
+		bool Ready = false; // ֡ѹդ
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+
+		std::vector<glm::vec4> ClipVertices;
+		std::vector<OccluderTriangle> Triangles;
+		std::vector<uint32_t> Bins[TilesX * TilesY]; // ÿֿ鸲ǵ±
+
+		std::vector<std::vector<float>> Levels; // Hi-Z 0 Ϊդ
+
+		float RasterTime = 0.0f;
+		std::chrono::high_resolution_clock::time_point BeginTime;
+	};
+	static OcclusionData s_Data;
+
+	static uint32_t GetLevelWidth(uint32_t level) { return std::max(OcclusionCuller::Width >> level, 1u); }
+	static uint32_t GetLevelHeight(uint32_t level) { return std::max(OcclusionCuller::Height >> level, 1u); }
+
+	void OcclusionCuller::SetEnabled(bool enabled)
+	{
+		s_Data.Enabled = enabled;
+	}
+
+	bool OcclusionCuller::IsEnabled()
+	{
+		return s_Data.Enabled;
+	}
+
+	void OcclusionCuller::Begin(const glm::mat4& viewProjection)
+	{
+		s_Data.BeginTime = std::chrono::high_resolution_clock::now();
+		s_Data.ViewProjection = viewProjection;
+		s_Data.Triangles.clear();
+		s_Data.Ready = false;
+
+		if (s_Data.Levels.empty())
+		{
+			for (uint32_t level = 0; s_Data.Levels.empty() || GetLevelWidth(level - 1) > 1 || GetLevelHeight(level - 1) > 1; level++)
+				s_Data.Levels.emplace_back(GetLevelWidth(level) * GetLevelHeight(level), 1.0f);
+		}
+	}
+
+	// ģͿռλãw Ϊ 1任üռ
+	static void TransformToClip(const glm::mat4& matrix, const glm::vec4* positions, uint32_t count, glm::vec4* output)
+	{
+		const __m128 col0 = _mm_loadu_ps(&matrix[0][0]);
+		const __m128 col1 = _mm_loadu_ps(&matrix[1][0]);
+		const __m128 col2 = _mm_loadu_ps(&matrix[2][0]);
+		const __m128 col3 = _mm_loadu_ps(&matrix[3][0]);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			__m128 p = _mm_loadu_ps(&positions[i].x);
+			__m128 r = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(col0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(col1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)))),
+				_mm_add_ps(_mm_mul_ps(col2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))), col3));
+			_mm_storeu_ps(&output[i].x, r);
+		}
+	}
+
+	// ӿڱ任ߺƽطΧȫĻ˻α
+	static void SetupTriangle(const glm::vec4& c0, const glm::vec4& c1, const glm::vec4& c2)
+	{
+		const float width = (float)OcclusionCuller::Width, height = (float)OcclusionCuller::Height;
+		glm::vec3 p[3];
+		const glm::vec4* clip[3] = { &c0, &c1, &c2 };
+		for (int k = 0; k < 3; k++)
+		{
+			float invW = 1.0f / clip[k]->w;
+			p[k] = { (clip[k]->x * invW * 0.5f + 0.5f) * width, (clip[k]->y * invW * 0.5f + 0.5f) * height, clip[k]->z * invW * 0.5f + 0.5f };
+		}
+
+		float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+		if (std::abs(area) < 1e-6f || std::min(p[0].z, std::min(p[1].z, p[2].z)) > 1.0f)
+			return;
+
+		//  i Ϊ i + 0.5
+		OccluderTriangle triangle;
+		triangle.MinX = std::max(0, (int32_t)std::ceil(std::min(p[0].x, std::min(p[1].x, p[2].x)) - 0.5f));
+		triangle.MinY = std::max(0, (int32_t)std::ceil(std::min(p[0].y, std::min(p[1].y, p[2].y)) - 0.5f));
+		triangle.MaxX = std::min((int32_t)OcclusionCuller::Width - 1, (int32_t)std::floor(std::max(p[0].x, std::max(p[1].x, p[2].x)) - 0.5f));
+		triangle.MaxY = std::min((int32_t)OcclusionCuller::Height - 1, (int32_t)std::floor(std::max(p[0].y, std::max(p[1].y, p[2].y)) - 0.5f));
+		if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+			return;
+
+		// 涼դתߺʹڲΪǸ
+		float sign = area > 0.0f ? 1.0f : -1.0f;
+		for (int e = 0; e < 3; e++)
+		{
+			const glm::vec3& a = p[e];
+			const glm::vec3& b = p[(e + 1) % 3];
+			triangle.A[e] = (a.y - b.y) * sign;
+			triangle.B[e] = (b.x - a.x) * sign;
+			triangle.C[e] = (a.x * b.y - b.x * a.y) * sign;
+		}
+
+		triangle.DzDx = ((p[1].z - p[0].z) * (p[2].y - p[0].y) - (p[2].z - p[0].z) * (p[1].y - p[0].y)) / area;
+		triangle.DzDy = ((p[2].z - p[0].z) * (p[1].x - p[0].x) - (p[1].z - p[0].z) * (p[2].x - p[0].x)) / area;
+		triangle.Z0 = p[0].z - triangle.DzDx * p[0].x - triangle.DzDy * p[0].y;
+		s_Data.Triangles.push_back(triangle);
+	}
+
+	void OcclusionCuller::AddOccluder(const glm::mat4& transform, const glm::vec4* positions, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+	{
+		s_Data.ClipVertices.resize(vertexCount);
+		TransformToClip(s_Data.ViewProjection * transform, positions, vertexCount, s_Data.ClipVertices.data());
+
+		for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			const glm::vec4* triangle[3] = { &s_Data.ClipVertices[indices[i]], &s_Data.ClipVertices[indices[i + 1]], &s_Data.ClipVertices[indices[i + 2]] };
+
+			// ƽ z = -wȫֱӽȫⶪüΪ4Ķβ
+			uint32_t insideMask = 0;
+			for (int k = 0; k < 3; k++)
+				insideMask |= (triangle[k]->z + triangle[k]->w >= 0.0f ? 1u : 0u) << k;
+			if (insideMask == 0)
+				continue;
+			if (insideMask == 7)
+			{
+				SetupTriangle(*triangle[0], *triangle[1], *triangle[2]);
+				continue;
+			}
+
+			glm::vec4 polygon[4];
+			uint32_t count = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				const glm::vec4& a = *triangle[k];
+				const glm::vec4& b = *triangle[(k + 1) % 3];
+				float da = a.z + a.w, db = b.z + b.w;
+				if (da >= 0.0f)
+					polygon[count++] = a;
+				if ((da >= 0.0f) != (db >= 0.0f))
+					polygon[count++] = a + (b - a) * (da / (da - db));
+			}
+			for (uint32_t k = 2; k < count; k++)
+				SetupTriangle(polygon[0], polygon[k - 1], polygon[k]);
+		}
+	}
+
+	void OcclusionCuller::AddOccluder(const glm::mat4& transform, const Mesh& mesh)
+	{
+		const std::vector<glm::vec4>& vertices = mesh.GetVertices();
+		const std::vector<uint32_t>& indices = mesh.GetIndices();
+		AddOccluder(transform, vertices.data(), (uint32_t)vertices.size(), indices.data(), (uint32_t)indices.size());
+	}
+
+	// ղդһֿ飬ֿػصɲִ
+	static void RasterizeTile(uint32_t tile)
+	{
+		const int32_t tileX = (int32_t)((tile % OcclusionData::TilesX) * OcclusionCuller::TileSize);
+		const int32_t tileY = (int32_t)((tile / OcclusionData::TilesX) * OcclusionCuller::TileSize);
+		const int32_t tileMaxX = tileX + (int32_t)OcclusionCuller::TileSize - 1;
+		const int32_t tileMaxY = tileY + (int32_t)OcclusionCuller::TileSize - 1;
+		float* depth = s_Data.Levels[0].data();
+
+		for (int32_t y = tileY; y <= tileMaxY; y++)
+			std::fill_n(depth + y * OcclusionCuller::Width + tileX, OcclusionCuller::TileSize, 1.0f);
+
+		const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 zero = _mm_setzero_ps();
+		for (uint32_t index : s_Data.Bins[tile])
+		{
+			const OccluderTriangle& triangle = s_Data.Triangles[index];
+			int32_t minX = std::max(triangle.MinX, tileX) & ~3; // 뵽4أɱߺų
+			int32_t maxX = std::min(triangle.MaxX, tileMaxX);
+			int32_t minY = std::max(triangle.MinY, tileY);
+			int32_t maxY = std::min(triangle.MaxY, tileMaxY);
+
+			const __m128 a0 = _mm_set1_ps(triangle.A[0]), a1 = _mm_set1_ps(triangle.A[1]), a2 = _mm_set1_ps(triangle.A[2]);
+			const __m128 dzdx = _mm_set1_ps(triangle.DzDx);
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				float centerY = (float)y + 0.5f;
+				const __m128 row0 = _mm_set1_ps(triangle.B[0] * centerY + triangle.C[0]);
+				const __m128 row1 = _mm_set1_ps(triangle.B[1] * centerY + triangle.C[1]);
+				const __m128 row2 = _mm_set1_ps(triangle.B[2] * centerY + triangle.C[2]);
+				const __m128 rowZ = _mm_set1_ps(triangle.DzDy * centerY + triangle.Z0);
+				float* row = depth + y * OcclusionCuller::Width;
+
+				for (int32_t x = minX; x <= maxX; x += 4)
+				{
+					__m128 centerX = _mm_add_ps(_mm_set1_ps((float)x), offsets);
+					__m128 e0 = _mm_add_ps(_mm_mul_ps(a0, centerX), row0);
+					__m128 e1 = _mm_add_ps(_mm_mul_ps(a1, centerX), row1);
+					__m128 e2 = _mm_add_ps(_mm_mul_ps(a2, centerX), row2);
+					__m128 inside = _mm_cmpge_ps(_mm_min_ps(e0, _mm_min_ps(e1, e2)), zero);
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					__m128 z = _mm_add_ps(_mm_mul_ps(dzdx, centerX), rowZ);
+					__m128 old = _mm_loadu_ps(row + x);
+					__m128 result = _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(old, z)), _mm_andnot_ps(inside, old));
+					_mm_storeu_ps(row + x, result);
+				}
+			}
+		}
+	}
+
+	void OcclusionCuller::Rasterize()
+	{
+		// طΧװ
+		for (std::vector<uint32_t>& bin : s_Data.Bins)
+			bin.clear();
+		for (uint32_t i = 0; i < (uint32_t)s_Data.Triangles.size(); i++)
+		{
+			const OccluderTriangle& triangle = s_Data.Triangles[i];
+			for (int32_t ty = triangle.MinY / (int32_t)TileSize; ty <= triangle.MaxY / (int32_t)TileSize; ty++)
+			{
+				for (int32_t tx = triangle.MinX / (int32_t)TileSize; tx <= triangle.MaxX / (int32_t)TileSize; tx++)
+					s_Data.Bins[ty * OcclusionData::TilesX + tx].push_back(i);
+			}
+		}
+
+		ThreadPool::ParallelFor(OcclusionData::TilesX * OcclusionData::TilesY, 1, [](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t tile = begin; tile < end; tile++)
+				RasterizeTile(tile);
+		});
+
+		// ÿΪһӦ 2x2 صȣԶڵ壩
+		for (uint32_t level = 1; level < (uint32_t)s_Data.Levels.size(); level++)
+		{
+			const std::vector<float>& source = s_Data.Levels[level - 1];
+			std::vector<float>& destination = s_Data.Levels[level];
+			uint32_t sourceWidth = GetLevelWidth(level - 1), sourceHeight = GetLevelHeight(level - 1);
+			uint32_t width = GetLevelWidth(level), height = GetLevelHeight(level);
+			for (uint32_t y = 0; y < height; y++)
+			{
+				const float* row0 = &source[std::min(y * 2, sourceHeight - 1) * sourceWidth];
+				const float* row1 = &source[std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth];
+				for (uint32_t x = 0; x < width; x++)
+				{
+					uint32_t x0 = std::min(x * 2, sourceWidth - 1), x1 = std::min(x * 2 + 1, sourceWidth - 1);
+					destination[y * width + x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+				}
+			}
+		}
+
+		s_Data.Ready = true;
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - s_Data.BeginTime;
+		s_Data.RasterTime = elapsed.count();
+	}
+
+	bool OcclusionCuller::IsOccluded(const Math::AABB& bounds)
+	{
+		if (!s_Data.Ready || s_Data.Triangles.empty())
+			return false;
+
+		// 8ǵͶӰĻκ
+		glm::vec2 screenMin(std::numeric_limits<float>::max()), screenMax(std::numeric_limits<float>::lowest());
+		float nearest = std::numeric_limits<float>::max();
+		for (int k = 0; k < 8; k++)
+		{
+			glm::vec3 corner = { k & 1 ? bounds.Max.x : bounds.Min.x, k & 2 ? bounds.Max.y : bounds.Min.y, k & 4 ? bounds.Max.z : bounds.Min.z };
+			glm::vec4 clip = s_Data.ViewProjection * glm::vec4(corner, 1.0f);
+			if (clip.z + clip.w < 0.0f)
+				return false;
+
+			float invW = 1.0f / clip.w;
+			glm::vec2 screen = { (clip.x * invW * 0.5f + 0.5f) * (float)Width, (clip.y * invW * 0.5f + 0.5f) * (float)Height };
+			screenMin = glm::min(screenMin, screen);
+			screenMax = glm::max(screenMax, screen);
+			nearest = std::min(nearest, clip.z * invW * 0.5f + 0.5f);
+		}
+		if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x > (float)Width || screenMin.y > (float)Height)
+			return false;
+
+		// ཻ
+		uint32_t minX = (uint32_t)std::clamp((int32_t)std::floor(screenMin.x), 0, (int32_t)Width - 1);
+		uint32_t minY = (uint32_t)std::clamp((int32_t)std::floor(screenMin.y), 0, (int32_t)Height - 1);
+		uint32_t maxX = (uint32_t)std::clamp((int32_t)std::floor(screenMax.x), 0, (int32_t)Width - 1);
+		uint32_t maxY = (uint32_t)std::clamp((int32_t)std::floor(screenMax.y), 0, (int32_t)Height - 1);
+
+		// ѡÿ 4 صĲ㼶16أ㼶ֻ̫Զ
+		uint32_t level = 0;
+		while (level + 1 < (uint32_t)s_Data.Levels.size() && ((maxX >> level) - (minX >> level) > 3 || (maxY >> level) - (minY >> level) > 3))
+			level++;
+
+		const std::vector<float>& depth = s_Data.Levels[level];
+		uint32_t width = GetLevelWidth(level);
+		for (uint32_t y = minY >> level; y <= (maxY >> level); y++)
+		{
+			for (uint32_t x = minX >> level; x <= (maxX >> level); x++)
+			{
+				if (depth[y * width + x] >= nearest)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	uint32_t OcclusionCuller::GetTriangleCount()
+	{
+		return (uint32_t)s_Data.Triangles.size();
+	}
+
+	float OcclusionCuller::GetRasterTime()
+	{
+		return s_Data.RasterTime;
+	}
+
+	const float* OcclusionCuller::GetDepth(uint32_t level)
+	{
+		return level < s_Data.Levels.size() ? s_Data.Levels[level].data() : nullptr;
+	}
+
+	uint32_t OcclusionCuller::GetLevelCount()
+	{
+		return (uint32_t)s_Data.Levels.size();
+	}
+
+	void OcclusionCuller::RunBenchmark(uint32_t iterations)
+	{
+		// ԭ㿴 -Zǽ z = -10 ס
+		glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), (float)Width / (float)Height, 0.1f, 100.0f);
+		glm::mat4 wall = glm::translate(glm::mat4(1.0f), { 0.0f, 0.0f, -10.0f }) * glm::scale(glm::mat4(1.0f), { 20.0f, 10.0f, 0.5f });
+		Ref<Mesh> cube = MeshLibrary::GetCubeMesh();
+		Math::Frustum frustum(viewProjection);
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> rangeX(-20.0f, 20.0f), rangeY(-8.0f, 8.0f), rangeZ(-60.0f, -2.0f);
+		std::vector<Math::AABB> boxes(1000);
+		for (Math::AABB& box : boxes)
+		{
+			glm::vec3 center = { rangeX(random), rangeY(random), rangeZ(random) };
+			box = { center - glm::vec3(0.5f), center + glm::vec3(0.5f) };
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < iterations; i++)
+		{
+			Begin(viewProjection);
+			AddOccluder(wall, *cube);
+			Rasterize();
+		}
+		std::chrono::duration<double, std::milli> rasterTime = std::chrono::high_resolution_clock::now() - start;
+
+		// ڵǽı棻ǽǰǽཻ屻ΪڵΪ
+		uint32_t inFrustum = 0, occluded = 0, wrong = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (const Math::AABB& box : boxes)
+		{
+			if (!frustum.Intersects(box))
+				continue;
+			inFrustum++;
+			if (IsOccluded(box))
+			{
+				occluded++;
+				if (box.Max.z > -10.25f)
+					wrong++;
+			}
+		}
+		std::chrono::duration<double, std::micro> testTime = std::chrono::high_resolution_clock::now() - start;
+
+		HZ_CORE_INFO("OcclusionCuller: {0}x{1}, {2} triangles, raster {3:.3f} ms, {4} of {5} boxes occluded ({6} wrong), {7:.1f} ns per test",
+			Width, Height, GetTriangleCount(), rasterTime.count() / iterations, occluded, inFrustum, wrong, testTime.count() * 1000.0 / std::max(inFrustum, 1u));
+	}
+}
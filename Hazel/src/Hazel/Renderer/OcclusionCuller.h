@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Hazel/Math/Frustum.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel
+{
+	class Mesh;
+
+	// CPU դڵ޳ΪڵդͷֱȻ壬ȡȵ Hi-Z ԺѡİΧ
+	// ΰֿװ䣬ֿ̳߳زйդSSE2һ4أ
+	// ȰĲڵԵֻǲʱȫ
+	class OcclusionCuller
+	{
+	public:
+		static constexpr uint32_t Width = 256;
+		static constexpr uint32_t Height = 128;
+		static constexpr uint32_t TileSize = 32;
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		// ÿ֡εãBegin -> AddOccluder... -> Rasterize -> IsOccluded...
+		static void Begin(const glm::mat4& viewProjection);
+		static void AddOccluder(const glm::mat4& transform, const glm::vec4* positions, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+		static void AddOccluder(const glm::mat4& transform, const Mesh& mesh);
+		static void Rasterize();
+
+		// ռΧбȫڵʱ trueƽĻİΧаɼ
+		static bool IsOccluded(const Math::AABB& bounds);
+
+		static uint32_t GetTriangleCount(); // ֡դڵƽü
+		static float GetRasterTime();		//  Begin  Rasterize ĺʱ(ms)
+		//  level ȣߴΪ max(Width >> level, 1) x max(Height >> level, 1)[0, 1]1 ΪԶƽ棻 0 Ϊդ
+		static const float* GetDepth(uint32_t level = 0);
+		static uint32_t GetLevelCount();
+
+		// һǽǰ壬դʱڵ־
+		static void RunBenchmark(uint32_t iterations = 200);
+	};
+}
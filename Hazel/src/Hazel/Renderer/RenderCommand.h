@@ -37,6 +37,61 @@ namespace Hazel
 			s_RendererAPI->DrawIndexed(vertexArray, indexCount);
 		}
 
+		// Ӷ㻺ĵ baseVertex 㿪ʼʽƫƣ
+		static void DrawIndexedBaseVertex(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+		{
+			s_RendererAPI->DrawIndexedBaseVertex(vertexArray, indexCount, baseVertex);
+		}
+
+		static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0)
+		{
+			s_RendererAPI->DrawIndexedInstanced(vertexArray, indexCount, instanceCount, baseInstance);
+		}
+
+		// ʹÿ㹹һ߶
+		static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex = 0)
+		{
+			s_RendererAPI->DrawLines(vertexArray, vertexCount, firstVertex);
+		}
+
+		// һύ drawCount  DrawElementsIndirectCommand commandBuffer  commandOffset ֽڴȡ
+		static void MultiDrawIndexedIndirect(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& commandBuffer, uint32_t commandOffset, uint32_t drawCount)
+		{
+			s_RendererAPI->MultiDrawIndexedIndirect(vertexArray, commandBuffer, commandOffset, drawCount);
+		}
+
+		// ѻ [offset, offset + size) Ϊɫ洢壬offset  SSBO Ҫ256ֽڶ㣩
+		static void BindStorageBuffer(uint32_t binding, const Ref<VertexBuffer>& buffer, uint32_t offset, uint32_t size)
+		{
+			s_RendererAPI->BindStorageBuffer(binding, buffer, offset, size);
+		}
+
+		// ִеǰ󶨵ļɫǰڴ
+		static void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1)
+		{
+			s_RendererAPI->DispatchCompute(groupsX, groupsY, groupsZ);
+		}
+
+		static void SetDepthFunction(RendererAPI::DepthFunction function)
+		{
+			s_RendererAPI->SetDepthFunction(function);
+		}
+
+		static void SetDepthWrite(bool enabled)
+		{
+			s_RendererAPI->SetDepthWrite(enabled);
+		}
+
+		static void SetColorWrite(bool enabled)
+		{
+			s_RendererAPI->SetColorWrite(enabled);
+		}
+
+		static void SetBlendMode(RendererAPI::BlendMode mode)
+		{
+			s_RendererAPI->SetBlendMode(mode);
+		}
+
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
 	};
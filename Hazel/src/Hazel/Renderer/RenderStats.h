@@ -9,5 +9,16 @@ namespace Hazel
 		uint32_t GeometryCount;
 		uint32_t VertexCount;
 		uint32_t IndexCount;
+		uint32_t InstanceCount;
+		uint32_t TextureBinds;
+		uint32_t RetainedQuads;		// ɳפƵľ̬
+		uint32_t RetainedRebuilds;	// ֡ؽľ̬
+		uint32_t CulledCount;		// ׶޳
+		uint32_t SubmittedCount;	// ͨ޳ύȾ
+		uint32_t OccludedCount;		// CPUڵ޳
+		float OcclusionTime;		// ڵդʱ(ms)
+		uint64_t UploadBytes;	// ֡ϴGPUĶ/ʵֽ
+		uint64_t FragmentCount;	// ɫƬԪȻͼʱͳƣȻһ֡
+		float CPUTime;			// BeginSceneEndScene֮CPUʱ(ms)
 	};
 }
\ No newline at end of file
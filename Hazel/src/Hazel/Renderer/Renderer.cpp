@@ -2,30 +2,49 @@
 
 #include "Renderer.h"
 #include "RenderStats.h"
+#include "Shader.h"
 
 namespace Hazel 
 {
 	Renderer::Mode Renderer::s_RendererMode = Mode::Renderer3D;
+	Ref<UniformBuffer> Renderer::s_CameraUniformBuffer = nullptr;
 	std::function<void(const Camera&, const glm::mat4&)> Renderer::s_BeginSceneRuntimeFn = nullptr;
 	std::function<void(const EditorCamera&)> Renderer::s_BeginSceneEditorFn = nullptr;
 	std::function<void(const glm::mat4&, SpriteRendererComponent&, int)> Renderer::s_DrawSpriteFn = nullptr;
 	std::function<void(const glm::mat4&, MeshFilterComponent&, MeshRendererComponent&, int)> Renderer::s_DrawMeshFn = nullptr;
+	std::function<void(const SpriteDrawPacket*, uint32_t)> Renderer::s_DrawSpritesFn = nullptr;
+	std::function<void(const SpriteDrawPacket*, uint32_t)> Renderer::s_DrawStaticSpritesFn = nullptr;
+	std::function<void(const MeshDrawPacket*, uint32_t)> Renderer::s_DrawMeshesFn = nullptr;
+	std::function<void(const glm::mat4&, const glm::vec4&, float, float, int)> Renderer::s_DrawCircleFn = nullptr;
+	std::function<void(const glm::vec3&, const glm::vec3&, const glm::vec4&, int)> Renderer::s_DrawLineFn = nullptr;
+	std::function<void(const glm::mat4&, const glm::vec4&, int)> Renderer::s_DrawRectFn = nullptr;
+	std::function<void(const std::string&, const Ref<Font>&, const glm::mat4&, const glm::vec4&, float, float, int)> Renderer::s_DrawStringFn = nullptr;
 	std::function<void()> Renderer::s_EndSceneFn = nullptr;
 	std::function<void()> Renderer::s_ResetStatsFn = nullptr;
 	std::function<RenderStats*()> Renderer::s_GetStatsFn = nullptr;
 
 	void Renderer::Init()
 	{
+		auto start = std::chrono::steady_clock::now();
 		RenderCommand::Init();
+		s_CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraData), CameraBinding);
 		Renderer2D::Init();
 		Renderer3D::Init();
 		SetMode(Mode::Renderer3D);
+
+		// Ƚɾ Shader::CacheDirectory Ϊ
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		const ShaderLoadStats& shaderStats = Shader::GetLoadStats();
+		HZ_CORE_INFO("Renderer: initialized in {0:.2f} ms, shaders {1:.2f} ms ({2} from cache, {3} compiled)",
+			elapsed.count(), shaderStats.LoadTime, shaderStats.CacheHits, shaderStats.CacheMisses);
 	}
 
 	void Renderer::Shutdown()
 	{
 		Renderer2D::Shutdown();
 		Renderer3D::Shutdown();
+		ShaderLibrary::Shutdown();
+		s_CameraUniformBuffer = nullptr;
 	}
 
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
@@ -57,6 +76,19 @@ namespace Hazel
 			HZ_CORE_ERROR("Renderer::EndScene: No function bound!");
 	}
 
+	void Renderer::EndFrame()
+	{
+		// Ⱦѳʼ뵱ǰģʽ޹
+		Renderer2D::EndFrame();
+		Renderer3D::EndFrame();
+	}
+
+	void Renderer::SetCamera(const glm::mat4& viewProjection)
+	{
+		CameraData data{ viewProjection };
+		s_CameraUniformBuffer->SetData(&data, sizeof(CameraData));
+	}
+
 	void Renderer::Draw(TransformComponent& transform, SpriteRendererComponent& src, entt::entity entityID)
 	{
 		if(s_DrawSpriteFn)
@@ -73,6 +105,62 @@ namespace Hazel
 			HZ_CORE_ERROR("Renderer::Draw: No function bound!");
 	}
 
+	void Renderer::DrawSprites(const std::vector<SpriteDrawPacket>& packets)
+	{
+		if (s_DrawSpritesFn)
+			s_DrawSpritesFn(packets.data(), (uint32_t)packets.size());
+		else
+			HZ_CORE_ERROR("Renderer::DrawSprites: No function bound!");
+	}
+
+	void Renderer::DrawStaticSprites(const std::vector<SpriteDrawPacket>& packets)
+	{
+		if (s_DrawStaticSpritesFn)
+			s_DrawStaticSpritesFn(packets.data(), (uint32_t)packets.size());
+		else
+			HZ_CORE_ERROR("Renderer::DrawStaticSprites: No function bound!");
+	}
+
+	void Renderer::DrawMeshes(const std::vector<MeshDrawPacket>& packets)
+	{
+		if (s_DrawMeshesFn)
+			s_DrawMeshesFn(packets.data(), (uint32_t)packets.size());
+		else
+			HZ_CORE_ERROR("Renderer::DrawMeshes: No function bound!");
+	}
+
+	void Renderer::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int entityID)
+	{
+		if (s_DrawCircleFn)
+			s_DrawCircleFn(transform, color, thickness, fade, entityID);
+		else
+			HZ_CORE_ERROR("Renderer::DrawCircle: No function bound!");
+	}
+
+	void Renderer::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID)
+	{
+		if (s_DrawLineFn)
+			s_DrawLineFn(p0, p1, color, entityID);
+		else
+			HZ_CORE_ERROR("Renderer::DrawLine: No function bound!");
+	}
+
+	void Renderer::DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID)
+	{
+		if (s_DrawRectFn)
+			s_DrawRectFn(transform, color, entityID);
+		else
+			HZ_CORE_ERROR("Renderer::DrawRect: No function bound!");
+	}
+
+	void Renderer::DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color, float kerning, float lineSpacing, int entityID)
+	{
+		if (s_DrawStringFn)
+			s_DrawStringFn(text, font, transform, color, kerning, lineSpacing, entityID);
+		else
+			HZ_CORE_ERROR("Renderer::DrawString: No function bound!");
+	}
+
 	void Renderer::ResetStats()
 	{
 		if (s_ResetStatsFn)
@@ -98,6 +186,12 @@ namespace Hazel
 			s_BeginSceneRuntimeFn = [](const Camera& camera, const glm::mat4& transform) { Renderer2D::BeginScene(camera, transform); };
 			s_BeginSceneEditorFn = [](const EditorCamera& camera) { Renderer2D::BeginScene(camera); };
 			s_DrawSpriteFn = Renderer2D::DrawSprite;
+			s_DrawSpritesFn = Renderer2D::DrawSprites;
+			s_DrawStaticSpritesFn = Renderer2D::DrawStaticSprites;
+			s_DrawCircleFn = Renderer2D::DrawCircle;
+			s_DrawLineFn = Renderer2D::DrawLine;
+			s_DrawRectFn = Renderer2D::DrawRect;
+			s_DrawStringFn = Renderer2D::DrawString;
 			s_EndSceneFn = Renderer2D::EndScene;
 			s_ResetStatsFn = Renderer2D::ResetStats;
 			s_GetStatsFn = Renderer2D::GetStats;
@@ -107,6 +201,7 @@ namespace Hazel
 			s_BeginSceneRuntimeFn = [](const Camera& camera, const glm::mat4& transform) { Renderer3D::BeginScene(camera, transform); };
 			s_BeginSceneEditorFn = [](const EditorCamera& camera) { Renderer3D::BeginScene(camera); };
 			s_DrawMeshFn = Renderer3D::DrawMesh;
+			s_DrawMeshesFn = Renderer3D::DrawMeshes;
 			s_EndSceneFn = Renderer3D::EndScene;
 			s_ResetStatsFn = Renderer3D::ResetStats;
 			s_GetStatsFn = Renderer3D::GetStats;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderCommand.h"
+#include "Hazel/Renderer/UniformBuffer.h"
 #include "Hazel/Renderer/EditorCamera.h"
 #include "Hazel/Scene/Components.h"
 #include "Renderer2D.h"
@@ -18,6 +19,13 @@ namespace Hazel
 		{
 			Renderer2D, Renderer3D
 		};
+
+		// ɫ uniform 飺layout(std140, binding = 0) uniform Camera
+		struct CameraData
+		{
+			glm::mat4 ViewProjection;
+		};
+		static constexpr uint32_t CameraBinding = 0;
 	public:
 		static void Init();
 		static void Shutdown();
@@ -26,8 +34,21 @@ namespace Hazel
 		static void BeginScene(const Camera& camera, const glm::mat4& transform);
 		static void BeginScene(const EditorCamera& camera);
 		static void EndScene();
+		// ÿ֡ʱһΣг֮󣩣 StreamingVertexBuffer::EndFrame
+		static void EndFrame();
+		// д uniform 壬ÿ BeginScene һΣɫϴ u_ViewProjection
+		static void SetCamera(const glm::mat4& viewProjection);
 		static void Draw(TransformComponent& transform, SpriteRendererComponent& src, entt::entity entityID);
 		static void Draw(TransformComponent& transform, MeshFilterComponent& mfc, MeshRendererComponent& mrc, entt::entity entityID);
+		// ύ̳߳в
+		static void DrawSprites(const std::vector<SpriteDrawPacket>& packets);
+		static void DrawStaticSprites(const std::vector<SpriteDrawPacket>& packets);
+		static void DrawMeshes(const std::vector<MeshDrawPacket>& packets);
+		// Բ߶ͼԪĿǰֻ2DȾ֧֣
+		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f, int entityID = -1);
+		static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID = -1);
+		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
+		static void DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color, float kerning = 0.0f, float lineSpacing = 0.0f, int entityID = -1);
 		static void ResetStats();
 		static RenderStats* GetStats();
 
@@ -36,10 +57,18 @@ namespace Hazel
 
 		static Mode s_RendererMode;
 	private:
+		static Ref<UniformBuffer> s_CameraUniformBuffer;
 		static std::function<void(const Camera&, const glm::mat4&)> s_BeginSceneRuntimeFn;
 		static std::function<void(const EditorCamera&)> s_BeginSceneEditorFn;
 		static std::function<void(const glm::mat4&, SpriteRendererComponent&, int)> s_DrawSpriteFn;
 		static std::function<void(const glm::mat4&, MeshFilterComponent&, MeshRendererComponent&, int)> s_DrawMeshFn;
+		static std::function<void(const SpriteDrawPacket*, uint32_t)> s_DrawSpritesFn;
+		static std::function<void(const SpriteDrawPacket*, uint32_t)> s_DrawStaticSpritesFn;
+		static std::function<void(const MeshDrawPacket*, uint32_t)> s_DrawMeshesFn;
+		static std::function<void(const glm::mat4&, const glm::vec4&, float, float, int)> s_DrawCircleFn;
+		static std::function<void(const glm::vec3&, const glm::vec3&, const glm::vec4&, int)> s_DrawLineFn;
+		static std::function<void(const glm::mat4&, const glm::vec4&, int)> s_DrawRectFn;
+		static std::function<void(const std::string&, const Ref<Font>&, const glm::mat4&, const glm::vec4&, float, float, int)> s_DrawStringFn;
 		static std::function<void()> s_EndSceneFn;
 		static std::function<void()> s_ResetStatsFn;
 		static std::function<RenderStats*()> s_GetStatsFn;
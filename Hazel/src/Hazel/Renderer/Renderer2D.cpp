@@ -1,46 +1,232 @@
 #include "hzpch.h"
 #include "Renderer2D.h"
 
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Core/ThreadPool.h"
 #include "Hazel/Renderer/VertexArray.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/RenderCommand.h"
 #include "Hazel/Renderer/RenderStats.h"
+#include "Hazel/Renderer/BatchTransform.h"
+#include "Hazel/Renderer/TextureSlotTable.h"
+#include "Hazel/Renderer/TextureArrayTable.h"
+#include "Hazel/Renderer/TextureAtlas.h"
+#include "Hazel/Renderer/Font.h"
+#include "Hazel/Math/RadixSort.h"
 #include "Hazel/Renderer/Geometry/Quad.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <chrono>
 
 namespace Hazel 
 {
+	// Բζ㣨28ֽڣֲ [-1, 1] ڣƬԪɫĵľԲ
+	struct CircleVertex
+	{
+		glm::vec3 WorldPosition;
+		uint32_t LocalPosition;	// half2
+		uint32_t Color;			// RGBA8 unorm
+		uint32_t ThicknessFade;	// half21 ΪʵģԵ𻯿
+		int EntityID;
+	};
+
+	// ߶ζ㣨20ֽڣ
+	struct LineVertex
+	{
+		glm::vec3 Position;
+		uint32_t Color;			// RGBA8 unorm
+		int EntityID;
+	};
+
+	// ζ㣨28ֽڣͼҪ
+	struct TextVertex
+	{
+		glm::vec3 Position;
+		uint32_t Color;			// RGBA8 unorm
+		glm::vec2 TexCoord;
+		int EntityID;
+	};
+
+	// ̬ĳפ飺㱣GPUУֻڵľб仯ʱؽ
+	struct StaticSpriteChunk
+	{
+		static constexpr uint32_t MaxQuads = 1024;
+
+		struct Sprite
+		{
+			glm::mat4 Transform;
+			glm::vec4 Color;
+			glm::vec4 TexRect;
+			const Texture2D* Texture; // Ϊձʾɫ
+			float TextureIndex; // ڵĲλ
+			float TilingFactor;
+			int EntityID;
+
+			bool operator==(const Sprite& other) const
+			{
+				return Transform == other.Transform && Color == other.Color && TexRect == other.TexRect && Texture == other.Texture
+					&& TextureIndex == other.TextureIndex && TilingFactor == other.TilingFactor && EntityID == other.EntityID;
+			}
+		};
+
+		Ref<VertexArray> VA;
+		Ref<VertexBuffer> VB;
+		std::vector<Sprite> Sprites;
+		std::vector<Ref<Texture2D>> Textures; // ΰ󶨵1ż֮Ĳλ0Ϊɫ
+		bool Dirty = true;
+	};
+
 	struct Renderer2DData
 	{
 		static constexpr uint32_t MaxQuads = 20000;
 		static constexpr uint32_t MaxVertices = MaxQuads * Quad::GetVertexCount();
 		static constexpr uint32_t MaxIndices = MaxQuads * Quad::GetIndexCount();
-		static constexpr uint32_t MaxTextureSlots = 32;
+		static constexpr uint32_t MaxTextureSlots = TextureSlotTable::MaxSlots;
 
 		Ref<VertexArray> QuadVA;
-		Ref<VertexBuffer> QuadVB;
+		Ref<StreamingVertexBuffer> QuadVB;
 		Ref<IndexBuffer> QuadIB;
 
 		Ref<Shader> TextureShader;
+		Ref<Shader> TextureArrayShader;
 		Ref<Texture2D> WhiteTexture;
 
 		uint32_t QuadIndexCount = 0;
-		QuadVertex* QuadVertexBufferBase = nullptr; // ָʼ
+		uint32_t QuadIndexLimit = MaxIndices; // εӳΪʣռɵ
+		QuadVertex* QuadVertexBufferBase = nullptr; // ָʼָʽӳڴ棬εһдʱӳ䣩
 		QuadVertex* QuadVertexBufferPtr = nullptr; // ƶĶָ
 
-		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
-		uint32_t TextureSlotIndex = 1;
+		// նʽ׼ʽɫ
+		VertexFormat Format = VertexFormat::Standard;
+		Ref<VertexArray> CompactQuadVA;
+		Ref<StreamingVertexBuffer> CompactQuadVB;
+		CompactVertex* CompactVertexBufferBase = nullptr;
+		CompactVertex* CompactVertexBufferPtr = nullptr;
+
+		// ʵ·һλı + ÿıһʵ
+		Ref<VertexArray> QuadInstanceVA;
+		Ref<StreamingVertexBuffer> QuadInstanceVB;
+		Ref<Shader> QuadInstanceShader;
+		Ref<Shader> QuadInstanceArrayShader;
+
+		uint32_t QuadInstanceCount = 0;
+		uint32_t QuadInstanceLimit = MaxQuads;
+		QuadInstance* QuadInstanceBufferBase = nullptr;
+		QuadInstance* QuadInstanceBufferPtr = nullptr;
+
+		Renderer2D::QuadSubmission Submission = Renderer2D::QuadSubmission::Batched;
+		std::chrono::high_resolution_clock::time_point SceneBeginTime;
+
+		Renderer2D::TextureBackend Backend = Renderer2D::TextureBackend::Slots;
+		TextureSlotTable TextureSlots;
+		TextureArrayTable TextureArrays;
+
+		// ӳύBeginScene  EndScene ֻ֮¼
+		struct QuadCommand
+		{
+			glm::mat4 Transform;
+			glm::vec4 Color;
+			glm::vec4 TexRect;
+			uint32_t TextureIndex; // CommandTextures е±꣬0 ʾ
+			float TilingFactor;
+			int EntityID;
+		};
+
+		Renderer2D::SortMode Sorting = Renderer2D::SortMode::Immediate;
+		bool Recording = false;
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		std::vector<QuadCommand> Commands;
+		std::vector<uint64_t> SortKeys, SortKeysTemp;
+		std::vector<uint32_t> SortIndices, SortIndicesTemp;
+		std::vector<Ref<Texture2D>> CommandTextures;
+		std::unordered_map<uint32_t, uint32_t> CommandTextureIndices; // RendererID -> CommandTextures е±
+
+		// ԲΣÿԲһıΣıι
+		Ref<VertexArray> CircleVA;
+		Ref<StreamingVertexBuffer> CircleVB;
+		Ref<Shader> CircleShader;
+
+		uint32_t CircleIndexCount = 0;
+		uint32_t CircleIndexLimit = MaxIndices;
+		CircleVertex* CircleVertexBufferBase = nullptr;
+		CircleVertex* CircleVertexBufferPtr = nullptr;
+
+		// ߶Σʹÿһ߶
+		Ref<VertexArray> LineVA;
+		Ref<StreamingVertexBuffer> LineVB;
+		Ref<Shader> LineShader;
+
+		uint32_t LineVertexCount = 0;
+		uint32_t LineVertexLimit = MaxVertices;
+		LineVertex* LineVertexBufferBase = nullptr;
+		LineVertex* LineVertexBufferPtr = nullptr;
+
+		// ΣÿһıΣһֻʹһͼ
+		Ref<VertexArray> TextVA;
+		Ref<StreamingVertexBuffer> TextVB;
+		Ref<Shader> TextShader;
+		Ref<Texture2D> FontAtlasTexture;
+
+		uint32_t TextIndexCount = 0;
+		uint32_t TextIndexLimit = MaxIndices;
+		TextVertex* TextVertexBufferBase = nullptr;
+		TextVertex* TextVertexBufferPtr = nullptr;
+
+		// ַŰ滺棺ַŰûб仯ʱֱӸı
+		struct TextLayout
+		{
+			Ref<Font> FontAsset;
+			std::string Text;
+			float Kerning;
+			float LineSpacing;
+			std::vector<GlyphQuad> Quads;
+			uint64_t LastUsedFrame;
+		};
+		static constexpr uint64_t TextLayoutLifetime = 256; // ô֡δʹõŰ汻
+		std::unordered_map<size_t, TextLayout> TextLayouts;
+		uint64_t FrameIndex = 0;
+
+		// ̬飺ύ˳зΪ飬֡һ֡ݱȽ
+		BufferLayout QuadLayout;
+		std::vector<StaticSpriteChunk> StaticChunks;
+		TextureSlotTable StaticSlots;
+		std::vector<QuadVertex> StaticVertices; // ؽʱʱ
 
 		RenderStats Stats;
 	};
 	static Renderer2DData s_Data;
 
+	static Ref<Shader> GetOrLoadShader(const std::string& name, const std::string& filepath)
+	{
+		if (ShaderLibrary::Exists(name))
+			return ShaderLibrary::Get(name);
+		return ShaderLibrary::Load(filepath);
+	}
+
+	static const glm::vec4 FullTexRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+	// (min.xy, max.xy) չ Quad::GetTextureCoords ˳һµ4
+	static void RectToTexCoords(const glm::vec4& rect, glm::vec2* texCoords)
+	{
+		texCoords[0] = { rect.x, rect.y };
+		texCoords[1] = { rect.z, rect.y };
+		texCoords[2] = { rect.z, rect.w };
+		texCoords[3] = { rect.x, rect.w };
+	}
+
+	static void SetViewProjection(const glm::mat4& viewProj)
+	{
+		s_Data.ViewProjection = viewProj;
+		Renderer::SetCamera(viewProj);
+	}
+
 	void Renderer2D::Init()
 	{
-		// 뻭һıҪ洢ռ䣬ָ
-		s_Data.QuadVB = VertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
+		// 뻭һıҪ洢ռ䣨ÿһָ
+		s_Data.QuadVB = StreamingVertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
 
 		BufferLayout squareLayout =
 		{
@@ -53,6 +239,7 @@ namespace Hazel
 		};
 
 		s_Data.QuadVB->SetLayout(squareLayout);
+		s_Data.QuadLayout = squareLayout;
 
 		// ıεEBO
 		uint32_t* quadIndices = new uint32_t[s_Data.MaxIndices];
@@ -71,8 +258,96 @@ namespace Hazel
 		s_Data.QuadVA->AddVertexBuffer(s_Data.QuadVB);
 		s_Data.QuadVA->Unbind();
 
-		// ṹռ
-		s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];	//ָʼλ
+		s_Data.CompactQuadVB = StreamingVertexBuffer::Create(s_Data.MaxVertices * sizeof(CompactVertex));
+		s_Data.CompactQuadVB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::UByte4, "a_Color", true},
+			{ShaderDataType::Half2, "a_TexCoord"},
+			{ShaderDataType::UShort, "a_TexIndex"},
+			{ShaderDataType::Half, "a_TilingFactor"},
+			{ShaderDataType::Int, "a_EntityID"}
+		});
+
+		s_Data.CompactQuadVA = VertexArray::Create();
+		s_Data.CompactQuadVA->SetIndexBuffer(s_Data.QuadIB);
+		s_Data.CompactQuadVA->AddVertexBuffer(s_Data.CompactQuadVB);
+		s_Data.CompactQuadVA->Unbind();
+
+		// ʵõĵλıΣλ + 
+		float unitQuadVertices[Quad::GetVertexCount() * 5];
+		for (uint32_t i = 0; i < Quad::GetVertexCount(); i++)
+		{
+			const glm::vec4& position = Quad::GetVertices()[i];
+			const glm::vec2& texCoord = Quad::GetTextureCoords()[i];
+			float* vertex = unitQuadVertices + i * 5;
+			vertex[0] = position.x; vertex[1] = position.y; vertex[2] = position.z;
+			vertex[3] = texCoord.x; vertex[4] = texCoord.y;
+		}
+		Ref<VertexBuffer> unitQuadVB = VertexBuffer::Create(unitQuadVertices, sizeof(unitQuadVertices));
+		unitQuadVB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::Float2, "a_TexCoord"}
+		});
+
+		s_Data.QuadInstanceVB = StreamingVertexBuffer::Create(s_Data.MaxQuads * sizeof(QuadInstance));
+		BufferLayout instanceLayout =
+		{
+			{ShaderDataType::Float3, "a_TransformX"},
+			{ShaderDataType::Float3, "a_TransformY"},
+			{ShaderDataType::Float3, "a_Translation"},
+			{ShaderDataType::Int, "a_Color"},
+			{ShaderDataType::Int, "a_TexIndex"},
+			{ShaderDataType::Float, "a_TilingFactor"},
+			{ShaderDataType::Int, "a_EntityID"},
+			{ShaderDataType::Float4, "a_TexRect"}
+		};
+		instanceLayout.SetDivisor(1);
+		s_Data.QuadInstanceVB->SetLayout(instanceLayout);
+
+		// ãֻʹǰ6
+		s_Data.QuadInstanceVA = VertexArray::Create();
+		s_Data.QuadInstanceVA->SetIndexBuffer(s_Data.QuadIB);
+		s_Data.QuadInstanceVA->AddVertexBuffer(unitQuadVB);
+		s_Data.QuadInstanceVA->AddVertexBuffer(s_Data.QuadInstanceVB);
+		s_Data.QuadInstanceVA->Unbind();
+
+		s_Data.CircleVB = StreamingVertexBuffer::Create(s_Data.MaxVertices * sizeof(CircleVertex));
+		s_Data.CircleVB->SetLayout({
+			{ShaderDataType::Float3, "a_WorldPosition"},
+			{ShaderDataType::Half2, "a_LocalPosition"},
+			{ShaderDataType::UByte4, "a_Color", true},
+			{ShaderDataType::Half2, "a_ThicknessFade"},
+			{ShaderDataType::Int, "a_EntityID"}
+		});
+
+		s_Data.CircleVA = VertexArray::Create();
+		s_Data.CircleVA->SetIndexBuffer(s_Data.QuadIB);
+		s_Data.CircleVA->AddVertexBuffer(s_Data.CircleVB);
+		s_Data.CircleVA->Unbind();
+
+		s_Data.LineVB = StreamingVertexBuffer::Create(s_Data.MaxVertices * sizeof(LineVertex));
+		s_Data.LineVB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::UByte4, "a_Color", true},
+			{ShaderDataType::Int, "a_EntityID"}
+		});
+
+		s_Data.LineVA = VertexArray::Create();
+		s_Data.LineVA->AddVertexBuffer(s_Data.LineVB);
+		s_Data.LineVA->Unbind();
+
+		s_Data.TextVB = StreamingVertexBuffer::Create(s_Data.MaxVertices * sizeof(TextVertex));
+		s_Data.TextVB->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::UByte4, "a_Color", true},
+			{ShaderDataType::Float2, "a_TexCoord"},
+			{ShaderDataType::Int, "a_EntityID"}
+		});
+
+		s_Data.TextVA = VertexArray::Create();
+		s_Data.TextVA->SetIndexBuffer(s_Data.QuadIB);
+		s_Data.TextVA->AddVertexBuffer(s_Data.TextVB);
+		s_Data.TextVA->Unbind();
 
 		// 
 		int32_t samplers[s_Data.MaxTextureSlots];
@@ -80,71 +355,358 @@ namespace Hazel
 			samplers[i] = i;
 
 		// Shader
-		if (ShaderLibrary::Exists("Texture"))
-			s_Data.TextureShader = ShaderLibrary::Get("Texture");
-		else
-			s_Data.TextureShader = ShaderLibrary::Load("assets/shaders/Texture.glsl");
+		// ȫύ룬ֲ֧бʱͬʱ uniform ʱֻȴӦɫ
+		s_Data.TextureShader = GetOrLoadShader("Texture", "assets/shaders/Texture.glsl");
+		s_Data.QuadInstanceShader = GetOrLoadShader("QuadInstanced", "assets/shaders/QuadInstanced.glsl");
+		s_Data.TextureArrayShader = GetOrLoadShader("TextureArray", "assets/shaders/TextureArray.glsl");
+		s_Data.QuadInstanceArrayShader = GetOrLoadShader("QuadInstancedArray", "assets/shaders/QuadInstancedArray.glsl");
+		s_Data.CircleShader = GetOrLoadShader("Circle", "assets/shaders/Circle.glsl");
+		s_Data.LineShader = GetOrLoadShader("Line", "assets/shaders/Line.glsl");
+		s_Data.TextShader = GetOrLoadShader("Text", "assets/shaders/Text.glsl");
+
 		s_Data.TextureShader->Bind();
 		//ϴвӦԪ
 		s_Data.TextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
 
+		s_Data.QuadInstanceShader->Bind();
+		s_Data.QuadInstanceShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
+
+		// ˵Ĳ
+		s_Data.TextureArrayShader->Bind();
+		s_Data.TextureArrayShader->SetIntArray("u_TexturePages", samplers, TextureArrayTable::MaxUnits);
+
+		s_Data.QuadInstanceArrayShader->Bind();
+		s_Data.QuadInstanceArrayShader->SetIntArray("u_TexturePages", samplers, TextureArrayTable::MaxUnits);
+
+		s_Data.TextShader->Bind();
+		s_Data.TextShader->SetInt("u_FontAtlas", 0);
+		s_Data.TextShader->SetFloat("u_DistanceRange", (float)Font::DistanceRange);
+
 		// Texture
 		s_Data.WhiteTexture = Texture2D::Create(1, 1);
 		uint32_t whiteTextureData = 0xffffffff;
 		s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
-		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+		s_Data.TextureSlots.SetWhiteTexture(s_Data.WhiteTexture);
+		s_Data.StaticSlots.SetWhiteTexture(s_Data.WhiteTexture);
+		s_Data.TextureArrays.SetWhiteTexture(s_Data.WhiteTexture);
+
+		s_Data.CommandTextures.push_back(nullptr); // 0 űʾ
 	}
 
 	void Renderer2D::Shutdown()
 	{
-		delete[] s_Data.QuadVertexBufferBase;
+		s_Data.TextureArrays.Clear();
+		s_Data.StaticChunks.clear();
+		s_Data.TextLayouts.clear();
+		s_Data.FontAtlasTexture = nullptr;
+		TextureAtlas::Clear();
+		Font::ReleaseDefault();
+	}
+
+	void Renderer2D::SetTextureBackend(TextureBackend backend)
+	{
+		s_Data.Backend = backend;
+	}
+
+	Renderer2D::TextureBackend Renderer2D::GetTextureBackend()
+	{
+		return s_Data.Backend;
+	}
+
+	void Renderer2D::SetSortMode(SortMode mode)
+	{
+		s_Data.Sorting = mode;
+	}
+
+	Renderer2D::SortMode Renderer2D::GetSortMode()
+	{
+		return s_Data.Sorting;
+	}
+
+	void Renderer2D::SetVertexFormat(VertexFormat format)
+	{
+		s_Data.Format = format;
+	}
+
+	VertexFormat Renderer2D::GetVertexFormat()
+	{
+		return s_Data.Format;
+	}
+
+	void Renderer2D::SetQuadSubmission(QuadSubmission submission)
+	{
+		s_Data.Submission = submission;
+	}
+
+	Renderer2D::QuadSubmission Renderer2D::GetQuadSubmission()
+	{
+		return s_Data.Submission;
 	}
 
 	void Renderer2D::BeginScene(const Camera& camera, const glm::mat4& transform)
 	{
+		s_Data.SceneBeginTime = std::chrono::high_resolution_clock::now();
 		glm::mat4 viewProj = camera.GetProjection() * glm::inverse(transform);
-
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		SetViewProjection(viewProj);
+		s_Data.Recording = s_Data.Sorting == SortMode::Deferred;
+		TextureAtlas::Update(); // һ֡ľ
 
 		StartBatch();
 	}
 
 	void Renderer2D::BeginScene(const EditorCamera& camera)
 	{
+		s_Data.SceneBeginTime = std::chrono::high_resolution_clock::now();
 		glm::mat4 viewProj = camera.GetViewProjection();
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		SetViewProjection(viewProj);
+		s_Data.Recording = s_Data.Sorting == SortMode::Deferred;
+		TextureAtlas::Update(); // һ֡ľ
 		StartBatch();
 	}
 
 	void Renderer2D::EndScene()
 	{
+		if (s_Data.Recording)
+			ReplayQuads();
+
 		Flush();
+
+		// ʱδʹõַŰ
+		if (++s_Data.FrameIndex % Renderer2DData::TextLayoutLifetime == 0)
+		{
+			for (auto it = s_Data.TextLayouts.begin(); it != s_Data.TextLayouts.end();)
+			{
+				if (it->second.LastUsedFrame + Renderer2DData::TextLayoutLifetime < s_Data.FrameIndex)
+					it = s_Data.TextLayouts.erase(it);
+				else
+					++it;
+			}
+		}
+
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - s_Data.SceneBeginTime;
+		s_Data.Stats.CPUTime += elapsed.count();
+	}
+
+	void Renderer2D::RecordQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec4& texRect, bool translucent, float tilingFactor, const glm::vec4& color, int entityID)
+	{
+		uint32_t textureIndex = 0;
+		translucent |= color.a < 1.0f;
+		if (texture)
+		{
+			auto [it, inserted] = s_Data.CommandTextureIndices.try_emplace(texture->GetRendererID(), (uint32_t)s_Data.CommandTextures.size());
+			if (inserted)
+				s_Data.CommandTextures.push_back(texture);
+			textureIndex = it->second;
+		}
+
+		// ıĵ NDC 
+		glm::vec4 clip = s_Data.ViewProjection * transform[3];
+		float depth = clip.w != 0.0f ? clip.z / clip.w : clip.z;
+		uint32_t depthBits = Math::FloatToSortableBits(depth);
+
+		// [63..56 ͼ][55 ͸][47..0 ͸: 16λ + 32λ(Զ) / ͸: 32λ(Զ) + 16λ]
+		// ʱûͼͼλΪ0
+		uint64_t key;
+		if (translucent)
+			key = (1ull << 55) | ((uint64_t)~depthBits << 16) | (textureIndex & 0xFFFF);
+		else
+			key = ((uint64_t)(textureIndex & 0xFFFF) << 32) | depthBits;
+
+		s_Data.Commands.push_back({ transform, color, texRect, textureIndex, tilingFactor, entityID });
+		s_Data.SortKeys.push_back(key);
+	}
+
+	void Renderer2D::ReplayQuads()
+	{
+		s_Data.Recording = false;
+
+		uint32_t count = (uint32_t)s_Data.Commands.size();
+		s_Data.SortIndices.resize(count);
+		s_Data.SortKeysTemp.resize(count);
+		s_Data.SortIndicesTemp.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			s_Data.SortIndices[i] = i;
+
+		Math::RadixSort(s_Data.SortKeys.data(), s_Data.SortIndices.data(), s_Data.SortKeysTemp.data(), s_Data.SortIndicesTemp.data(), count);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const Renderer2DData::QuadCommand& command = s_Data.Commands[s_Data.SortIndices[i]];
+			if (command.TextureIndex)
+			{
+				glm::vec2 texCoords[4];
+				RectToTexCoords(command.TexRect, texCoords);
+				SubmitTexturedQuad(command.Transform, s_Data.CommandTextures[command.TextureIndex], texCoords, command.TilingFactor, command.Color, command.EntityID);
+			}
+			else
+				DrawQuad(command.Transform, command.Color, command.EntityID);
+		}
+
+		s_Data.Commands.clear();
+		s_Data.SortKeys.clear();
+		s_Data.CommandTextures.resize(1);
+		s_Data.CommandTextureIndices.clear();
 	}
 
 	void Renderer2D::StartBatch()
 	{
 		s_Data.QuadIndexCount = 0; //ÿˢ£һȾҪƵҪ¿ʼ
-		s_Data.TextureSlotIndex = 1; //ÿˢ£һȾҪƵҪһ¿ʼ0Ź̶λɫ
-		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase; // ָ
+		s_Data.TextureSlots.Reset(); //ÿˢ£һȾҪƵҪһ¿ʼ0Ź̶λɫ
+		s_Data.TextureArrays.Reset();
+		// ʽεһдʱӳ䣨 MapStreamһûдĻ岻ỻҲȴ
+		s_Data.QuadIndexLimit = Renderer2DData::MaxIndices;
+		s_Data.QuadVertexBufferBase = s_Data.QuadVertexBufferPtr = nullptr;
+		s_Data.CompactVertexBufferBase = s_Data.CompactVertexBufferPtr = nullptr;
+
+		s_Data.QuadInstanceCount = 0;
+		s_Data.QuadInstanceLimit = Renderer2DData::MaxQuads;
+		s_Data.QuadInstanceBufferBase = s_Data.QuadInstanceBufferPtr = nullptr;
+
+		s_Data.CircleIndexCount = 0;
+		s_Data.CircleIndexLimit = Renderer2DData::MaxIndices;
+		s_Data.CircleVertexBufferBase = s_Data.CircleVertexBufferPtr = nullptr;
+
+		s_Data.LineVertexCount = 0;
+		s_Data.LineVertexLimit = Renderer2DData::MaxVertices;
+		s_Data.LineVertexBufferBase = s_Data.LineVertexBufferPtr = nullptr;
+
+		s_Data.TextIndexCount = 0;
+		s_Data.TextIndexLimit = Renderer2DData::MaxIndices;
+		s_Data.TextVertexBufferBase = s_Data.TextVertexBufferPtr = nullptr;
+		s_Data.FontAtlasTexture = nullptr;
+	}
+
+	// εһдĳʽʱӳ䣺ű֮֡ǰд룬Ϊǰʣռ䣨ޣ
+	// primitiveSize ΪһͼԪֽcapacity ؿдͼԪ
+	static void* MapStream(const Ref<StreamingVertexBuffer>& buffer, uint32_t primitiveSize, uint32_t maxPrimitives, uint32_t& capacity)
+	{
+		uint32_t available = 0;
+		void* base = buffer->Map(primitiveSize, available);
+		capacity = std::min(maxPrimitives, available / primitiveSize);
+		return base;
+	}
+
+	static void MapQuadVertices()
+	{
+		uint32_t quads = 0;
+		if (s_Data.Format == VertexFormat::Compact)
+		{
+			s_Data.CompactVertexBufferBase = (CompactVertex*)MapStream(s_Data.CompactQuadVB, Quad::GetVertexCount() * sizeof(CompactVertex), Renderer2DData::MaxQuads, quads);
+			s_Data.CompactVertexBufferPtr = s_Data.CompactVertexBufferBase;
+		}
+		else
+		{
+			s_Data.QuadVertexBufferBase = (QuadVertex*)MapStream(s_Data.QuadVB, Quad::GetVertexCount() * sizeof(QuadVertex), Renderer2DData::MaxQuads, quads);
+			s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase; // ָ
+		}
+		s_Data.QuadIndexLimit = quads * Quad::GetIndexCount();
+	}
+
+	static bool IsQuadVertexStreamMapped()
+	{
+		return s_Data.Format == VertexFormat::Compact ? s_Data.CompactVertexBufferBase != nullptr : s_Data.QuadVertexBufferBase != nullptr;
+	}
+
+	void Renderer2D::EndFrame()
+	{
+		s_Data.QuadVB->EndFrame();
+		s_Data.CompactQuadVB->EndFrame();
+		s_Data.QuadInstanceVB->EndFrame();
+		s_Data.CircleVB->EndFrame();
+		s_Data.LineVB->EndFrame();
+		s_Data.TextVB->EndFrame();
 	}
 
 	void Renderer2D::Flush()
 	{
-		if (s_Data.QuadIndexCount == 0)
+		FlushQuads();
+
+		if (s_Data.CircleIndexCount)
+		{
+			uint32_t dataSize = uint32_t((uint8_t*)s_Data.CircleVertexBufferPtr - (uint8_t*)s_Data.CircleVertexBufferBase);
+			s_Data.Stats.UploadBytes += dataSize;
+
+			uint32_t baseVertex = s_Data.CircleVB->Commit(dataSize) / sizeof(CircleVertex);
+			s_Data.CircleShader->Bind();
+			RenderCommand::DrawIndexedBaseVertex(s_Data.CircleVA, s_Data.CircleIndexCount, baseVertex);
+			s_Data.Stats.DrawCalls++;
+		}
+
+		if (s_Data.LineVertexCount)
+		{
+			uint32_t dataSize = uint32_t((uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase);
+			s_Data.Stats.UploadBytes += dataSize;
+
+			uint32_t firstVertex = s_Data.LineVB->Commit(dataSize) / sizeof(LineVertex);
+			s_Data.LineShader->Bind();
+			RenderCommand::DrawLines(s_Data.LineVA, s_Data.LineVertexCount, firstVertex);
+			s_Data.Stats.DrawCalls++;
+		}
+
+		if (s_Data.TextIndexCount)
+		{
+			uint32_t dataSize = uint32_t((uint8_t*)s_Data.TextVertexBufferPtr - (uint8_t*)s_Data.TextVertexBufferBase);
+			s_Data.Stats.UploadBytes += dataSize;
+
+			uint32_t baseVertex = s_Data.TextVB->Commit(dataSize) / sizeof(TextVertex);
+			s_Data.FontAtlasTexture->Bind(0);
+			s_Data.TextShader->Bind();
+			RenderCommand::DrawIndexedBaseVertex(s_Data.TextVA, s_Data.TextIndexCount, baseVertex);
+			s_Data.Stats.DrawCalls++;
+			s_Data.Stats.TextureBinds++;
+		}
+	}
+
+	void Renderer2D::FlushQuads()
+	{
+		if (s_Data.QuadIndexCount == 0 && s_Data.QuadInstanceCount == 0)
 			return;
 
-		// Size ںָȥǰ(hind ڻʱһֱݣ
-		uint32_t dataSize = uint32_t((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
-		// GPU
-		s_Data.QuadVB->SetData(s_Data.QuadVertexBufferBase, dataSize);
+		bool textureArrays = s_Data.Backend == TextureBackend::Arrays;
+		if (textureArrays)
+		{
+			s_Data.TextureArrays.BindAll();
+			s_Data.Stats.TextureBinds += s_Data.TextureArrays.GetUnitCount();
+		}
+		else
+		{
+			s_Data.TextureSlots.BindAll();
+			s_Data.Stats.TextureBinds += s_Data.TextureSlots.GetCount();
+		}
+
+		// ʽ洢д룬ǰ
+		BatchTransform::Fence();
 
-		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-			s_Data.TextureSlots[i]->Bind(i);
+		if (s_Data.QuadIndexCount)
+		{
+			bool compact = s_Data.Format == VertexFormat::Compact;
+			const Ref<VertexArray>& vertexArray = compact ? s_Data.CompactQuadVA : s_Data.QuadVA;
+			const Ref<StreamingVertexBuffer>& vertexBuffer = compact ? s_Data.CompactQuadVB : s_Data.QuadVB;
 
-		RenderCommand::DrawIndexed(s_Data.QuadVA, s_Data.QuadIndexCount);
-		s_Data.Stats.DrawCalls++;
+			// Size ںָȥǰ(hind ڻʱһֱݣ
+			uint32_t dataSize = compact
+				? uint32_t((uint8_t*)s_Data.CompactVertexBufferPtr - (uint8_t*)s_Data.CompactVertexBufferBase)
+				: uint32_t((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
+			s_Data.Stats.UploadBytes += dataSize;
+
+			// ӳڴУֻһʼ㿪ʼ
+			uint32_t vertexSize = compact ? sizeof(CompactVertex) : sizeof(QuadVertex);
+			uint32_t baseVertex = vertexBuffer->Commit(dataSize) / vertexSize;
+			(textureArrays ? s_Data.TextureArrayShader : s_Data.TextureShader)->Bind();
+			RenderCommand::DrawIndexedBaseVertex(vertexArray, s_Data.QuadIndexCount, baseVertex);
+			s_Data.Stats.DrawCalls++;
+		}
+
+		if (s_Data.QuadInstanceCount)
+		{
+			uint32_t dataSize = uint32_t((uint8_t*)s_Data.QuadInstanceBufferPtr - (uint8_t*)s_Data.QuadInstanceBufferBase);
+			s_Data.Stats.UploadBytes += dataSize;
+
+			uint32_t baseInstance = s_Data.QuadInstanceVB->Commit(dataSize) / sizeof(QuadInstance);
+			(textureArrays ? s_Data.QuadInstanceArrayShader : s_Data.QuadInstanceShader)->Bind();
+			RenderCommand::DrawIndexedInstanced(s_Data.QuadInstanceVA, Quad::GetIndexCount(), s_Data.QuadInstanceCount, baseInstance);
+			s_Data.Stats.DrawCalls++;
+		}
 	}
 
 	void Renderer2D::NextBatch()
@@ -181,72 +743,369 @@ namespace Hazel
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& color, int entityID)
 	{
+		if (s_Data.Recording)
+		{
+			RecordQuad(transform, nullptr, FullTexRect, false, 1.0f, color, entityID);
+			return;
+		}
+
 		const float textureIndex = 0.0f; // White Texture
 		const float tilingFactor = 1.0f;
 
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+		SubmitQuad(transform, color, textureIndex, tilingFactor, entityID, Quad::GetTextureCoords().data());
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		if (s_Data.Recording)
+		{
+			RecordQuad(transform, texture, FullTexRect, texture->HasTranslucency(), tilingFactor, tintColor, entityID);
+			return;
+		}
+
+		SubmitTexturedQuad(transform, texture, Quad::GetTextureCoords().data(), tilingFactor, tintColor, entityID);
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		if (s_Data.Recording)
+		{
+			// ͸򣬶ͼ
+			RecordQuad(transform, subTexture->GetTexture(), subTexture->GetTexRect(), subTexture->HasTranslucency(), tilingFactor, tintColor, entityID);
+			return;
+		}
+
+		SubmitTexturedQuad(transform, subTexture->GetTexture(), subTexture->GetTexCoords(), tilingFactor, tintColor, entityID);
+	}
+
+	void Renderer2D::SubmitTexturedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec2* texCoords, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		if (s_Data.QuadIndexCount >= s_Data.QuadIndexLimit || s_Data.QuadInstanceCount >= s_Data.QuadInstanceLimit)
+			NextBatch();
+
+		float textureIndex = GetTextureIndex(texture);
+		SubmitQuad(transform, tintColor, textureIndex, tilingFactor, entityID, texCoords);
+	}
+
+	float Renderer2D::GetTextureIndex(const Ref<Texture2D>& texture)
+	{
+		// ǷѾ룬δ²λ˷ر
+		auto findOrAdd = [&texture]()
+		{
+			if (s_Data.Backend == TextureBackend::Arrays)
+				return s_Data.TextureArrays.FindOrAdd(texture);
+			return s_Data.TextureSlots.FindOrAdd(texture);
+		};
+
+		int32_t slot = findOrAdd();
+		if (slot < 0)
+		{
+			// λˢκ´
+			NextBatch();
+			slot = findOrAdd();
+		}
+		return (float)slot;
+	}
+
+	void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int entityID)
+	{
+		if (s_Data.CircleIndexCount >= s_Data.CircleIndexLimit)
 			NextBatch();
+		if (!s_Data.CircleVertexBufferBase)
+		{
+			uint32_t circles = 0;
+			s_Data.CircleVertexBufferBase = (CircleVertex*)MapStream(s_Data.CircleVB, Quad::GetVertexCount() * sizeof(CircleVertex), Renderer2DData::MaxQuads, circles);
+			s_Data.CircleVertexBufferPtr = s_Data.CircleVertexBufferBase;
+			s_Data.CircleIndexLimit = circles * Quad::GetIndexCount();
+		}
 
-		for (size_t i = 0; i < Quad::GetVertexCount(); i++)
+		uint32_t packedColor = glm::packUnorm4x8(color);
+		uint32_t thicknessFade = glm::packHalf2x16({ thickness, fade });
+		for (uint32_t i = 0; i < Quad::GetVertexCount(); i++)
 		{
-			s_Data.QuadVertexBufferPtr->Position = transform * Quad::GetVertices()[i];
-			s_Data.QuadVertexBufferPtr->Color = color;
-			s_Data.QuadVertexBufferPtr->TexCoord = Quad::GetTextureCoords()[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr->EntityID = entityID;
-			s_Data.QuadVertexBufferPtr++;
+			const glm::vec4& position = Quad::GetVertices()[i];
+			CircleVertex& vertex = *s_Data.CircleVertexBufferPtr++;
+			vertex.WorldPosition = transform * position;
+			vertex.LocalPosition = glm::packHalf2x16(glm::vec2(position) * 2.0f);
+			vertex.Color = packedColor;
+			vertex.ThicknessFade = thicknessFade;
+			vertex.EntityID = entityID;
 		}
+		s_Data.CircleIndexCount += Quad::GetIndexCount();
 
-		s_Data.QuadIndexCount += Quad::GetIndexCount();
+		s_Data.Stats.GeometryCount++;
 		s_Data.Stats.VertexCount += Quad::GetVertexCount();
 		s_Data.Stats.IndexCount += Quad::GetIndexCount();
-		s_Data.Stats.GeometryCount++;
 	}
 
-	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	void Renderer2D::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID)
 	{
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+		if (s_Data.LineVertexCount + 2 > s_Data.LineVertexLimit)
 			NextBatch();
+		if (!s_Data.LineVertexBufferBase)
+		{
+			uint32_t lines = 0;
+			s_Data.LineVertexBufferBase = (LineVertex*)MapStream(s_Data.LineVB, 2 * sizeof(LineVertex), Renderer2DData::MaxVertices / 2, lines);
+			s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
+			s_Data.LineVertexLimit = lines * 2;
+		}
+
+		uint32_t packedColor = glm::packUnorm4x8(color);
+		*s_Data.LineVertexBufferPtr++ = { p0, packedColor, entityID };
+		*s_Data.LineVertexBufferPtr++ = { p1, packedColor, entityID };
+		s_Data.LineVertexCount += 2;
+
+		s_Data.Stats.GeometryCount++;
+		s_Data.Stats.VertexCount += 2;
+	}
+
+	void Renderer2D::DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID)
+	{
+		glm::vec3 corners[4];
+		for (uint32_t i = 0; i < Quad::GetVertexCount(); i++)
+			corners[i] = transform * Quad::GetVertices()[i];
+
+		for (uint32_t i = 0; i < 4; i++)
+			DrawLine(corners[i], corners[(i + 1) % 4], color, entityID);
+	}
+
+	static void HashCombine(size_t& seed, size_t value)
+	{
+		seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
 
-		// 鿴ǷѾ
-		float textureIndex = 0.0f;
-		
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+	// ȡַŰδУϣͻʱŰ
+	static const std::vector<GlyphQuad>& GetTextLayout(const std::string& text, const Ref<Font>& font, float kerning, float lineSpacing)
+	{
+		size_t hash = std::hash<std::string>()(text);
+		HashCombine(hash, std::hash<const Font*>()(font.get()));
+		HashCombine(hash, std::hash<float>()(kerning));
+		HashCombine(hash, std::hash<float>()(lineSpacing));
+
+		Renderer2DData::TextLayout& layout = s_Data.TextLayouts[hash];
+		if (layout.FontAsset != font || layout.Text != text || layout.Kerning != kerning || layout.LineSpacing != lineSpacing)
 		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
+			layout.FontAsset = font;
+			layout.Text = text;
+			layout.Kerning = kerning;
+			layout.LineSpacing = lineSpacing;
+			layout.Quads.clear();
+			font->Layout(text, kerning, lineSpacing, layout.Quads);
+		}
+		layout.LastUsedFrame = s_Data.FrameIndex;
+		return layout.Quads;
+	}
+
+	void Renderer2D::DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color, float kerning, float lineSpacing, int entityID)
+	{
+		if (text.empty() || !font || !font->IsLoaded())
+			return;
+
+		const std::vector<GlyphQuad>& quads = GetTextLayout(text, font, kerning, lineSpacing);
+		const Ref<Texture2D>& atlas = font->GetAtlasTexture();
+		uint32_t packedColor = glm::packUnorm4x8(color);
+		for (const GlyphQuad& quad : quads)
+		{
+			// ͼʱˢ
+			if (s_Data.TextIndexCount >= s_Data.TextIndexLimit || (s_Data.FontAtlasTexture && s_Data.FontAtlasTexture != atlas))
+				NextBatch();
+			if (!s_Data.TextVertexBufferBase)
 			{
-				textureIndex = (float)i;
-				break;
+				uint32_t glyphs = 0;
+				s_Data.TextVertexBufferBase = (TextVertex*)MapStream(s_Data.TextVB, Quad::GetVertexCount() * sizeof(TextVertex), Renderer2DData::MaxQuads, glyphs);
+				s_Data.TextVertexBufferPtr = s_Data.TextVertexBufferBase;
+				s_Data.TextIndexLimit = glyphs * Quad::GetIndexCount();
 			}
+			s_Data.FontAtlasTexture = atlas;
+
+			glm::vec2 texCoords[4];
+			RectToTexCoords(quad.TexRect, texCoords);
+			const glm::vec4 corners[4] = {
+				{ quad.Plane.x, quad.Plane.y, 0.0f, 1.0f },
+				{ quad.Plane.z, quad.Plane.y, 0.0f, 1.0f },
+				{ quad.Plane.z, quad.Plane.w, 0.0f, 1.0f },
+				{ quad.Plane.x, quad.Plane.w, 0.0f, 1.0f }
+			};
+			for (uint32_t i = 0; i < Quad::GetVertexCount(); i++)
+			{
+				TextVertex& vertex = *s_Data.TextVertexBufferPtr++;
+				vertex.Position = transform * corners[i];
+				vertex.Color = packedColor;
+				vertex.TexCoord = texCoords[i];
+				vertex.EntityID = entityID;
+			}
+			s_Data.TextIndexCount += Quad::GetIndexCount();
 		}
 
-		// δУµλ
-		if (textureIndex == 0.0f)
+		uint32_t glyphCount = (uint32_t)quads.size();
+		s_Data.Stats.GeometryCount += glyphCount;
+		s_Data.Stats.VertexCount += glyphCount * Quad::GetVertexCount();
+		s_Data.Stats.IndexCount += glyphCount * Quad::GetIndexCount();
+	}
+
+	// ڵǰԤһıεдλãΪ4㣬ʵΪ1ʵʱ nullptr
+	static void* ReserveQuad()
+	{
+		void* destination;
+		if (s_Data.Submission == Renderer2D::QuadSubmission::Instanced)
 		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
-				NextBatch();
+			if (s_Data.QuadInstanceCount >= s_Data.QuadInstanceLimit)
+				return nullptr;
+			if (!s_Data.QuadInstanceBufferBase)
+			{
+				s_Data.QuadInstanceBufferBase = (QuadInstance*)MapStream(s_Data.QuadInstanceVB, sizeof(QuadInstance), Renderer2DData::MaxQuads, s_Data.QuadInstanceLimit);
+				s_Data.QuadInstanceBufferPtr = s_Data.QuadInstanceBufferBase;
+			}
 
-			textureIndex = (float)s_Data.TextureSlotIndex; // һ
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
+			destination = s_Data.QuadInstanceBufferPtr++;
+			s_Data.QuadInstanceCount++;
+			s_Data.Stats.InstanceCount++;
 		}
-		
-		for (size_t i = 0; i < Quad::GetVertexCount(); i++)
+		else
 		{
-			s_Data.QuadVertexBufferPtr->Position = transform * Quad::GetVertices()[i];
-			s_Data.QuadVertexBufferPtr->Color = tintColor;
-			s_Data.QuadVertexBufferPtr->TexCoord = Quad::GetTextureCoords()[i];
-			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-			s_Data.QuadVertexBufferPtr->EntityID = entityID;
-			s_Data.QuadVertexBufferPtr++;
+			if (s_Data.QuadIndexCount >= s_Data.QuadIndexLimit)
+				return nullptr;
+			if (!IsQuadVertexStreamMapped())
+				MapQuadVertices();
+
+			if (s_Data.Format == VertexFormat::Compact)
+			{
+				destination = s_Data.CompactVertexBufferPtr;
+				s_Data.CompactVertexBufferPtr += Quad::GetVertexCount();
+			}
+			else
+			{
+				destination = s_Data.QuadVertexBufferPtr;
+				s_Data.QuadVertexBufferPtr += Quad::GetVertexCount();
+			}
+			s_Data.QuadIndexCount += Quad::GetIndexCount();
 		}
 
-		s_Data.QuadIndexCount += Quad::GetIndexCount();
 		s_Data.Stats.VertexCount += Quad::GetVertexCount();
 		s_Data.Stats.IndexCount += Quad::GetIndexCount();
 		s_Data.Stats.GeometryCount++;
+		return destination;
+	}
+
+	// ıд ReserveQuad Ԥλã״̬ڹ߳е
+	static void WriteQuad(void* destination, const glm::mat4& transform, const glm::vec4& color, float textureIndex, float tilingFactor, int entityID, const glm::vec2* texCoords)
+	{
+		if (s_Data.Submission == Renderer2D::QuadSubmission::Instanced)
+		{
+			QuadInstance* instance = (QuadInstance*)destination;
+			instance->TransformX = transform[0];
+			instance->TransformY = transform[1];
+			instance->Translation = transform[3];
+			instance->Color = glm::packUnorm4x8(color);
+			instance->TexIndex = (int)textureIndex;
+			instance->TilingFactor = tilingFactor;
+			instance->EntityID = entityID;
+			instance->TexRect = { texCoords[0], texCoords[2] };
+		}
+		else if (s_Data.Format == VertexFormat::Compact)
+		{
+			BatchTransform::TransformCompact((CompactVertex*)destination, transform,
+				Quad::GetVertices().data(), texCoords, Quad::GetVertexCount(),
+				color, textureIndex, tilingFactor, entityID);
+		}
+		else
+		{
+			BatchTransform::Transform((BatchVertex*)destination, transform,
+				Quad::GetVertices().data(), texCoords, Quad::GetVertexCount(),
+				color, textureIndex, tilingFactor, entityID);
+		}
+	}
+
+	void Renderer2D::SubmitQuad(const glm::mat4& transform, const glm::vec4& color, float textureIndex, float tilingFactor, int entityID, const glm::vec2* texCoords)
+	{
+		void* destination = ReserveQuad();
+		if (!destination)
+		{
+			NextBatch();
+			destination = ReserveQuad();
+		}
+		WriteQuad(destination, transform, color, textureIndex, tilingFactor, entityID, texCoords);
+	}
+
+	// ߳ȷдλúľ飬ȴ߳д
+	struct PendingQuad
+	{
+		void* Destination;
+		const glm::vec2* TexCoords;
+		float TextureIndex;
+		float TilingFactor;
+	};
+	static std::vector<PendingQuad> s_PendingQuads;
+
+	// д [begin, end) ľ飬дЩݲύ
+	static void WritePendingQuads(const SpriteDrawPacket* packets, uint32_t begin, uint32_t end)
+	{
+		ThreadPool::ParallelFor(end - begin, 256, [packets, begin](uint32_t first, uint32_t last)
+		{
+			for (uint32_t i = begin + first; i < begin + last; i++)
+			{
+				const PendingQuad& pending = s_PendingQuads[i];
+				WriteQuad(pending.Destination, packets[i].Transform, packets[i].Sprite->Color,
+					pending.TextureIndex, pending.TilingFactor, packets[i].EntityID, pending.TexCoords);
+			}
+			// ʽ洢ֻڱ߳򣬽߳ǰ
+			BatchTransform::Fence();
+		});
+	}
+
+	void Renderer2D::DrawSprites(const SpriteDrawPacket* packets, uint32_t count)
+	{
+		// ӳģʽֻ¼
+		if (s_Data.Recording)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				DrawSprite(packets[i].Transform, *packets[i].Sprite, packets[i].EntityID);
+			return;
+		}
+
+		// ̰߳ύ˳λԤдλãα߽һȷɽ߳
+		s_PendingQuads.resize(count);
+		uint32_t begin = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const SpriteRendererComponent& sprite = *packets[i].Sprite;
+			PendingQuad& pending = s_PendingQuads[i];
+			pending.TexCoords = Quad::GetTextureCoords().data();
+			pending.TextureIndex = 0.0f; // White Texture
+			pending.TilingFactor = 1.0f;
+
+			while (true)
+			{
+				if (sprite.Texture)
+				{
+					const Ref<Texture2D>* texture = &sprite.Texture;
+					pending.TexCoords = Quad::GetTextureCoords().data();
+					if (sprite.TilingFactor == 1.0f)
+					{
+						const Ref<SubTexture2D>& subTexture = TextureAtlas::Get(sprite.Texture);
+						if (subTexture)
+						{
+							texture = &subTexture->GetTexture();
+							pending.TexCoords = subTexture->GetTexCoords();
+						}
+					}
+
+					int32_t slot = s_Data.Backend == TextureBackend::Arrays ? s_Data.TextureArrays.FindOrAdd(*texture) : s_Data.TextureSlots.FindOrAdd(*texture);
+					pending.TextureIndex = (float)slot;
+					pending.TilingFactor = sprite.TilingFactor;
+					if (slot >= 0 && (pending.Destination = ReserveQuad()) != nullptr)
+						break;
+				}
+				else if ((pending.Destination = ReserveQuad()) != nullptr)
+					break;
+
+				// λдһٿʼ
+				WritePendingQuads(packets, begin, i);
+				NextBatch();
+				begin = i;
+			}
+		}
+		WritePendingQuads(packets, begin, count);
 	}
 
 	//------------------------------------------------- Rotated Quad --------------------------------------------------------------
@@ -278,20 +1137,160 @@ namespace Hazel
 		DrawQuad(transform, texture, tilingFactor, tintColor);
 	}
 
-	void Renderer2D::DrawSprite(const glm::mat4& transform, SpriteRendererComponent& src, int entityID)
+	void Renderer2D::DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& src, int entityID)
 	{
 		if (src.Texture)
+		{
+			// ƽ̵ľȲͼϲΪһţδϺ
+			if (src.TilingFactor == 1.0f)
+			{
+				const Ref<SubTexture2D>& subTexture = TextureAtlas::Get(src.Texture);
+				if (subTexture)
+				{
+					DrawQuad(transform, subTexture, src.TilingFactor, src.Color, entityID);
+					return;
+				}
+			}
 			DrawQuad(transform, src.Texture, src.TilingFactor, src.Color, entityID);
+		}
 		else
 			DrawQuad(transform, src.Color, entityID);
 	}
 
+	// ȷ仯Ҳ޸ģҪʱؽ㣬Ȼóפ
+	static void CloseStaticChunk(StaticSpriteChunk& chunk, uint32_t quadCount)
+	{
+		if (chunk.Sprites.size() != quadCount)
+		{
+			chunk.Sprites.resize(quadCount);
+			chunk.Dirty = true;
+		}
+
+		if (chunk.Dirty)
+		{
+			chunk.Textures.clear();
+			for (uint32_t i = 1; i < s_Data.StaticSlots.GetCount(); i++)
+				chunk.Textures.push_back(s_Data.StaticSlots.GetSlot(i));
+
+			s_Data.StaticVertices.resize(quadCount * Quad::GetVertexCount());
+			QuadVertex* vertices = s_Data.StaticVertices.data();
+			for (const StaticSpriteChunk::Sprite& sprite : chunk.Sprites)
+			{
+				glm::vec2 texCoords[4];
+				RectToTexCoords(sprite.TexRect, texCoords);
+				BatchTransform::Transform((BatchVertex*)vertices, sprite.Transform,
+					Quad::GetVertices().data(), texCoords, Quad::GetVertexCount(),
+					sprite.Color, sprite.TextureIndex, sprite.TilingFactor, sprite.EntityID);
+				vertices += Quad::GetVertexCount();
+			}
+			BatchTransform::Fence();
+
+			uint32_t dataSize = quadCount * Quad::GetVertexCount() * sizeof(QuadVertex);
+			chunk.VB->SetData(s_Data.StaticVertices.data(), dataSize);
+			chunk.Dirty = false;
+			s_Data.Stats.UploadBytes += dataSize;
+			s_Data.Stats.RetainedRebuilds++;
+		}
+
+		s_Data.WhiteTexture->Bind(0);
+		for (uint32_t i = 0; i < (uint32_t)chunk.Textures.size(); i++)
+			chunk.Textures[i]->Bind(i + 1);
+		s_Data.TextureShader->Bind();
+		RenderCommand::DrawIndexed(chunk.VA, quadCount * Quad::GetIndexCount());
+
+		s_Data.Stats.DrawCalls++;
+		s_Data.Stats.TextureBinds += (uint32_t)chunk.Textures.size() + 1;
+		s_Data.Stats.RetainedQuads += quadCount;
+		s_Data.Stats.GeometryCount += quadCount;
+		s_Data.Stats.VertexCount += quadCount * Quad::GetVertexCount();
+		s_Data.Stats.IndexCount += quadCount * Quad::GetIndexCount();
+	}
+
+	void Renderer2D::DrawStaticSprites(const SpriteDrawPacket* packets, uint32_t count)
+	{
+		std::vector<StaticSpriteChunk>& chunks = s_Data.StaticChunks;
+		uint32_t chunkIndex = 0;
+		uint32_t quadCount = 0;
+		s_Data.StaticSlots.Reset();
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const SpriteRendererComponent& src = *packets[i].Sprite;
+
+			StaticSpriteChunk::Sprite sprite;
+			sprite.Transform = packets[i].Transform;
+			sprite.Color = src.Color;
+			sprite.TexRect = FullTexRect;
+			sprite.Texture = nullptr;
+			sprite.TilingFactor = 1.0f;
+			sprite.EntityID = packets[i].EntityID;
+
+			const Ref<Texture2D>* texture = nullptr;
+			if (src.Texture)
+			{
+				texture = &src.Texture;
+				sprite.TilingFactor = src.TilingFactor;
+				if (src.TilingFactor == 1.0f)
+				{
+					const Ref<SubTexture2D>& subTexture = TextureAtlas::Get(src.Texture);
+					if (subTexture)
+					{
+						texture = &subTexture->GetTexture();
+						sprite.TexRect = subTexture->GetTexRect();
+					}
+				}
+				sprite.Texture = texture->get();
+			}
+
+			// λʱʼһ
+			int32_t slot = texture ? s_Data.StaticSlots.FindOrAdd(*texture) : 0;
+			if (slot < 0 || quadCount == StaticSpriteChunk::MaxQuads)
+			{
+				CloseStaticChunk(chunks[chunkIndex++], quadCount);
+				quadCount = 0;
+				s_Data.StaticSlots.Reset();
+				slot = texture ? s_Data.StaticSlots.FindOrAdd(*texture) : 0;
+			}
+			sprite.TextureIndex = (float)slot;
+
+			if (chunkIndex == chunks.size())
+			{
+				StaticSpriteChunk chunk;
+				chunk.VB = VertexBuffer::Create(StaticSpriteChunk::MaxQuads * Quad::GetVertexCount() * sizeof(QuadVertex));
+				chunk.VB->SetLayout(s_Data.QuadLayout);
+				chunk.VA = VertexArray::Create();
+				chunk.VA->SetIndexBuffer(s_Data.QuadIB);
+				chunk.VA->AddVertexBuffer(chunk.VB);
+				chunk.VA->Unbind();
+				chunks.push_back(std::move(chunk));
+			}
+
+			// һ֡ͬһλõľȽϣͬҪؽ
+			StaticSpriteChunk& chunk = chunks[chunkIndex];
+			if (quadCount < chunk.Sprites.size())
+			{
+				if (!(chunk.Sprites[quadCount] == sprite))
+				{
+					chunk.Sprites[quadCount] = sprite;
+					chunk.Dirty = true;
+				}
+			}
+			else
+			{
+				chunk.Sprites.push_back(sprite);
+				chunk.Dirty = true;
+			}
+			quadCount++;
+		}
+
+		if (quadCount)
+			CloseStaticChunk(chunks[chunkIndex++], quadCount);
+		chunks.erase(chunks.begin() + chunkIndex, chunks.end());
+	}
+
 	void Renderer2D::ResetStats()
 	{
-		s_Data.Stats.DrawCalls = 0;
-		s_Data.Stats.GeometryCount = 0;
-		s_Data.Stats.VertexCount = 0;
-		s_Data.Stats.IndexCount = 0;
+		s_Data.Stats = RenderStats();
 	}
 
 	RenderStats* Renderer2D::GetStats()
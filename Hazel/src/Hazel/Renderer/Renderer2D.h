@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/SubTexture2D.h"
+#include "Hazel/Renderer/Font.h"
+#include "Hazel/Renderer/Geometry/Geometry.h"
 #include "Hazel/Renderer/EditorCamera.h"
 
 #include "Hazel/Scene/Components.h"
@@ -9,8 +12,48 @@ namespace Hazel
 {
 	class Renderer;
 	class RenderStats;
+
+	// һξƣ DrawSprites ǰЧ
+	struct SpriteDrawPacket
+	{
+		glm::mat4 Transform;
+		const SpriteRendererComponent* Sprite;
+		int EntityID;
+	};
+
 	class Renderer2D
 	{
+	public:
+		// Batched: ÿıCPUչΪ4㣻Instanced: ÿıһʵݣGPUչ
+		enum class QuadSubmission
+		{
+			Batched = 0, Instanced = 1
+		};
+
+		static void SetQuadSubmission(QuadSubmission submission);
+		static QuadSubmission GetQuadSubmission();
+
+		// Slots: ÿ32Arrays: ͬߴϲ飬λֻܶ
+		enum class TextureBackend
+		{
+			Slots = 0, Arrays = 1
+		};
+
+		static void SetTextureBackend(TextureBackend backend);
+		static TextureBackend GetTextureBackend();
+
+		// Immediate: ύ˳ֱӺDeferred: ȼ¼EndScene ʱٺ
+		enum class SortMode
+		{
+			Immediate = 0, Deferred = 1
+		};
+
+		static void SetSortMode(SortMode mode);
+		static SortMode GetSortMode();
+
+		// ·ĶʽCompact ԼΪ Standard ϴһ룻ڳ֮л
+		static void SetVertexFormat(VertexFormat format);
+		static VertexFormat GetVertexFormat();
 	private:
 		static void Init();
 		static void Shutdown();
@@ -18,7 +61,10 @@ namespace Hazel
 		static void BeginScene(const Camera& camera, const glm::mat4& transform);
 		static void BeginScene(const EditorCamera& camera);
 		static void EndScene();
+		// ÿ֡ʱһΣʽΪ֡դһ֡һ
+		static void EndFrame();
 		static void Flush();
+		static void FlushQuads();
 
 		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
@@ -26,11 +72,24 @@ namespace Hazel
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
 		static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
+		static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subTexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
-		static void DrawSprite(const glm::mat4& transform, SpriteRendererComponent& src, int entityID);
+		static void DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& src, int entityID);
+		// ύ飬̳߳زɣ DrawSprite ͬ
+		static void DrawSprites(const SpriteDrawPacket* packets, uint32_t count);
+		// ύ̬飺˳зΪפ飬ֻݱ仯ɲϴ
+		static void DrawStaticSprites(const SpriteDrawPacket* packets, uint32_t count);
+
+		// Բ߶θжΣıεthickness Ϊ 1 ʱʵԲ
+		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f, int entityID = -1);
+		static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID = -1);
+		// λıξ transform 任
+		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
+		// ʹöΣͬһַŰ֡棬ַʱŰ
+		static void DrawString(const std::string& text, const Ref<Font>& font, const glm::mat4& transform, const glm::vec4& color, float kerning = 0.0f, float lineSpacing = 0.0f, int entityID = -1);
 
 		static void ResetStats();
 		static RenderStats* GetStats();
@@ -38,6 +97,13 @@ namespace Hazel
 		static void StartBatch();
 		static void NextBatch();
 
+		static void RecordQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec4& texRect, bool translucent, float tilingFactor, const glm::vec4& color, int entityID);
+		static void ReplayQuads();
+
+		static float GetTextureIndex(const Ref<Texture2D>& texture);
+		static void SubmitTexturedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec2* texCoords, float tilingFactor, const glm::vec4& tintColor, int entityID);
+		static void SubmitQuad(const glm::mat4& transform, const glm::vec4& color, float textureIndex, float tilingFactor, int entityID, const glm::vec2* texCoords);
+
 		friend Renderer;
 	};
 }
\ No newline at end of file
@@ -1,31 +1,82 @@
 #include "hzpch.h"
 #include "Renderer3D.h"
 
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Core/ThreadPool.h"
 #include "Hazel/Renderer/VertexArray.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/RenderCommand.h"
 #include "Hazel/Renderer/RenderStats.h"
+#include "Hazel/Renderer/BatchTransform.h"
+#include "Hazel/Renderer/MeshPool.h"
+#include "Hazel/Renderer/SampleQuery.h"
+#include "Hazel/Renderer/TextureSlotTable.h"
 #include "Hazel/Renderer/Geometry/Cube.h"
 #include "Hazel/Renderer/Geometry/Sphere.h"
 #include "Hazel/Renderer/Geometry/Geometry.h"
+#include "Hazel/Math/RadixSort.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <chrono>
 
 namespace Hazel
 {
 	struct RendererBatchData
 	{
 		Ref<VertexArray> VAO;
-		Ref<VertexBuffer> VBO;
+		Ref<StreamingVertexBuffer> VBO;
 		Ref<IndexBuffer> IBO;
 
+		uint32_t MaxVertices = 0; // ÿĶʽһĴС
+		uint32_t MaxIndices = 0;
+
 		uint32_t IndexCount = 0;
-		BatchVertex* VertexBufferBase = nullptr; // ָʼ
+		uint32_t IndexLimit = 0;  // εӳΪʣռɵ
+		uint32_t BaseVertex = 0;  // Flush ʱһڶеʼ
+		BatchVertex* VertexBufferBase = nullptr; // ָʼָʽӳڴ棬εһдʱӳ䣩
 		BatchVertex* VertexBufferPtr = nullptr; // ƶĶָ
+
+		// նʽ׼ʽ
+		Ref<VertexArray> CompactVAO;
+		Ref<StreamingVertexBuffer> CompactVBO;
+		CompactVertex* CompactVertexBufferBase = nullptr;
+		CompactVertex* CompactVertexBufferPtr = nullptr;
 	};
 
 	static std::unordered_map<MeshFilterComponent::GeometryType, RendererBatchData> s_BatchDataMap;
+
+	static_assert(sizeof(MeshInstance) == 64, "MeshInstance must stay tightly packed");
+
+	// ʵһͬʵFlush ʱӦһӻ
+	struct InstanceRun
+	{
+		MeshAllocation Mesh;
+		uint32_t FirstInstance;
+		uint32_t InstanceCount;
+	};
+
+	// GPU޳ȡÿʵϢstd43048ֽڣ
+	struct CullRun
+	{
+		glm::vec4 BoundsMin; // ģͿռΧУw δʹ
+		glm::vec4 BoundsMax;
+		uint32_t FirstInstance;
+		uint32_t InstanceCount;
+		uint32_t Padding[2];
+	};
+	static_assert(sizeof(CullRun) == 48, "CullRun must match the std430 layout in CullInstances.glsl");
+
+	// һʹʱύһ޳ٴдǰդɣضɼ
+	struct CullReadback
+	{
+		uint32_t CommandOffset = 0; // ڵֽƫ
+		uint32_t DrawCount = 0;
+		uint32_t InstanceCount = 0;
+	};
+
 	struct Renderer3DData
 	{
 		static constexpr uint32_t MaxCubes = 100;
@@ -34,23 +85,114 @@ namespace Hazel
 		static constexpr uint32_t MaxSpheres = 50;
 		static constexpr uint32_t MaxSphereVertices = MaxSpheres * Sphere::GetVertexCount();
 		static constexpr uint32_t MaxSphereIndices = MaxSpheres * Sphere::GetIndexCount();
-		static constexpr uint32_t MaxTextureSlots = 32;
+		static constexpr uint32_t MaxTextureSlots = TextureSlotTable::MaxSlots;
+		static constexpr uint32_t MaxInstances = 16384; // ÿʵʵÿ 1MB
 
 		Ref<Shader> TextureShader;
+		Ref<Shader> InstanceShader;
+		Ref<Shader> CullShader;
+		Ref<Shader> DepthShader;		 // ԤȾֻλ
+		Ref<Shader> DepthInstanceShader;
+		// ÿ Flush Ҫõ uniformʼʱȡⰴֲ
+		UniformHandle<int> TextureOverdrawView;
+		UniformHandle<int> InstanceOverdrawView;
+		UniformHandle<int> CullInstanceCount;
+		UniformHandle<int> CullRunCount;
+		std::array<UniformHandle<glm::vec4>, 6> CullPlanes;
 		Ref<Texture2D> WhiteTexture;
 
-		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
-		uint32_t TextureSlotIndex = 1;
+		TextureSlotTable TextureSlots;
+		VertexFormat Format = VertexFormat::Standard;
+		Renderer3D::MeshSubmission Submission = Renderer3D::MeshSubmission::Instanced;
+
+		Ref<StreamingVertexBuffer> InstanceVB;
+		uint32_t InstanceCount = 0;
+		uint32_t InstanceLimit = MaxInstances;
+		MeshInstance* InstanceBufferBase = nullptr;
+		MeshInstance* InstanceBufferPtr = nullptr;
+		std::vector<InstanceRun> InstanceRuns;
+
+		// صĶ/ʵ壬ãݺؽ
+		Ref<VertexArray> MeshVAO;
+		uint32_t MeshVAOGeneration = 0;
+		Ref<StreamingVertexBuffer> IndirectBuffer; // ÿ֡ DrawElementsIndirectCommand 
+
+		// GPU޳ɫͨ׶Եʵνд CulledInstanceVBԭۼӸʵ
+		bool GPUCulling = true;
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		Ref<VertexBuffer> CulledInstanceVB; // ֻGPUд
+		Ref<VertexBuffer> CullRunBuffer;
+		Ref<VertexArray> CulledMeshVAO;
+		uint32_t CulledMeshVAOGeneration = 0;
+		std::vector<CullRun> CullRuns;
+		std::vector<std::vector<CullReadback>> CullReadbacks; // 
+
+		// LOD ѡProjectionScale ΪͶӰ [1][1]͸ʱ 1/tan(fov/2)
+		bool LODEnabled = true;
+		float ProjectionScale = 1.0f;
+
+		// ͸УDrawMeshes ʱͼɽԶٷ/ʵ
+		bool FrontToBackSorting = true;
+		std::vector<MeshDrawPacket> OpaqueQueue;
+		std::vector<uint64_t> SortKeys, SortTmpKeys;
+		std::vector<uint32_t> SortValues, SortTmpValues;
+		std::vector<uint32_t> SortGroups;
+
+		// ԤȾֻдȣɫͨ Equal ȲԣÿֻɫǰƬԪ
+		bool DepthPrepass = false;
+		std::vector<RendererBatchData*> FlushBatches; //  Flush ҪƵΣͨ
+
+		// Ȼͼɫ̶ͨɫӻϣѯͳɫƬԪ
+		bool OverdrawView = false;
+		std::vector<Ref<SampleQuery>> PendingQueries; // ύ˳
+		std::vector<Ref<SampleQuery>> FreeQueries;
 
 		RenderStats Stats;
+		std::chrono::high_resolution_clock::time_point SceneBeginTime;
 	};
 	static Renderer3DData s_Data;
 
+	static void CreateCompactBuffers(RendererBatchData& data)
+	{
+		data.CompactVBO = StreamingVertexBuffer::Create(data.MaxVertices * sizeof(CompactVertex));
+		data.CompactVBO->SetLayout({
+			{ShaderDataType::Float3, "a_Position"},
+			{ShaderDataType::UByte4, "a_Color", true},
+			{ShaderDataType::Half2, "a_TexCoord"},
+			{ShaderDataType::UShort, "a_TexIndex"},
+			{ShaderDataType::Half, "a_TilingFactor"},
+			{ShaderDataType::Int, "a_EntityID"}
+		});
+
+		data.CompactVAO = VertexArray::Create();
+		data.CompactVAO->SetIndexBuffer(data.IBO);
+		data.CompactVAO->AddVertexBuffer(data.CompactVBO);
+		data.CompactVAO->Unbind();
+	}
+
+	// εEBOŻģƫظΣ 65536 ʱ 16 λ
+	static Ref<IndexBuffer> CreateBatchIndexBuffer(const Ref<Mesh>& mesh, uint32_t maxIndices, uint32_t maxVertices)
+	{
+		const std::vector<uint32_t>& meshIndices = mesh->GetIndices();
+		const uint32_t vertexCount = (uint32_t)mesh->GetVertexCount();
+
+		std::vector<uint32_t> indices(maxIndices);
+		uint32_t baseVertex = 0;
+		for (uint32_t i = 0; i + meshIndices.size() <= maxIndices; i += (uint32_t)meshIndices.size(), baseVertex += vertexCount)
+		{
+			for (size_t j = 0; j < meshIndices.size(); j++)
+				indices[i + j] = meshIndices[j] + baseVertex;
+		}
+		return IndexBuffer::Create(indices.data(), maxIndices, maxVertices <= 65536 ? IndexFormat::UInt16 : IndexFormat::UInt32);
+	}
+
 	void Renderer3D::Init()
 	{
 		// 
 		RendererBatchData cubeData;
-		cubeData.VBO = VertexBuffer::Create(s_Data.MaxCubeVertices * sizeof(CubeVertex));
+		cubeData.VBO = StreamingVertexBuffer::Create(s_Data.MaxCubeVertices * sizeof(CubeVertex));
+		cubeData.MaxVertices = s_Data.MaxCubeVertices;
+		cubeData.MaxIndices = s_Data.MaxCubeIndices;
 		BufferLayout cubeLayout =
 		{
 			{ShaderDataType::Float3, "a_Position"},
@@ -62,121 +204,495 @@ namespace Hazel
 		};
 		cubeData.VBO->SetLayout(cubeLayout);
 
-		// EBO
-		uint32_t* cubeIndices = new uint32_t[s_Data.MaxCubeIndices];
-		std::vector<uint32_t> indices = Cube::GetIndices();
-		for (uint32_t i = 0; i < s_Data.MaxCubeIndices; i += Cube::GetIndexCount())
-		{
-			memcpy(cubeIndices + i, indices.data(), indices.size() * sizeof(uint32_t));
-			for (int j = 0; j < Cube::GetIndexCount(); j++)
-				indices[j] += Cube::GetVertexCount();
-		}
-		cubeData.IBO = IndexBuffer::Create(cubeIndices, s_Data.MaxCubeIndices);
-		delete[] cubeIndices;
+		cubeData.IBO = CreateBatchIndexBuffer(MeshLibrary::GetCubeMesh(), s_Data.MaxCubeIndices, s_Data.MaxCubeVertices);
 
 		cubeData.VAO = VertexArray::Create();
 		cubeData.VAO->SetIndexBuffer(cubeData.IBO);
 		cubeData.VAO->AddVertexBuffer(cubeData.VBO);
 		cubeData.VAO->Unbind();
-		cubeData.VertexBufferBase = new BatchVertex[s_Data.MaxCubeVertices]; //ָʼλ
+		CreateCompactBuffers(cubeData);
 		s_BatchDataMap[MeshFilterComponent::GeometryType::Cube] = cubeData;
 
 		// 
 		RendererBatchData sphereData;
-		sphereData.VBO = VertexBuffer::Create(s_Data.MaxSphereVertices * sizeof(SphereVertex));
+		sphereData.VBO = StreamingVertexBuffer::Create(s_Data.MaxSphereVertices * sizeof(SphereVertex));
+		sphereData.MaxVertices = s_Data.MaxSphereVertices;
+		sphereData.MaxIndices = s_Data.MaxSphereIndices;
 		sphereData.VBO->SetLayout(cubeLayout);
 
-		// EBO
-		uint32_t* sphereIndices = new uint32_t[s_Data.MaxSphereIndices];
-		indices = Sphere::GetIndices();
-		for (uint32_t i = 0; i < s_Data.MaxSphereIndices; i += Sphere::GetIndexCount())
-		{
-			memcpy(sphereIndices + i, indices.data(), indices.size() * sizeof(uint32_t));
-			for (int j = 0; j < Sphere::GetIndexCount(); j++)
-				indices[j] += Sphere::GetVertexCount();
-		}
-		sphereData.IBO = IndexBuffer::Create(sphereIndices, s_Data.MaxSphereIndices);
-		delete[] sphereIndices;
+		sphereData.IBO = CreateBatchIndexBuffer(MeshLibrary::GetSphereMesh(), s_Data.MaxSphereIndices, s_Data.MaxSphereVertices);
 
 		sphereData.VAO = VertexArray::Create();
 		sphereData.VAO->SetIndexBuffer(sphereData.IBO);
 		sphereData.VAO->AddVertexBuffer(sphereData.VBO);
 		//sphereData.VAO->Unbind();
-		sphereData.VertexBufferBase = new BatchVertex[s_Data.MaxSphereVertices]; //ָʼλ
+		CreateCompactBuffers(sphereData);
 		s_BatchDataMap[MeshFilterComponent::GeometryType::Sphere] = sphereData;
 
+		// ʵ壺ãصĻͬһ
+		s_Data.InstanceVB = StreamingVertexBuffer::Create(s_Data.MaxInstances * sizeof(MeshInstance));
+		BufferLayout instanceLayout =
+		{
+			{ShaderDataType::Float3, "a_TransformX"},
+			{ShaderDataType::Float3, "a_TransformY"},
+			{ShaderDataType::Float3, "a_TransformZ"},
+			{ShaderDataType::Float3, "a_Translation"},
+			{ShaderDataType::Int, "a_Color"},
+			{ShaderDataType::Int, "a_TexIndex"},
+			{ShaderDataType::Float, "a_TilingFactor"},
+			{ShaderDataType::Int, "a_EntityID"}
+		};
+		instanceLayout.SetDivisor(1);
+		s_Data.InstanceVB->SetLayout(instanceLayout);
+
+		// ÿͬʵһGPU޳дʵCPUضӳɶ
+		const uint32_t indirectRegionCount = 3;
+		s_Data.IndirectBuffer = StreamingVertexBuffer::Create(s_Data.MaxInstances * sizeof(DrawElementsIndirectCommand), indirectRegionCount, true);
+		s_Data.CullReadbacks.resize(indirectRegionCount);
+
+		s_Data.CulledInstanceVB = VertexBuffer::Create(s_Data.MaxInstances * sizeof(MeshInstance));
+		s_Data.CulledInstanceVB->SetLayout(instanceLayout);
+		s_Data.CullRunBuffer = VertexBuffer::Create(s_Data.MaxInstances * sizeof(CullRun));
+
 		// 
 		int32_t samplers[s_Data.MaxTextureSlots];
 		for (uint32_t i = 0; i < s_Data.MaxTextureSlots; i++)
 			samplers[i] = i;
 
 		// Shader
+		// ȫύ룬ֲ֧бʱͬʱ uniform ʱֻȴӦɫ
 		if (ShaderLibrary::Exists("Texture"))
 			s_Data.TextureShader = ShaderLibrary::Get("Texture");
 		else
 			s_Data.TextureShader = ShaderLibrary::Load("assets/shaders/Texture.glsl");
+
+		if (ShaderLibrary::Exists("MeshInstanced"))
+			s_Data.InstanceShader = ShaderLibrary::Get("MeshInstanced");
+		else
+			s_Data.InstanceShader = ShaderLibrary::Load("assets/shaders/MeshInstanced.glsl");
+
+		if (ShaderLibrary::Exists("CullInstances"))
+			s_Data.CullShader = ShaderLibrary::Get("CullInstances");
+		else
+			s_Data.CullShader = ShaderLibrary::Load("assets/shaders/CullInstances.glsl");
+
+		if (ShaderLibrary::Exists("DepthPrepass"))
+			s_Data.DepthShader = ShaderLibrary::Get("DepthPrepass");
+		else
+			s_Data.DepthShader = ShaderLibrary::Load("assets/shaders/DepthPrepass.glsl");
+
+		if (ShaderLibrary::Exists("DepthPrepassInstanced"))
+			s_Data.DepthInstanceShader = ShaderLibrary::Get("DepthPrepassInstanced");
+		else
+			s_Data.DepthInstanceShader = ShaderLibrary::Load("assets/shaders/DepthPrepassInstanced.glsl");
+
 		s_Data.TextureShader->Bind();
 		//ϴвӦԪ
 		s_Data.TextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
 
+		s_Data.InstanceShader->Bind();
+		s_Data.InstanceShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
+
+		s_Data.TextureOverdrawView = s_Data.TextureShader->GetUniform<int>("u_OverdrawView");
+		s_Data.InstanceOverdrawView = s_Data.InstanceShader->GetUniform<int>("u_OverdrawView");
+		s_Data.CullInstanceCount = s_Data.CullShader->GetUniform<int>("u_InstanceCount");
+		s_Data.CullRunCount = s_Data.CullShader->GetUniform<int>("u_RunCount");
+		for (uint32_t i = 0; i < s_Data.CullPlanes.size(); i++)
+			s_Data.CullPlanes[i] = s_Data.CullShader->GetUniform<glm::vec4>("u_Planes[" + std::to_string(i) + "]");
+
 		// Texture
 		s_Data.WhiteTexture = Texture2D::Create(1, 1);
 		uint32_t whiteTextureData = 0xffffffff;
 		s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
-		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+		s_Data.TextureSlots.SetWhiteTexture(s_Data.WhiteTexture);
 	}
 
 	void Renderer3D::Shutdown()
 	{
-		for (auto& [_, data] : s_BatchDataMap)
-			delete[] data.VertexBufferBase;
+		s_BatchDataMap.clear();
+		s_Data.InstanceRuns.clear();
+		s_Data.MeshVAO = nullptr;
+		s_Data.CulledMeshVAO = nullptr;
+		s_Data.IndirectBuffer = nullptr;
+		s_Data.CulledInstanceVB = nullptr;
+		s_Data.CullRunBuffer = nullptr;
+		s_Data.OpaqueQueue.clear();
+		s_Data.PendingQueries.clear();
+		s_Data.FreeQueries.clear();
+		MeshPool::Clear();
+	}
+
+	void Renderer3D::SetVertexFormat(VertexFormat format)
+	{
+		s_Data.Format = format;
+	}
+
+	VertexFormat Renderer3D::GetVertexFormat()
+	{
+		return s_Data.Format;
+	}
+
+	void Renderer3D::SetMeshSubmission(MeshSubmission submission)
+	{
+		s_Data.Submission = submission;
+	}
+
+	Renderer3D::MeshSubmission Renderer3D::GetMeshSubmission()
+	{
+		return s_Data.Submission;
+	}
+
+	void Renderer3D::SetGPUCulling(bool enabled)
+	{
+		s_Data.GPUCulling = enabled;
+	}
+
+	bool Renderer3D::IsGPUCullingEnabled()
+	{
+		return s_Data.GPUCulling;
+	}
+
+	void Renderer3D::SetLODEnabled(bool enabled)
+	{
+		s_Data.LODEnabled = enabled;
+	}
+
+	bool Renderer3D::IsLODEnabled()
+	{
+		return s_Data.LODEnabled;
+	}
+
+	void Renderer3D::SetFrontToBackSorting(bool enabled)
+	{
+		s_Data.FrontToBackSorting = enabled;
+	}
+
+	bool Renderer3D::IsFrontToBackSortingEnabled()
+	{
+		return s_Data.FrontToBackSorting;
+	}
+
+	void Renderer3D::SetDepthPrepass(bool enabled)
+	{
+		s_Data.DepthPrepass = enabled;
+	}
+
+	bool Renderer3D::IsDepthPrepassEnabled()
+	{
+		return s_Data.DepthPrepass;
+	}
+
+	void Renderer3D::SetOverdrawView(bool enabled)
+	{
+		s_Data.OverdrawView = enabled;
+	}
+
+	bool Renderer3D::IsOverdrawViewEnabled()
+	{
+		return s_Data.OverdrawView;
+	}
+
+	uint32_t Renderer3D::SelectLOD(const Mesh& mesh, const glm::mat4& transform, uint32_t currentLOD)
+	{
+		const std::vector<Mesh::LOD>& lods = mesh.GetLODs();
+		if (!s_Data.LODEnabled || lods.empty())
+			return 0;
+
+		// Χֱռӿڸ߶ȵır * P[1][1] / wͶӰʱ w Ϊ1
+		const Math::BoundingSphere& sphere = mesh.GetBoundingSphere();
+		glm::vec4 center = transform * glm::vec4(sphere.Center, 1.0f);
+		float scale = std::max(glm::length(glm::vec3(transform[0])), std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+		float radius = sphere.Radius * scale;
+		float w = (s_Data.ViewProjection * center).w;
+		if (w <= radius) // ڰΧ
+			return 0;
+		float screenSize = radius * s_Data.ProjectionScale / w;
+
+		// ͺ󣺱Сֵ (1 - h)ؾϸֵ (1 + h)ֵл
+		constexpr float hysteresis = 0.1f;
+		uint32_t level = 0;
+		for (uint32_t i = 1; i <= (uint32_t)lods.size(); i++)
+		{
+			float threshold = lods[i - 1].ScreenSize * (i <= currentLOD ? 1.0f + hysteresis : 1.0f - hysteresis);
+			if (screenSize < threshold)
+				level = i;
+		}
+		return level;
+	}
+
+	static void SetViewProjection(const glm::mat4& viewProjection)
+	{
+		s_Data.ViewProjection = viewProjection;
+		Renderer::SetCamera(viewProjection);
 	}
 
 	void Renderer3D::BeginScene(const Camera& camera, const glm::mat4& transform)
 	{
+		s_Data.SceneBeginTime = std::chrono::high_resolution_clock::now();
 		glm::mat4 viewProj = camera.GetProjection() * glm::inverse(transform);
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		SetViewProjection(viewProj);
+		s_Data.ProjectionScale = camera.GetProjection()[1][1];
 		StartBatch();
 	}
 
 	void Renderer3D::BeginScene(const EditorCamera& camera)
 	{
-		glm::mat4 viewProj = camera.GetViewProjection();
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		s_Data.SceneBeginTime = std::chrono::high_resolution_clock::now();
+		SetViewProjection(camera.GetViewProjection());
+		s_Data.ProjectionScale = camera.GetProjection()[1][1];
 		StartBatch();
 	}
 
 	void Renderer3D::EndScene()
 	{
 		Flush();
+
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - s_Data.SceneBeginTime;
+		s_Data.Stats.CPUTime += elapsed.count();
 	}
 
 	void Renderer3D::StartBatch()
 	{
+		// ʽεһдʱӳ䣬һûдĻ岻ỻҲȴ
 		for (auto& [_, data] : s_BatchDataMap)
 		{
 			data.IndexCount = 0; //ÿˢ£һȾҪƵҪ¿ʼ
-			data.VertexBufferPtr = data.VertexBufferBase; // ָ
+			data.IndexLimit = data.MaxIndices;
+			data.VertexBufferBase = data.VertexBufferPtr = nullptr;
+			data.CompactVertexBufferBase = data.CompactVertexBufferPtr = nullptr;
+		}
+		s_Data.InstanceCount = 0;
+		s_Data.InstanceLimit = Renderer3DData::MaxInstances;
+		s_Data.InstanceBufferBase = s_Data.InstanceBufferPtr = nullptr;
+		s_Data.InstanceRuns.clear();
+
+		s_Data.TextureSlots.Reset();
+	}
+
+	void Renderer3D::EndFrame()
+	{
+		for (auto& [_, data] : s_BatchDataMap)
+		{
+			data.VBO->EndFrame();
+			data.CompactVBO->EndFrame();
+		}
+		s_Data.InstanceVB->EndFrame();
+		s_Data.IndirectBuffer->EndFrame();
+	}
+
+	// صĶ/ + ָʵ壻ݺؽ
+	static const Ref<VertexArray>& GetMeshVertexArray(bool culled)
+	{
+		Ref<VertexArray>& vertexArray = culled ? s_Data.CulledMeshVAO : s_Data.MeshVAO;
+		uint32_t& generation = culled ? s_Data.CulledMeshVAOGeneration : s_Data.MeshVAOGeneration;
+		if (!vertexArray || generation != MeshPool::GetGeneration())
+		{
+			vertexArray = VertexArray::Create();
+			vertexArray->SetIndexBuffer(MeshPool::GetIndexBuffer());
+			vertexArray->AddVertexBuffer(MeshPool::GetVertexBuffer());
+			if (culled)
+				vertexArray->AddVertexBuffer(s_Data.CulledInstanceVB);
+			else
+				vertexArray->AddVertexBuffer(s_Data.InstanceVB);
+			vertexArray->Unbind();
+			generation = MeshPool::GetGeneration();
+		}
+		return vertexArray;
+	}
+
+	// դɣϴڸ޳ʵͳƱʵʻ֡
+	static void ReadBackCulling(uint32_t regionIndex, const uint8_t* region)
+	{
+		for (const CullReadback& readback : s_Data.CullReadbacks[regionIndex])
+		{
+			const DrawElementsIndirectCommand* commands = (const DrawElementsIndirectCommand*)(region + readback.CommandOffset);
+			uint32_t visible = 0;
+			for (uint32_t i = 0; i < readback.DrawCount; i++)
+				visible += commands[i].InstanceCount;
+			s_Data.Stats.SubmittedCount += visible;
+			s_Data.Stats.CulledCount += readback.InstanceCount - visible;
+		}
+		s_Data.CullReadbacks[regionIndex].clear();
+	}
+
+	// ɫ޳ǰεʵΪʵһݣΪ CulledInstanceVB ͸ʵ
+	static void DispatchCulling(uint32_t instanceOffset, uint32_t commandOffset, uint32_t drawCount)
+	{
+		s_Data.CullRuns.resize(drawCount);
+		for (uint32_t i = 0; i < drawCount; i++)
+		{
+			const InstanceRun& run = s_Data.InstanceRuns[i];
+			s_Data.CullRuns[i] = { glm::vec4(run.Mesh.Bounds.Min, 0.0f), glm::vec4(run.Mesh.Bounds.Max, 0.0f), run.FirstInstance, run.InstanceCount, {} };
+		}
+		uint32_t runBytes = drawCount * sizeof(CullRun);
+		s_Data.CullRunBuffer->SetSubData(s_Data.CullRuns.data(), runBytes, 0);
+		s_Data.Stats.UploadBytes += runBytes;
+
+		s_Data.CullShader->Bind();
+		s_Data.CullShader->Set(s_Data.CullInstanceCount, (int)s_Data.InstanceCount);
+		s_Data.CullShader->Set(s_Data.CullRunCount, (int)drawCount);
+		const auto& planes = Math::Frustum(s_Data.ViewProjection).GetPlanes();
+		for (uint32_t i = 0; i < planes.size(); i++)
+			s_Data.CullShader->Set(s_Data.CullPlanes[i], planes[i]);
+
+		RenderCommand::BindStorageBuffer(0, s_Data.InstanceVB, instanceOffset, s_Data.InstanceCount * sizeof(MeshInstance));
+		RenderCommand::BindStorageBuffer(1, s_Data.CulledInstanceVB, 0, s_Data.InstanceCount * sizeof(MeshInstance));
+		RenderCommand::BindStorageBuffer(2, s_Data.CullRunBuffer, 0, runBytes);
+		RenderCommand::BindStorageBuffer(3, s_Data.IndirectBuffer, commandOffset, drawCount * sizeof(DrawElementsIndirectCommand));
+		RenderCommand::DispatchCompute((s_Data.InstanceCount + 63) / 64);
+	}
+
+	// нĲѯۼƬԪȻһ֡һвѯ
+	static Ref<SampleQuery> AcquireSampleQuery()
+	{
+		size_t ready = 0;
+		uint64_t samples = 0;
+		while (ready < s_Data.PendingQueries.size() && s_Data.PendingQueries[ready]->TryGetResult(samples))
+		{
+			s_Data.Stats.FragmentCount += samples;
+			s_Data.FreeQueries.push_back(s_Data.PendingQueries[ready]);
+			ready++;
+		}
+		s_Data.PendingQueries.erase(s_Data.PendingQueries.begin(), s_Data.PendingQueries.begin() + ready);
+
+		if (s_Data.FreeQueries.empty())
+			return SampleQuery::Create();
+		Ref<SampleQuery> query = s_Data.FreeQueries.back();
+		s_Data.FreeQueries.pop_back();
+		return query;
+	}
+
+	// Ʊ Flush ռκʵdepthOnly ʱʹֻλõɫ
+	static void SubmitDraws(bool depthOnly, bool culling, uint32_t commandOffset, uint32_t drawCount)
+	{
+		bool compact = s_Data.Format == VertexFormat::Compact;
+		for (RendererBatchData* data : s_Data.FlushBatches)
+		{
+			const Ref<VertexArray>& vertexArray = compact ? data->CompactVAO : data->VAO;
+			if (depthOnly)
+				s_Data.DepthShader->Bind();
+			else
+			{
+				s_Data.TextureSlots.BindAll();
+				s_Data.TextureShader->Bind();
+			}
+			RenderCommand::DrawIndexedBaseVertex(vertexArray, data->IndexCount, data->BaseVertex);
+			s_Data.Stats.DrawCalls++;
+		}
+
+		if (drawCount)
+		{
+			if (depthOnly)
+				s_Data.DepthInstanceShader->Bind();
+			else
+			{
+				s_Data.TextureSlots.BindAll();
+				s_Data.InstanceShader->Bind();
+			}
+			RenderCommand::MultiDrawIndexedIndirect(GetMeshVertexArray(culling), s_Data.IndirectBuffer, commandOffset, drawCount);
+			s_Data.Stats.DrawCalls++;
 		}
-		s_Data.TextureSlotIndex = 1;
+	}
+
+	static void SetOverdrawUniform(int enabled)
+	{
+		s_Data.TextureShader->Set(s_Data.TextureOverdrawView, enabled);
+		s_Data.InstanceShader->Set(s_Data.InstanceOverdrawView, enabled);
 	}
 
 	void Renderer3D::Flush()
 	{
+		// ʽ洢д룬ǰ
+		BatchTransform::Fence();
+
+		s_Data.FlushBatches.clear();
 		for (auto& [_, data] : s_BatchDataMap)
 		{
 			if (data.IndexCount == 0)
 				continue;
+
 			// Size ںָȥǰ
-			uint32_t dataSize = uint32_t((uint8_t*)data.VertexBufferPtr - (uint8_t*)data.VertexBufferBase);
-			// GPU
-			data.VBO->SetData(data.VertexBufferBase, dataSize);
-			for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-				s_Data.TextureSlots[i]->Bind(i);
-			RenderCommand::DrawIndexed(data.VAO, data.IndexCount);
-			s_Data.Stats.DrawCalls++;
+			bool compact = s_Data.Format == VertexFormat::Compact;
+			uint32_t dataSize = compact
+				? uint32_t((uint8_t*)data.CompactVertexBufferPtr - (uint8_t*)data.CompactVertexBufferBase)
+				: uint32_t((uint8_t*)data.VertexBufferPtr - (uint8_t*)data.VertexBufferBase);
+			s_Data.Stats.UploadBytes += dataSize;
+			data.BaseVertex = compact ? data.CompactVBO->Commit(dataSize) / sizeof(CompactVertex) : data.VBO->Commit(dataSize) / sizeof(BatchVertex);
+			s_Data.FlushBatches.push_back(&data);
+		}
+
+		bool culling = false;
+		uint32_t commandOffset = 0;
+		uint32_t drawCount = 0;
+		if (s_Data.InstanceCount)
+		{
+			// ÿͬʵһ
+			// ޳ʱ baseInstance ƫƵһʵе㣻GPU޳ʱʵ0ʼɼɫۼӣе㲻
+			culling = s_Data.GPUCulling;
+			drawCount = (uint32_t)s_Data.InstanceRuns.size();
+			uint32_t instanceOffset = s_Data.InstanceVB->Commit(s_Data.InstanceCount * sizeof(MeshInstance));
+
+			uint32_t available = 0;
+			const uint32_t commandBytes = drawCount * sizeof(DrawElementsIndirectCommand);
+			DrawElementsIndirectCommand* commands = (DrawElementsIndirectCommand*)s_Data.IndirectBuffer->Map(commandBytes, available);
+			uint32_t regionIndex = s_Data.IndirectBuffer->GetRegionIndex();
+			uint32_t regionSize = s_Data.IndirectBuffer->GetRegionSize();
+			uint32_t regionOffset = s_Data.IndirectBuffer->GetWriteOffset() - regionIndex * regionSize;
+			if (regionOffset == 0) // ¿ʼʹãһд޳Ѿ
+				ReadBackCulling(regionIndex, (const uint8_t*)commands);
+
+			uint32_t instanceBase = culling ? 0 : instanceOffset / sizeof(MeshInstance);
+			for (uint32_t i = 0; i < drawCount; i++)
+			{
+				const InstanceRun& run = s_Data.InstanceRuns[i];
+				commands[i] = { run.Mesh.IndexCount, culling ? 0 : run.InstanceCount, run.Mesh.FirstIndex, (int32_t)run.Mesh.BaseVertex, instanceBase + run.FirstInstance };
+			}
+			s_Data.Stats.UploadBytes += s_Data.InstanceCount * sizeof(MeshInstance) + commandBytes;
+
+			commandOffset = s_Data.IndirectBuffer->Commit(commandBytes);
+			if (culling)
+			{
+				DispatchCulling(instanceOffset, commandOffset, drawCount);
+				s_Data.CullReadbacks[regionIndex].push_back({ regionOffset, drawCount, s_Data.InstanceCount });
+			}
+		}
+
+		if (s_Data.FlushBatches.empty() && drawCount == 0)
+			return;
+
+		// ԤȾرɫд뻭һȣɫͨдȣֻԤȾȵƬԪɫ
+		if (s_Data.DepthPrepass)
+		{
+			RenderCommand::SetColorWrite(false);
+			SubmitDraws(true, culling, commandOffset, drawCount);
+			RenderCommand::SetColorWrite(true);
+			RenderCommand::SetDepthWrite(false);
+			RenderCommand::SetDepthFunction(RendererAPI::DepthFunction::Equal);
+		}
+
+		Ref<SampleQuery> query;
+		if (s_Data.OverdrawView)
+		{
+			query = AcquireSampleQuery();
+			SetOverdrawUniform(1);
+			RenderCommand::SetBlendMode(RendererAPI::BlendMode::Additive);
+			query->Begin();
+		}
+
+		SubmitDraws(false, culling, commandOffset, drawCount);
+
+		if (query)
+		{
+			query->End();
+			s_Data.PendingQueries.push_back(query);
+			RenderCommand::SetBlendMode(RendererAPI::BlendMode::Alpha);
+			SetOverdrawUniform(0); // Texture ɫ Renderer2D 
+		}
+
+		if (s_Data.DepthPrepass)
+		{
+			RenderCommand::SetDepthWrite(true);
+			RenderCommand::SetDepthFunction(RendererAPI::DepthFunction::Less);
 		}
 	}
 
@@ -186,32 +702,77 @@ namespace Hazel
 		StartBatch();
 	}
 
-	void Renderer3D::DrawBatch(const glm::mat4& transform, MeshFilterComponent::GeometryType type, const Ref<Mesh>& mesh, const glm::vec4& color, int entityID)
+	// εһдʱӳ䶥ű֮֡ǰд룬Ϊǰʣռɵ
+	static void MapBatchVertices(RendererBatchData& batchData, const Ref<Mesh>& mesh)
 	{
-		const float textureIndex = 0.0f; // White Texture
-		const float tilingFactor = 1.0f;
+		bool compact = s_Data.Format == VertexFormat::Compact;
+		uint32_t vertexSize = compact ? sizeof(CompactVertex) : sizeof(BatchVertex);
+		uint32_t available = 0;
+		void* base = (compact ? batchData.CompactVBO : batchData.VBO)->Map((uint32_t)mesh->GetVertexCount() * vertexSize, available);
+		if (compact)
+			batchData.CompactVertexBufferBase = batchData.CompactVertexBufferPtr = (CompactVertex*)base;
+		else
+			batchData.VertexBufferBase = batchData.VertexBufferPtr = (BatchVertex*)base;
 
-		if (s_BatchDataMap.find(type) == s_BatchDataMap.end())
-			return;
-		RendererBatchData& batchData = s_BatchDataMap[type];
-		if (batchData.IndexCount >= Renderer3DData::MaxSphereIndices)
-			NextBatch();
+		// εͬһظɣ붥
+		uint32_t vertices = std::min(batchData.MaxVertices, available / vertexSize);
+		batchData.IndexLimit = (uint32_t)((uint64_t)vertices * batchData.MaxIndices / batchData.MaxVertices);
+	}
 
-		for (size_t i = 0; i < mesh->GetVertexCount(); i++)
+	// ԤĶдλãǰȷۼ
+	static void* ReserveVertices(RendererBatchData& batchData, const Ref<Mesh>& mesh)
+	{
+		bool mapped = s_Data.Format == VertexFormat::Compact ? batchData.CompactVertexBufferBase != nullptr : batchData.VertexBufferBase != nullptr;
+		if (!mapped)
+			MapBatchVertices(batchData, mesh);
+
+		void* destination;
+		if (s_Data.Format == VertexFormat::Compact)
+		{
+			destination = batchData.CompactVertexBufferPtr;
+			batchData.CompactVertexBufferPtr += mesh->GetVertexCount();
+		}
+		else
 		{
-			batchData.VertexBufferPtr->Position = transform * mesh->GetVertices()[i];
-			batchData.VertexBufferPtr->Color = color;
-			batchData.VertexBufferPtr->TexCoord = mesh->GetTextureCoords()[i];
-			batchData.VertexBufferPtr->TexIndex = textureIndex;
-			batchData.VertexBufferPtr->TilingFactor = tilingFactor;
-			batchData.VertexBufferPtr->EntityID = entityID;
-			batchData.VertexBufferPtr++;
+			destination = batchData.VertexBufferPtr;
+			batchData.VertexBufferPtr += mesh->GetVertexCount();
 		}
 
 		batchData.IndexCount += mesh->GetIndexCount();
 		s_Data.Stats.VertexCount += mesh->GetVertexCount();
 		s_Data.Stats.IndexCount += mesh->GetIndexCount();
 		s_Data.Stats.GeometryCount++;
+		return destination;
+	}
+
+	// ǰʽ񶥵дԤλã״̬ڹ߳е
+	static void WriteVertices(void* destination, const glm::mat4& transform, const Ref<Mesh>& mesh,
+		const glm::vec4& color, float textureIndex, float tilingFactor, int entityID)
+	{
+		if (s_Data.Format == VertexFormat::Compact)
+			BatchTransform::TransformCompact((CompactVertex*)destination, transform,
+				mesh->GetVertices().data(), mesh->GetTextureCoords().data(), (uint32_t)mesh->GetVertexCount(),
+				color, textureIndex, tilingFactor, entityID);
+		else
+			BatchTransform::Transform((BatchVertex*)destination, transform,
+				mesh->GetVertices().data(), mesh->GetTextureCoords().data(), (uint32_t)mesh->GetVertexCount(),
+				color, textureIndex, tilingFactor, entityID);
+	}
+
+	void Renderer3D::DrawBatch(const glm::mat4& transform, MeshFilterComponent::GeometryType type, const Ref<Mesh>& mesh, const glm::vec4& color, int entityID)
+	{
+		const float textureIndex = 0.0f; // White Texture
+		const float tilingFactor = 1.0f;
+
+		if (s_BatchDataMap.find(type) == s_BatchDataMap.end())
+			return;
+		RendererBatchData& batchData = s_BatchDataMap[type];
+		// ӳڴ治Խд룬εж
+		if (batchData.IndexCount + mesh->GetIndexCount() > batchData.IndexLimit)
+			NextBatch();
+
+		void* destination = ReserveVertices(batchData, mesh);
+		WriteVertices(destination, transform, mesh, color, textureIndex, tilingFactor, entityID);
 	}
 
 	void Renderer3D::DrawBatch(const glm::mat4& transform, MeshFilterComponent::GeometryType type, const Ref<Mesh>& mesh, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
@@ -219,63 +780,258 @@ namespace Hazel
 		if (s_BatchDataMap.find(type) == s_BatchDataMap.end())
 			return;
 		RendererBatchData& batchData = s_BatchDataMap[type];
-		if (batchData.IndexCount >= Renderer3DData::MaxSphereIndices)
+		// ӳڴ治Խд룬εж
+		if (batchData.IndexCount + mesh->GetIndexCount() > batchData.IndexLimit)
 			NextBatch();
 
-		// 鿴ǷѾ
-		float textureIndex = 0.0f;
+		// ǷѾ룬δ²λλʱˢκ´
+		int32_t slot = s_Data.TextureSlots.FindOrAdd(texture);
+		if (slot < 0)
+		{
+			NextBatch();
+			slot = s_Data.TextureSlots.FindOrAdd(texture);
+		}
+		float textureIndex = (float)slot;
+
+		void* destination = ReserveVertices(batchData, mesh);
+		WriteVertices(destination, transform, mesh, tintColor, textureIndex, tilingFactor, entityID);
+	}
+
+	void Renderer3D::DrawMesh(const glm::mat4& transform, const MeshFilterComponent& mfc, const MeshRendererComponent& mrc, int entityID)
+	{
+		if (s_Data.Submission == MeshSubmission::Instanced)
+		{
+			MeshDrawPacket packet = { transform, &mfc, &mrc, entityID };
+			DrawMeshes(&packet, 1);
+		}
+		else if (mrc.Texture)
+			DrawBatch(transform, mfc.GType, mfc.MeshObj, mrc.Texture, mrc.TilingFactor, mrc.Color, entityID);
+		else
+			DrawBatch(transform, mfc.GType, mfc.MeshObj, mrc.Color, entityID);
+	}
+
+	// ߳ȷдλú񣬵ȴ߳д
+	struct PendingMesh
+	{
+		void* Destination; // ΪձʾûжӦΣ
+		float TextureIndex;
+	};
+	static std::vector<PendingMesh> s_PendingMeshes;
+
+	// ʵԤһʵǰȷһͬʱϲΪͬһ
+	static MeshInstance* ReserveInstance(const Ref<Mesh>& mesh)
+	{
+		if (!s_Data.InstanceBufferBase)
+		{
+			// εһдʱӳ䣬Ϊǰʣռ
+			uint32_t available = 0;
+			s_Data.InstanceBufferBase = s_Data.InstanceBufferPtr = (MeshInstance*)s_Data.InstanceVB->Map(sizeof(MeshInstance), available);
+			s_Data.InstanceLimit = std::min(Renderer3DData::MaxInstances, available / (uint32_t)sizeof(MeshInstance));
+		}
 
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+		const MeshAllocation& allocation = MeshPool::Get(mesh);
+		if (!s_Data.InstanceRuns.empty() && s_Data.InstanceRuns.back().Mesh.FirstIndex == allocation.FirstIndex
+			&& s_Data.InstanceRuns.back().Mesh.BaseVertex == allocation.BaseVertex)
+			s_Data.InstanceRuns.back().InstanceCount++;
+		else
+			s_Data.InstanceRuns.push_back({ allocation, s_Data.InstanceCount, 1 });
+
+		s_Data.InstanceCount++;
+		s_Data.Stats.InstanceCount++;
+		s_Data.Stats.VertexCount += allocation.VertexCount;
+		s_Data.Stats.IndexCount += allocation.IndexCount;
+		s_Data.Stats.GeometryCount++;
+		return s_Data.InstanceBufferPtr++;
+	}
+
+	static void WriteInstance(MeshInstance* instance, const glm::mat4& transform, const glm::vec4& color, float textureIndex, float tilingFactor, int entityID)
+	{
+		instance->TransformX = transform[0];
+		instance->TransformY = transform[1];
+		instance->TransformZ = transform[2];
+		instance->Translation = transform[3];
+		instance->Color = glm::packUnorm4x8(color);
+		instance->TexIndex = (int)textureIndex;
+		instance->TilingFactor = tilingFactor;
+		instance->EntityID = entityID;
+	}
+
+	// д [begin, end) дЩݲύ
+	static void WritePendingMeshes(const MeshDrawPacket* packets, uint32_t begin, uint32_t end)
+	{
+		ThreadPool::ParallelFor(end - begin, 16, [packets, begin](uint32_t first, uint32_t last)
 		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
+			bool instanced = s_Data.Submission == Renderer3D::MeshSubmission::Instanced;
+			for (uint32_t i = begin + first; i < begin + last; i++)
 			{
-				textureIndex = (float)i;
-				break;
+				const PendingMesh& pending = s_PendingMeshes[i];
+				if (!pending.Destination)
+					continue;
+
+				const MeshRendererComponent& renderer = *packets[i].Renderer;
+				float tilingFactor = renderer.Texture ? renderer.TilingFactor : 1.0f;
+				if (instanced)
+					WriteInstance((MeshInstance*)pending.Destination, packets[i].Transform,
+						renderer.Color, pending.TextureIndex, tilingFactor, packets[i].EntityID);
+				else
+					WriteVertices(pending.Destination, packets[i].Transform, packets[i].Filter->MeshObj,
+						renderer.Color, pending.TextureIndex, tilingFactor, packets[i].EntityID);
 			}
-		}
+			// ʽ洢ֻڱ߳򣬽߳ǰ
+			BatchTransform::Fence();
+		});
+	}
 
-		// δУµλ
-		if (textureIndex == 0.0f)
+	// ʵύ̰߳˳λʵλãʵɹ߳д
+	void Renderer3D::DrawMeshesInstanced(const MeshDrawPacket* packets, uint32_t count)
+	{
+		s_PendingMeshes.resize(count);
+		uint32_t begin = 0;
+		for (uint32_t i = 0; i < count; i++)
 		{
-			if (s_Data.TextureSlotIndex >= Renderer3DData::MaxTextureSlots)
+			PendingMesh& pending = s_PendingMeshes[i];
+			pending.Destination = nullptr;
+
+			const Ref<Mesh>& mesh = Mesh::GetLOD(packets[i].Filter->MeshObj, packets[i].LOD);
+			if (!mesh || mesh->GetIndexCount() == 0)
+				continue;
+
+			const Ref<Texture2D>& texture = packets[i].Renderer->Texture;
+			while (true)
+			{
+				if (s_Data.InstanceCount < s_Data.InstanceLimit)
+				{
+					int32_t slot = texture ? s_Data.TextureSlots.FindOrAdd(texture) : 0;
+					if (slot >= 0)
+					{
+						pending.TextureIndex = (float)slot;
+						pending.Destination = ReserveInstance(mesh);
+						break;
+					}
+				}
+
+				// ʵλдһٿʼ
+				WritePendingMeshes(packets, begin, i);
 				NextBatch();
+				begin = i;
+			}
+		}
+		WritePendingMeshes(packets, begin, count);
+	}
+
+	// ΧĵͼɽԶ򣬽дȣ汻ڵƬԪȲǰ
+	// ʵʱͬһʵڣʵ򣩣Ѽӻɢ
+	static const MeshDrawPacket* SortFrontToBack(const MeshDrawPacket* packets, uint32_t count)
+	{
+		bool instanced = s_Data.Submission == Renderer3D::MeshSubmission::Instanced;
+		s_Data.SortKeys.resize(count);
+		s_Data.SortValues.resize(count);
+		s_Data.SortTmpKeys.resize(count);
+		s_Data.SortTmpValues.resize(count);
+		s_Data.SortGroups.resize(count);
 
-			textureIndex = (float)s_Data.TextureSlotIndex; // һ
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
+		// üռ z ͸ӺͶӰͼȵ
+		std::unordered_map<const Mesh*, uint32_t> groupIndices;
+		std::vector<float> groupDepths;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const Ref<Mesh>& mesh = instanced ? Mesh::GetLOD(packets[i].Filter->MeshObj, packets[i].LOD) : packets[i].Filter->MeshObj;
+			glm::vec3 center = mesh ? mesh->GetBoundingSphere().Center : glm::vec3(0.0f);
+			float depth = (s_Data.ViewProjection * (packets[i].Transform * glm::vec4(center, 1.0f))).z;
+			s_Data.SortKeys[i] = Math::FloatToSortableBits(depth);
+			s_Data.SortValues[i] = i;
+
+			if (instanced)
+			{
+				auto [it, inserted] = groupIndices.try_emplace(mesh.get(), (uint32_t)groupDepths.size());
+				if (inserted)
+					groupDepths.push_back(depth);
+				else
+					groupDepths[it->second] = std::min(groupDepths[it->second], depth);
+				s_Data.SortGroups[i] = it->second;
+			}
 		}
 
-		for (size_t i = 0; i < mesh->GetVertexCount(); i++)
+		if (instanced && groupDepths.size() > 1)
 		{
-			batchData.VertexBufferPtr->Position = transform * mesh->GetVertices()[i];
-			batchData.VertexBufferPtr->Color = tintColor;
-			batchData.VertexBufferPtr->TexCoord = mesh->GetTextureCoords()[i];
-			batchData.VertexBufferPtr->TexIndex = textureIndex;
-			batchData.VertexBufferPtr->TilingFactor = tilingFactor;
-			batchData.VertexBufferPtr->EntityID = entityID;
-			batchData.VertexBufferPtr++;
+			std::vector<uint32_t> order(groupDepths.size());
+			for (uint32_t group = 0; group < (uint32_t)order.size(); group++)
+				order[group] = group;
+			std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return groupDepths[a] < groupDepths[b]; });
+
+			std::vector<uint64_t> ranks(order.size());
+			for (uint32_t rank = 0; rank < (uint32_t)order.size(); rank++)
+				ranks[order[rank]] = (uint64_t)rank << 32;
+			for (uint32_t i = 0; i < count; i++)
+				s_Data.SortKeys[i] |= ranks[s_Data.SortGroups[i]];
 		}
 
-		batchData.IndexCount += mesh->GetIndexCount();
-		s_Data.Stats.VertexCount += mesh->GetVertexCount();
-		s_Data.Stats.IndexCount += mesh->GetIndexCount();
-		s_Data.Stats.GeometryCount++;
+		Math::RadixSort(s_Data.SortKeys.data(), s_Data.SortValues.data(), s_Data.SortTmpKeys.data(), s_Data.SortTmpValues.data(), count);
+
+		s_Data.OpaqueQueue.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			s_Data.OpaqueQueue[i] = packets[s_Data.SortValues[i]];
+		return s_Data.OpaqueQueue.data();
 	}
 
-	void Renderer3D::DrawMesh(const glm::mat4& transform, MeshFilterComponent& mfc, MeshRendererComponent& mrc, int entityID)
+	void Renderer3D::DrawMeshes(const MeshDrawPacket* packets, uint32_t count)
 	{
-		if (mrc.Texture)
-			DrawBatch(transform, mfc.GType, mfc.MeshObj, mrc.Texture, mrc.TilingFactor, mrc.Color, entityID);
-		else
-			DrawBatch(transform, mfc.GType, mfc.MeshObj, mrc.Color, entityID);
+		if (s_Data.FrontToBackSorting && count > 1)
+			packets = SortFrontToBack(packets, count);
+
+		if (s_Data.Submission == MeshSubmission::Instanced)
+		{
+			DrawMeshesInstanced(packets, count);
+			return;
+		}
+
+		// ̰߳˳λöǰ׺Ԥдλãɽ߳
+		s_PendingMeshes.resize(count);
+		uint32_t begin = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			PendingMesh& pending = s_PendingMeshes[i];
+			pending.Destination = nullptr;
+
+			auto it = s_BatchDataMap.find(packets[i].Filter->GType);
+			if (it == s_BatchDataMap.end())
+				continue;
+
+			// εEBO͵ĻɣֻܻƵ 0 
+			RendererBatchData& batchData = it->second;
+			const Ref<Mesh>& mesh = packets[i].Filter->MeshObj;
+			const Ref<Texture2D>& texture = packets[i].Renderer->Texture;
+			if (mesh->GetIndexCount() > batchData.MaxIndices)
+			{
+				HZ_CORE_ASSERT(false, "Mesh is larger than a whole batch!");
+				continue;
+			}
+
+			while (true)
+			{
+				if (batchData.IndexCount + mesh->GetIndexCount() <= batchData.IndexLimit)
+				{
+					int32_t slot = texture ? s_Data.TextureSlots.FindOrAdd(texture) : 0;
+					if (slot >= 0)
+					{
+						pending.TextureIndex = (float)slot;
+						pending.Destination = ReserveVertices(batchData, mesh);
+						break;
+					}
+				}
+
+				// λдһٿʼ
+				WritePendingMeshes(packets, begin, i);
+				NextBatch();
+				begin = i;
+			}
+		}
+		WritePendingMeshes(packets, begin, count);
 	}
 
 	void Renderer3D::ResetStats()
 	{
-		s_Data.Stats.DrawCalls = 0;
-		s_Data.Stats.GeometryCount = 0;
-		s_Data.Stats.VertexCount = 0;
-		s_Data.Stats.IndexCount = 0;
+		s_Data.Stats = RenderStats();
 	}
 
 	RenderStats* Renderer3D::GetStats()
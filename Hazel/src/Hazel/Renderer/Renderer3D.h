@@ -2,14 +2,61 @@
 
 #include "Hazel/Renderer/Texture.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Renderer/Geometry/Geometry.h"
 #include "Hazel/Scene/Components.h"
 
 namespace Hazel
 {
 	class Renderer;
 	class RenderStats;
+
+	// һƣ DrawMeshes ǰЧ
+	struct MeshDrawPacket
+	{
+		glm::mat4 Transform;
+		const MeshFilterComponent* Filter;
+		const MeshRendererComponent* Renderer;
+		int EntityID;
+		uint32_t LOD = 0; //  Filter->MeshObj ĵڼ LOD
+	};
+
 	class Renderer3D
 	{
+	public:
+		// Ķʽڳ֮л
+		static void SetVertexFormat(VertexFormat format);
+		static VertexFormat GetVertexFormat();
+
+		// Batched: ÿĶCPUϱ任дΣInstanced: פ MeshPoolÿһʵ
+		// ʵʱһ MultiDrawIndirectͬһϲΪһʽò
+		enum class MeshSubmission
+		{
+			Batched = 0, Instanced = 1
+		};
+
+		static void SetMeshSubmission(MeshSubmission submission);
+		static MeshSubmission GetMeshSubmission();
+
+		// ʵύʱɼɫ׶޳дӻʵCPUȴ
+		// ޳ͳͨ첽ضȻ֡
+		static void SetGPUCulling(bool enabled);
+		static bool IsGPUCullingEnabled();
+
+		// ΧͶӰĻϵĴСѡ LODcurrentLOD Ϊһ֡ļͺ
+		//  BeginScene ֮ãرʱǷ 0
+		static uint32_t SelectLOD(const Mesh& mesh, const glm::mat4& transform, uint32_t currentLOD);
+		static void SetLODEnabled(bool enabled);
+		static bool IsLODEnabled();
+
+		// ͸ͼɽԶύʵʱͬʵȻڣ
+		static void SetFrontToBackSorting(bool enabled);
+		static bool IsFrontToBackSortingEnabled();
+		// ԤȾֻλõɫдȣɫͨ Equal ȲԻƣÿֻɫһ
+		static void SetDepthPrepass(bool enabled);
+		static bool IsDepthPrepassEnabled();
+		// ȻͼÿɫƬԪӹ̶ɫͨѯͳƬԪRenderStats::FragmentCount
+		static void SetOverdrawView(bool enabled);
+		static bool IsOverdrawViewEnabled();
 	private:
 		//static void Init();
 		static void Init();
@@ -18,6 +65,8 @@ namespace Hazel
 		static void BeginScene(const Camera& camera, const glm::mat4& transform);
 		static void BeginScene(const EditorCamera& camera);
 		static void EndScene();
+		// ÿ֡ʱһΣʽΪ֡դһ֡һ
+		static void EndFrame();
 		static void Flush();
 		static void DrawBatch(
 			const glm::mat4& transform, 
@@ -33,7 +82,10 @@ namespace Hazel
 			float tilingFactor = 1.0f, 
 			const glm::vec4& tintColor = glm::vec4(1.0f),
 			int entityID = -1);
-		static void DrawMesh(const glm::mat4& transform, MeshFilterComponent& mfc, MeshRendererComponent& mrc, int entityID);
+		static void DrawMesh(const glm::mat4& transform, const MeshFilterComponent& mfc, const MeshRendererComponent& mrc, int entityID);
+		// ύ񣬶̳߳زɣ DrawMesh ͬ
+		static void DrawMeshes(const MeshDrawPacket* packets, uint32_t count);
+		static void DrawMeshesInstanced(const MeshDrawPacket* packets, uint32_t count);
 
 		static void ResetStats();
 		static RenderStats* GetStats();
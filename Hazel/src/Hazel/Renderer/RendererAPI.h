@@ -6,6 +6,16 @@
 
 namespace Hazel
 {
+	//  glMultiDrawElementsIndirect ʽһ
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t Count;			// 
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
 	class RendererAPI
 	{
 	public:
@@ -13,6 +23,18 @@ namespace Hazel
 		{
 			None = 0, OpenGL = 1, DirectX = 2
 		};
+
+		// ԤȾɫͨ EqualֻɫԤȾͬǰƬԪ
+		enum class DepthFunction
+		{
+			Less = 0, Equal = 1
+		};
+
+		// Additive ڹȻͼÿƬԪۼɫ
+		enum class BlendMode
+		{
+			Alpha = 0, Additive = 1
+		};
 	public:
 		virtual ~RendererAPI() = default;
 
@@ -23,6 +45,17 @@ namespace Hazel
 		virtual void SetClearColor(const glm::vec4& color) = 0;
 		virtual void Clear() = 0;
 		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		virtual void DrawIndexedBaseVertex(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex) = 0;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) = 0;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex) = 0;
+		virtual void MultiDrawIndexedIndirect(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& commandBuffer, uint32_t commandOffset, uint32_t drawCount) = 0;
+		virtual void BindStorageBuffer(uint32_t binding, const Ref<VertexBuffer>& buffer, uint32_t offset, uint32_t size) = 0;
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
+
+		virtual void SetDepthFunction(DepthFunction function) = 0;
+		virtual void SetDepthWrite(bool enabled) = 0;
+		virtual void SetColorWrite(bool enabled) = 0;
+		virtual void SetBlendMode(BlendMode mode) = 0;
 
 		static API GetAPI() { return s_API; }
 		static API SetAPI(API api) { s_API = api; }
@@ -0,0 +1,24 @@
+#include "hzpch.h"
+#include "SampleQuery.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLSampleQuery.h"
+
+namespace Hazel
+{
+	Ref<SampleQuery> SampleQuery::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported! ")
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLSampleQuery>();
+		case RendererAPI::API::DirectX: HZ_CORE_ASSERT(false, "RendererAPI::DirectX is currently not supported! ")
+			return nullptr;
+		}
+
+		HZ_CORE_ASSERT(false, "UnKnown RendererAPI!");
+		return nullptr;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+namespace Hazel
+{
+	// ͳ Begin/End ֮ͨȲԵĲ첽ãѯʱȴGPU
+	class SampleQuery
+	{
+	public:
+		virtual ~SampleQuery() = default;
+
+		virtual void Begin() = 0;
+		virtual void End() = 0;
+
+		// ѿʱд samples  true
+		virtual bool TryGetResult(uint64_t& samples) = 0;
+
+		static Ref<SampleQuery> Create();
+	};
+}
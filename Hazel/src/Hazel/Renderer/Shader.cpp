@@ -4,8 +4,16 @@
 #include "Hazel/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 namespace Hazel 
 {
+	ShaderLoadStats Shader::s_LoadStats;
+
 	Ref<Shader> Shader::Create(const std::string& filepath)
 	{
 		switch (Renderer::GetAPI())
@@ -37,8 +45,113 @@ namespace Hazel
 			return nullptr;
 	}
 
+	void Shader::ClearCache()
+	{
+		std::error_code error;
+		std::uintmax_t count = std::filesystem::remove_all(CacheDirectory, error);
+		if (error)
+			HZ_CORE_WARN("Shader: could not clear cache '{0}': {1}", CacheDirectory, error.message());
+		else
+			HZ_CORE_INFO("Shader: cleared cache '{0}' ({1} files)", CacheDirectory, count);
+	}
+
 	std::unordered_map<std::string, Ref<Shader>> ShaderLibrary::m_Shaders;
 
+	// ɫԴļӣ̶̨߳ڱȽ޸ʱ䲢µԴ룬GL ֻ̣߳± ShaderLibrary::Update
+	struct ShaderFileWatcher
+	{
+		struct WatchedFile
+		{
+			std::string Name;
+			std::filesystem::path Path;
+			std::filesystem::file_time_type WriteTime;
+		};
+
+		static constexpr std::chrono::milliseconds Interval{ 250 };
+
+		std::thread Thread;
+		std::mutex Mutex;
+		std::condition_variable WakeCondition; // Ҫ˳
+		bool Running = false;
+		bool Enabled = true;
+		std::vector<WatchedFile> Files;							// ֻ׷ӣ̰߳±д޸ʱ
+		std::vector<std::pair<std::string, std::string>> Modified; // ֣µԴ
+	};
+	static ShaderFileWatcher s_Watcher;
+
+	static void WatchShaderFiles()
+	{
+		std::unique_lock<std::mutex> lock(s_Watcher.Mutex);
+		while (true)
+		{
+			s_Watcher.WakeCondition.wait_for(lock, ShaderFileWatcher::Interval, [] { return !s_Watcher.Running; });
+			if (!s_Watcher.Running)
+				return;
+
+			// ļ
+			std::vector<ShaderFileWatcher::WatchedFile> files = s_Watcher.Files;
+			lock.unlock();
+
+			std::vector<std::pair<size_t, std::string>> changed;
+			for (size_t i = 0; i < files.size(); i++)
+			{
+				std::error_code error;
+				std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(files[i].Path, error);
+				if (error || writeTime == files[i].WriteTime)
+					continue;
+
+				// ༭ʱȽضļʱһ
+				std::ifstream stream(files[i].Path, std::ios::in | std::ios::binary);
+				std::stringstream source;
+				source << stream.rdbuf();
+				if (!stream || source.str().empty())
+					continue;
+
+				files[i].WriteTime = writeTime;
+				changed.emplace_back(i, source.str());
+			}
+
+			lock.lock();
+			for (auto& [index, source] : changed)
+			{
+				s_Watcher.Files[index].WriteTime = files[index].WriteTime;
+				s_Watcher.Modified.emplace_back(files[index].Name, std::move(source));
+			}
+		}
+	}
+
+	static void StartShaderWatcher()
+	{
+		if (s_Watcher.Running)
+			return;
+		s_Watcher.Running = true;
+		s_Watcher.Thread = std::thread(WatchShaderFiles);
+	}
+
+	static void StopShaderWatcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_Watcher.Mutex);
+			if (!s_Watcher.Running)
+				return;
+			s_Watcher.Running = false;
+		}
+		s_Watcher.WakeCondition.notify_all();
+		s_Watcher.Thread.join();
+	}
+
+	static void WatchShaderFile(const std::string& name, const std::string& filepath)
+	{
+		std::error_code error;
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(filepath, error);
+		{
+			std::lock_guard<std::mutex> lock(s_Watcher.Mutex);
+			s_Watcher.Files.push_back({ name, filepath, writeTime });
+		}
+		if (s_Watcher.Enabled)
+			StartShaderWatcher();
+	}
+
 	void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
 	{
 		HZ_CORE_ASSERT(!Exists(name), "Shader already exists!");
@@ -55,6 +168,7 @@ namespace Hazel
 	{
 		auto shader = Shader::Create(filepath);
 		Add(shader);
+		WatchShaderFile(shader->GetName(), filepath);
 		return shader;
 	}
 
@@ -62,6 +176,7 @@ namespace Hazel
 	{
 		auto shader = Shader::Create(filepath);
 		Add(name, shader);
+		WatchShaderFile(name, filepath);
 		return shader;
 	}
 
@@ -75,4 +190,47 @@ namespace Hazel
 	{
 		return m_Shaders.find(name) != m_Shaders.end();
 	}
+
+	void ShaderLibrary::Update()
+	{
+		for (auto& [name, shader] : m_Shaders)
+			shader->Poll();
+
+		std::vector<std::pair<std::string, std::string>> modified;
+		{
+			std::lock_guard<std::mutex> lock(s_Watcher.Mutex);
+			modified.swap(s_Watcher.Modified);
+		}
+		for (auto& [name, source] : modified)
+		{
+			auto it = m_Shaders.find(name);
+			if (it == m_Shaders.end())
+				continue;
+
+			HZ_CORE_INFO("ShaderLibrary: '{0}' changed, recompiling", name);
+			it->second->Reload(source);
+		}
+	}
+
+	void ShaderLibrary::Shutdown()
+	{
+		StopShaderWatcher();
+		s_Watcher.Files.clear();
+		s_Watcher.Modified.clear();
+		m_Shaders.clear();
+	}
+
+	void ShaderLibrary::SetHotReloadEnabled(bool enabled)
+	{
+		s_Watcher.Enabled = enabled;
+		if (!enabled)
+			StopShaderWatcher();
+		else if (!s_Watcher.Files.empty())
+			StartShaderWatcher();
+	}
+
+	bool ShaderLibrary::IsHotReloadEnabled()
+	{
+		return s_Watcher.Enabled;
+	}
 }
\ No newline at end of file
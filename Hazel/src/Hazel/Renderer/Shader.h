@@ -6,6 +6,24 @@
 
 namespace Hazel 
 {
+	// ·ϵ uniform ɫʱ uniform ±꣬ʱֻ + һ GL 
+	// ɫвڣ򱻱Ż uniform õЧЧʲôҲ
+	template<typename T>
+	struct UniformHandle
+	{
+		int32_t Index = -1;
+
+		bool IsValid() const { return Index >= 0; }
+	};
+
+	// ɫͳƣȽ룩ȡƻ棩
+	struct ShaderLoadStats
+	{
+		uint32_t CacheHits = 0;
+		uint32_t CacheMisses = 0;
+		float LoadTime = 0.0f;	// ɫӶԴ뵽õܺʱ(ms)
+	};
+
 	class Shader
 	{
 	public:
@@ -14,6 +32,13 @@ namespace Hazel
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
+		// ɫں̨ӣһιǰ Bind ʹռλ uniform ȡʱȴ
+		virtual bool IsReady() const = 0;
+		// ȴؼ̨ʱ³򣻷Ƿ³
+		virtual bool Poll() = 0;
+		// µԴں̨±룬ǰʹõǰʧʱǰ
+		virtual void Reload(const std::string& source) = 0;
+
 		virtual void SetInt(const std::string& name, int value) = 0;
 		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) = 0;
 		virtual void SetFloat(const std::string& name, float value) = 0;
@@ -22,10 +47,31 @@ namespace Hazel
 		virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
 
+		// Ԫ "u_Name[i]" ң"u_Name" ָ 0 Ԫ
+		template<typename T>
+		UniformHandle<T> GetUniform(const std::string& name) { return { FindUniform(name) }; }
+
+		virtual void Set(UniformHandle<int> uniform, int value) = 0;
+		virtual void Set(UniformHandle<float> uniform, float value) = 0;
+		virtual void Set(UniformHandle<glm::vec2> uniform, const glm::vec2& value) = 0;
+		virtual void Set(UniformHandle<glm::vec3> uniform, const glm::vec3& value) = 0;
+		virtual void Set(UniformHandle<glm::vec4> uniform, const glm::vec4& value) = 0;
+		virtual void Set(UniformHandle<glm::mat4> uniform, const glm::mat4& value) = 0;
+
 		virtual const std::string& GetName() const = 0;
 
 		static Ref<Shader> Create(const std::string& filepath);
 		static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		// ĳƻĿ¼£ͼνӿڷĿ¼ΪԴϣ + Ϣ
+		static constexpr const char* CacheDirectory = "assets/cache/shader";
+		static void ClearCache();	// ɾ棬´ʱ±ɫ
+		static const ShaderLoadStats& GetLoadStats() { return s_LoadStats; }
+	protected:
+		static ShaderLoadStats s_LoadStats;
+
+		//  uniform ±꣬Ҳʱ -1
+		virtual int32_t FindUniform(const std::string& name) = 0;
 	};
 
 	class ShaderLibrary	//Ƚϸߣֱ Shader.h ж壬漰ĳһͼνӿڵϸ
@@ -41,6 +87,14 @@ namespace Hazel
 		static Ref<Shader> Load(const std::string& name, const std::string& filepath);
 		static Ref<Shader> Get(const std::string& name);
 		static bool Exists(const std::string& name);
+
+		// ÿ֡һΣϺ̨ɵɫļӷԴļ޸ʱʼ±
+		static void Update();
+		static void Shutdown();
+
+		// أ̨̼߳Ӵļصɫ޸ĺһ Update ʱ±
+		static void SetHotReloadEnabled(bool enabled);
+		static bool IsHotReloadEnabled();
 	private:
 		static std::unordered_map<std::string, Ref<Shader>> m_Shaders;
 	};
@@ -0,0 +1,14 @@
+#include "hzpch.h"
+#include "SubTexture2D.h"
+
+namespace Hazel
+{
+	SubTexture2D::SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max, bool translucent)
+		: m_Texture(texture), m_Translucent(translucent)
+	{
+		m_TexCoords[0] = { min.x, min.y };
+		m_TexCoords[1] = { max.x, min.y };
+		m_TexCoords[2] = { max.x, max.y };
+		m_TexCoords[3] = { min.x, max.y };
+	}
+}
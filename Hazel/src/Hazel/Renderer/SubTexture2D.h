@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel
+{
+	// еһͼеһž飩˳ Quad::GetTextureCoords һ
+	class SubTexture2D
+	{
+	public:
+		SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max, bool translucent = false);
+
+		const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+		const glm::vec2* GetTexCoords() const { return m_TexCoords; }
+		// (min.x, min.y, max.x, max.y)
+		glm::vec4 GetTexRect() const { return { m_TexCoords[0], m_TexCoords[2] }; }
+
+		// Ƿа͸أڵܰ͸
+		bool HasTranslucency() const { return m_Translucent; }
+
+	private:
+		Ref<Texture2D> m_Texture;
+		glm::vec2 m_TexCoords[4];
+		bool m_Translucent;
+	};
+}
@@ -6,7 +6,7 @@
 
 namespace Hazel 
 {
-	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height)
+	Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, uint32_t mipLevels)
 	{
 		switch (Renderer::GetAPI())
 		{
@@ -14,7 +14,7 @@ namespace Hazel
 			HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported! ")
 			return nullptr;
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLTexture2D>(width, height);
+			return CreateRef<OpenGLTexture2D>(width, height, mipLevels);
 		case RendererAPI::API::DirectX: 
 			HZ_CORE_ASSERT(false, "RendererAPI::DirectX is currently not supported! ")
 			return nullptr;
@@ -40,4 +40,22 @@ namespace Hazel
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!")
 			return nullptr;
 	}
+
+	Ref<Texture2DArray> Texture2DArray::Create(uint32_t width, uint32_t height, uint32_t format, uint32_t mipLevels, uint32_t layerCount)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: 
+			HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported! ")
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLTexture2DArray>(width, height, format, mipLevels, layerCount);
+		case RendererAPI::API::DirectX: 
+			HZ_CORE_ASSERT(false, "RendererAPI::DirectX is currently not supported! ")
+			return nullptr;
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown Renderer API!")
+			return nullptr;
+	}
 }
\ No newline at end of file
@@ -12,13 +12,23 @@ namespace Hazel
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 		virtual uint32_t GetRendererID() const = 0;
+		virtual uint32_t GetFormat() const = 0; // ͼAPIصڲʽ
 		virtual const std::string& GetPath() const = 0;
+		virtual uint32_t GetMipLevelCount() const = 0;
+		// ÿθı䣨SetData / SetSubData / GenerateMipmapsʱ1иһݴжǷҪ¸
+		virtual uint32_t GetRevision() const = 0;
 
 		virtual void SetData(void* data, uint32_t size) = 0;
+		// µ0 mipmap еһݸʽһ
+		virtual void SetSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+		// ɵ0 mipmap ֻһʱκ
+		virtual void GenerateMipmaps() = 0;
 
 		virtual void Bind(uint32_t slot = 0) const = 0;
 
 		virtual bool IsLoaded() const = 0;
+		// Ƿ alpha С1أʱ͸
+		virtual bool HasTranslucency() const = 0;
 
 		virtual bool operator==(const Texture& other) const = 0;
 	};
@@ -26,7 +36,30 @@ namespace Hazel
 	class Texture2D : public Texture
 	{
 	public:
-		static Ref<Texture2D> Create(uint32_t width, uint32_t height);
+		static Ref<Texture2D> Create(uint32_t width, uint32_t height, uint32_t mipLevels = 1);
 		static Ref<Texture2D> Create(const std::string& path);
 	};
+
+	// ͬߴ硢ͬʽɵ飬ÿռһ
+	class Texture2DArray
+	{
+	public:
+		virtual ~Texture2DArray() = default;
+
+		virtual uint32_t GetWidth() const = 0;
+		virtual uint32_t GetHeight() const = 0;
+		virtual uint32_t GetFormat() const = 0;
+		virtual uint32_t GetMipLevelCount() const = 0;
+		virtual uint32_t GetLayerCount() const = 0;
+		virtual uint32_t GetRendererID() const = 0;
+
+		// ݵ layerCount 㣬вݱ
+		virtual void Resize(uint32_t layerCount) = 0;
+		// GPUϰ mipmap 𣩸Ƶָ㣬ߴ硢ʽ mipmap һ
+		virtual void CopyToLayer(uint32_t layer, const Ref<Texture2D>& texture) = 0;
+
+		virtual void Bind(uint32_t slot = 0) const = 0;
+
+		static Ref<Texture2DArray> Create(uint32_t width, uint32_t height, uint32_t format, uint32_t mipLevels, uint32_t layerCount);
+	};
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "hzpch.h"
+#include "TextureArrayTable.h"
+
+namespace Hazel
+{
+	static constexpr uint32_t InitialPageLayers = 8;
+	static constexpr uint64_t InitialPageBytes = 16 * 1024 * 1024; // ½ҳԴԤ㣬 2048x2048 ͼҳ1㿪ʼ
+
+	// ÿ4ֽڹһ㣨 mipmap ĴСʼԤ
+	static uint32_t GetInitialLayerCount(const Ref<Texture2D>& texture)
+	{
+		uint64_t layerBytes = (uint64_t)texture->GetWidth() * texture->GetHeight() * 4;
+		if (texture->GetMipLevelCount() > 1)
+			layerBytes += layerBytes / 3;
+		return (uint32_t)std::clamp<uint64_t>(InitialPageBytes / layerBytes, 1, InitialPageLayers);
+	}
+
+	void TextureArrayTable::SetWhiteTexture(const Ref<Texture2D>& texture)
+	{
+		m_WhiteTexture = texture;
+		Reset();
+	}
+
+	void TextureArrayTable::Reset()
+	{
+		m_UnitCount = 0;
+		m_Generation++;
+
+		// ɫʼռõ0Ԫ
+		if (m_WhiteTexture)
+			FindOrAdd(m_WhiteTexture);
+	}
+
+	int32_t TextureArrayTable::FindOrAdd(const Ref<Texture2D>& texture)
+	{
+		auto it = m_Residents.find(texture->GetRendererID());
+		if (it == m_Residents.end() || it->second.Texture != texture.get() || it->second.Handle.expired())
+		{
+			// ͬһ RendererID ٵʱȹ黹ռõĲ
+			if (it != m_Residents.end())
+			{
+				m_Pages[it->second.Page].FreeLayers.push_back(it->second.Layer);
+				m_Residents.erase(it);
+			}
+			it = m_Residents.emplace(texture->GetRendererID(), Allocate(texture)).first;
+		}
+		else if (it->second.Revision != texture->GetRevision())
+		{
+			// ڽ޸Ĺͼҳµľ飩¸ƵռõĲ
+			m_Pages[it->second.Page].Array->CopyToLayer(it->second.Layer, texture);
+			it->second.Revision = texture->GetRevision();
+		}
+
+		const Residency& residency = it->second;
+		Page& page = m_Pages[residency.Page];
+		if (page.Generation != m_Generation)
+		{
+			if (m_UnitCount >= MaxUnits)
+				return -1;
+
+			page.Unit = m_UnitCount;
+			page.Generation = m_Generation;
+			m_UnitPages[m_UnitCount++] = residency.Page;
+		}
+
+		return (int32_t)((page.Unit << 8) | residency.Layer);
+	}
+
+	TextureArrayTable::Residency TextureArrayTable::Allocate(const Ref<Texture2D>& texture)
+	{
+		Residency residency;
+		residency.Texture = texture.get();
+		residency.Handle = texture;
+		residency.Revision = texture->GetRevision();
+
+		uint32_t pageIndex = 0;
+		for (; pageIndex < (uint32_t)m_Pages.size(); pageIndex++)
+		{
+			const Page& page = m_Pages[pageIndex];
+			const Ref<Texture2DArray>& array = page.Array;
+			if (array->GetWidth() == texture->GetWidth() && array->GetHeight() == texture->GetHeight() && array->GetFormat() == texture->GetFormat()
+				&& array->GetMipLevelCount() == texture->GetMipLevelCount() && (!page.FreeLayers.empty() || page.LayerCount < MaxLayersPerPage))
+				break;
+		}
+
+		// ûгߴ硢ʽmipmap һпλҳʱ½һҳ
+		if (pageIndex == (uint32_t)m_Pages.size())
+		{
+			Page page;
+			page.Array = Texture2DArray::Create(texture->GetWidth(), texture->GetHeight(), texture->GetFormat(),
+				texture->GetMipLevelCount(), GetInitialLayerCount(texture));
+			m_Pages.push_back(page);
+		}
+
+		Page& page = m_Pages[pageIndex];
+		if (!page.FreeLayers.empty())
+		{
+			residency.Layer = page.FreeLayers.back();
+			page.FreeLayers.pop_back();
+		}
+		else
+		{
+			// ʱ2
+			if (page.LayerCount == page.Array->GetLayerCount())
+				page.Array->Resize(std::min(page.LayerCount * 2, MaxLayersPerPage));
+			residency.Layer = page.LayerCount++;
+		}
+
+		page.Array->CopyToLayer(residency.Layer, texture);
+		residency.Page = pageIndex;
+		return residency;
+	}
+
+	void TextureArrayTable::BindAll() const
+	{
+		for (uint32_t i = 0; i < m_UnitCount; i++)
+			m_Pages[m_UnitPages[i]].Array->Bind(i);
+	}
+
+	void TextureArrayTable::Clear()
+	{
+		m_Pages.clear();
+		m_Residents.clear();
+		m_UnitCount = 0;
+		m_WhiteTexture = nullptr;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel
+{
+	// ˣͬߴ硢ͬʽͬ mipmap Žͬһ Texture2DArray ҳÿռһ
+	// פ֡Σֻͬʱõҳ MaxUnits ʱҪˢ
+	// ɫеΪ (unit << 8) | layer
+	class TextureArrayTable
+	{
+	public:
+		static constexpr uint32_t MaxUnits = 16;
+		static constexpr uint32_t MaxLayersPerPage = 256;
+
+		// ɫ̶ڵ0Ԫĵ0㣬 0
+		void SetWhiteTexture(const Ref<Texture2D>& texture);
+
+		// ʼΣҳԪĶӦϵ
+		void Reset();
+
+		// رοõԪʱ -1ҪˢΣ
+		int32_t FindOrAdd(const Ref<Texture2D>& texture);
+
+		// õҳ󶨵ӦԪ
+		void BindAll() const;
+
+		// ͷҳ
+		void Clear();
+
+		uint32_t GetUnitCount() const { return m_UnitCount; }
+		uint32_t GetPageCount() const { return (uint32_t)m_Pages.size(); }
+		uint32_t GetResidentCount() const { return (uint32_t)m_Residents.size(); }
+
+	private:
+		struct Page
+		{
+			Ref<Texture2DArray> Array;
+			uint32_t LayerCount = 0; // ʹõĲ
+			std::vector<uint32_t> FreeLayers; // ٺճĲ
+			uint32_t Unit = 0;
+			uint32_t Generation = 0; //  m_Generation ͬʾѰ
+		};
+
+		struct Residency
+		{
+			const Texture2D* Texture = nullptr;
+			std::weak_ptr<Texture2D> Handle; // жǷ٣RendererID ܱã
+			uint32_t Page = 0;
+			uint32_t Layer = 0;
+			uint32_t Revision = 0; // Ƶʱ Texture::GetRevision()ͬʱҪ¸
+		};
+
+		Residency Allocate(const Ref<Texture2D>& texture);
+
+	private:
+		std::vector<Page> m_Pages;
+		std::unordered_map<uint32_t, Residency> m_Residents; // RendererID -> ڵҳͲ
+
+		std::array<uint32_t, MaxUnits> m_UnitPages;
+		uint32_t m_UnitCount = 0;
+		uint32_t m_Generation = 1;
+
+		Ref<Texture2D> m_WhiteTexture;
+	};
+}
@@ -0,0 +1,302 @@
+#include "hzpch.h"
+#include "TextureAtlas.h"
+
+#include <stb_image.h>
+
+#include <deque>
+
+namespace Hazel
+{
+	// Skyline װ䣺¼ռߣ¾ηʹ䶥͵λãbottom-left
+	class SkylinePacker
+	{
+	public:
+		SkylinePacker(uint32_t width, uint32_t height)
+			: m_Width((int32_t)width), m_Height((int32_t)height)
+		{
+			m_Nodes.push_back({ 0, 0, m_Width });
+		}
+
+		bool Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+		{
+			int32_t bestIndex = -1, bestTop = INT32_MAX, bestWidth = INT32_MAX, bestY = 0;
+			for (int32_t i = 0; i < (int32_t)m_Nodes.size(); i++)
+			{
+				int32_t fitY;
+				if (!Fit(i, (int32_t)width, (int32_t)height, fitY))
+					continue;
+
+				// ͬʱѡխ߶ΣƬ
+				int32_t top = fitY + (int32_t)height;
+				if (top < bestTop || (top == bestTop && m_Nodes[i].Width < bestWidth))
+				{
+					bestIndex = i;
+					bestTop = top;
+					bestWidth = m_Nodes[i].Width;
+					bestY = fitY;
+				}
+			}
+
+			if (bestIndex < 0)
+				return false;
+
+			x = (uint32_t)m_Nodes[bestIndex].X;
+			y = (uint32_t)bestY;
+			AddNode(bestIndex, { (int32_t)x, bestTop, (int32_t)width });
+			return true;
+		}
+
+	private:
+		struct Node
+		{
+			int32_t X, Y, Width;
+		};
+
+		// Ե index Ϊ˷þʱĵױ߸߶
+		bool Fit(int32_t index, int32_t width, int32_t height, int32_t& y) const
+		{
+			if (m_Nodes[index].X + width > m_Width)
+				return false;
+
+			y = m_Nodes[index].Y;
+			int32_t remaining = width;
+			for (int32_t i = index; remaining > 0; i++)
+			{
+				y = std::max(y, m_Nodes[i].Y);
+				if (y + height > m_Height)
+					return false;
+				remaining -= m_Nodes[i].Width;
+			}
+			return true;
+		}
+
+		void AddNode(int32_t index, const Node& node)
+		{
+			m_Nodes.insert(m_Nodes.begin() + index, node);
+
+			// õ߶θǵĲ
+			for (size_t i = index + 1; i < m_Nodes.size();)
+			{
+				const Node& previous = m_Nodes[i - 1];
+				Node& current = m_Nodes[i];
+				int32_t overlap = previous.X + previous.Width - current.X;
+				if (overlap <= 0)
+					break;
+
+				if (current.Width <= overlap)
+				{
+					m_Nodes.erase(m_Nodes.begin() + i);
+					continue;
+				}
+				current.X += overlap;
+				current.Width -= overlap;
+				break;
+			}
+
+			// ϲڵĵȸ߶
+			for (size_t i = 0; i + 1 < m_Nodes.size();)
+			{
+				if (m_Nodes[i].Y == m_Nodes[i + 1].Y)
+				{
+					m_Nodes[i].Width += m_Nodes[i + 1].Width;
+					m_Nodes.erase(m_Nodes.begin() + i + 1);
+				}
+				else
+					i++;
+			}
+		}
+
+	private:
+		int32_t m_Width, m_Height;
+		std::vector<Node> m_Nodes;
+	};
+
+	struct TextureAtlasData
+	{
+		struct Page
+		{
+			Ref<Texture2D> Texture;
+			SkylinePacker Packer;
+			bool Dirty = false; // µд룬Ҫ mipmap
+		};
+
+		struct Entry
+		{
+			const Texture2D* Texture = nullptr;
+			std::weak_ptr<Texture2D> Handle; // жǷ٣RendererID ܱã
+			Ref<SubTexture2D> SubTexture; // Ŷл򲻽ͼʱΪ
+		};
+
+		bool Enabled = true;
+		std::vector<Page> Pages;
+		std::unordered_map<uint32_t, Entry> Entries; // RendererID -> ͼеλ
+		std::deque<std::weak_ptr<Texture2D>> Queue;
+		uint32_t SpriteCount = 0;
+
+		const Ref<SubTexture2D> None;
+	};
+	static TextureAtlasData s_AtlasData;
+
+	static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	void TextureAtlas::SetEnabled(bool enabled)
+	{
+		s_AtlasData.Enabled = enabled;
+	}
+
+	bool TextureAtlas::IsEnabled()
+	{
+		return s_AtlasData.Enabled;
+	}
+
+	const Ref<SubTexture2D>& TextureAtlas::Get(const Ref<Texture2D>& texture)
+	{
+		if (!s_AtlasData.Enabled)
+			return s_AtlasData.None;
+
+		auto it = s_AtlasData.Entries.find(texture->GetRendererID());
+		if (it != s_AtlasData.Entries.end() && it->second.Texture == texture.get() && !it->second.Handle.expired())
+			return it->second.SubTexture;
+
+		// һ󣨻ͬһ RendererID ٵǼǲŶ
+		// ͼռõ򲻻գClear ´
+		TextureAtlasData::Entry& entry = s_AtlasData.Entries[texture->GetRendererID()];
+		if (entry.SubTexture)
+			s_AtlasData.SpriteCount--;
+		entry.Texture = texture.get();
+		entry.Handle = texture;
+		entry.SubTexture = nullptr;
+
+		// ͼҪļ¶ȡأֻܴļصС
+		if (texture->IsLoaded() && !texture->GetPath().empty()
+			&& texture->GetWidth() <= MaxSpriteSize && texture->GetHeight() <= MaxSpriteSize)
+			s_AtlasData.Queue.push_back(texture);
+
+		return s_AtlasData.None;
+	}
+
+	// ܸ Padding صıԵԹ˺ mipmap ߽ʱõǱԵɫ
+	static std::vector<uint32_t> ExtrudeEdges(const uint32_t* pixels, uint32_t width, uint32_t height)
+	{
+		const uint32_t padding = TextureAtlas::Padding;
+		uint32_t paddedWidth = width + padding * 2;
+		uint32_t paddedHeight = height + padding * 2;
+
+		std::vector<uint32_t> padded(paddedWidth * paddedHeight);
+		for (uint32_t y = 0; y < paddedHeight; y++)
+		{
+			uint32_t srcY = (uint32_t)std::clamp((int32_t)y - (int32_t)padding, 0, (int32_t)height - 1);
+			const uint32_t* srcRow = pixels + srcY * width;
+			uint32_t* dstRow = padded.data() + y * paddedWidth;
+
+			for (uint32_t x = 0; x < padding; x++)
+			{
+				dstRow[x] = srcRow[0];
+				dstRow[padding + width + x] = srcRow[width - 1];
+			}
+			memcpy(dstRow + padding, srcRow, width * sizeof(uint32_t));
+		}
+		return padded;
+	}
+
+	static bool Pack(const Ref<Texture2D>& texture)
+	{
+		//  OpenGLTexture2D ļطʽһ£·תͳһչ RGBA8
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* data = stbi_load(texture->GetPath().c_str(), &width, &height, &channels, 4);
+		if (!data)
+		{
+			HZ_CORE_WARN("TextureAtlas: failed to load '{0}'", texture->GetPath());
+			return false;
+		}
+
+		//  Padding 룬֤ÿһ mipmap 
+		const uint32_t padding = TextureAtlas::Padding;
+		uint32_t cellWidth = AlignUp((uint32_t)width + padding * 2, padding);
+		uint32_t cellHeight = AlignUp((uint32_t)height + padding * 2, padding);
+
+		uint32_t x = 0, y = 0;
+		size_t pageIndex = 0;
+		for (; pageIndex < s_AtlasData.Pages.size(); pageIndex++)
+		{
+			if (s_AtlasData.Pages[pageIndex].Packer.Insert(cellWidth, cellHeight, x, y))
+				break;
+		}
+
+		// ҳŲʱ½һҳ
+		if (pageIndex == s_AtlasData.Pages.size())
+		{
+			TextureAtlasData::Page page{ Texture2D::Create(TextureAtlas::PageSize, TextureAtlas::PageSize, TextureAtlas::MipLevels),
+				SkylinePacker(TextureAtlas::PageSize, TextureAtlas::PageSize) };
+			page.Packer.Insert(cellWidth, cellHeight, x, y);
+			s_AtlasData.Pages.push_back(std::move(page));
+		}
+
+		TextureAtlasData::Page& page = s_AtlasData.Pages[pageIndex];
+		std::vector<uint32_t> padded = ExtrudeEdges((const uint32_t*)data, (uint32_t)width, (uint32_t)height);
+		page.Texture->SetSubData(padded.data(), x, y, (uint32_t)width + padding * 2, (uint32_t)height + padding * 2);
+		page.Dirty = true;
+		stbi_image_free(data);
+
+		glm::vec2 min = glm::vec2(x + padding, y + padding) / (float)TextureAtlas::PageSize;
+		glm::vec2 max = glm::vec2(x + padding + width, y + padding + height) / (float)TextureAtlas::PageSize;
+		TextureAtlasData::Entry& entry = s_AtlasData.Entries[texture->GetRendererID()];
+		entry.SubTexture = CreateRef<SubTexture2D>(page.Texture, min, max, texture->HasTranslucency());
+		s_AtlasData.SpriteCount++;
+		return true;
+	}
+
+	void TextureAtlas::Update()
+	{
+		uint32_t uploads = 0;
+		while (!s_AtlasData.Queue.empty() && uploads < MaxUploadsPerUpdate)
+		{
+			Ref<Texture2D> texture = s_AtlasData.Queue.front().lock();
+			s_AtlasData.Queue.pop_front();
+
+			// Ŷڼ䱻ٵֱӶ
+			auto it = texture ? s_AtlasData.Entries.find(texture->GetRendererID()) : s_AtlasData.Entries.end();
+			if (it == s_AtlasData.Entries.end() || it->second.Texture != texture.get())
+				continue;
+
+			if (Pack(texture))
+				uploads++;
+		}
+
+		for (TextureAtlasData::Page& page : s_AtlasData.Pages)
+		{
+			if (page.Dirty)
+			{
+				page.Texture->GenerateMipmaps();
+				page.Dirty = false;
+			}
+		}
+	}
+
+	void TextureAtlas::Clear()
+	{
+		s_AtlasData.Pages.clear();
+		s_AtlasData.Entries.clear();
+		s_AtlasData.Queue.clear();
+		s_AtlasData.SpriteCount = 0;
+	}
+
+	uint32_t TextureAtlas::GetPageCount()
+	{
+		return (uint32_t)s_AtlasData.Pages.size();
+	}
+
+	uint32_t TextureAtlas::GetSpriteCount()
+	{
+		return s_AtlasData.SpriteCount;
+	}
+
+	uint32_t TextureAtlas::GetPendingCount()
+	{
+		return (uint32_t)s_AtlasData.Queue.size();
+	}
+}
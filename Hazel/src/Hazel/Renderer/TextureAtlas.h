@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Hazel/Renderer/SubTexture2D.h"
+
+namespace Hazel
+{
+	// ʱͼѴļصС PageSize x PageSize ͼҳƽ̵ľΪͼ
+	// һαʱУUpdate ʱ𲽴ϴһ֡ڴȫ
+	// ÿܸ Padding صıԵ Padding 룬MipLevels  mipmap ڲڵ
+	class TextureAtlas
+	{
+	public:
+		static constexpr uint32_t PageSize = 2048;
+		static constexpr uint32_t MaxSpriteSize = 512; // ֵ߳ͼ
+		static constexpr uint32_t Padding = 4;
+		static constexpr uint32_t MipLevels = 3; // 2^(MipLevels - 1) <= Padding
+		static constexpr uint32_t MaxUploadsPerUpdate = 16;
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		// ͼеδʺϴʱؿգʱӦֱʹԭ
+		static const Ref<SubTexture2D>& Get(const Ref<Texture2D>& texture);
+
+		// еϴÿ֡һ
+		static void Update();
+
+		// ͷͼҳѴ´ʱŶ
+		static void Clear();
+
+		static uint32_t GetPageCount();
+		static uint32_t GetSpriteCount();
+		static uint32_t GetPendingCount();
+	};
+}
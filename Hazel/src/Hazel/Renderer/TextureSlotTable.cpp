@@ -0,0 +1,52 @@
+#include "hzpch.h"
+#include "TextureSlotTable.h"
+
+namespace Hazel
+{
+	void TextureSlotTable::Reset()
+	{
+		m_Count = 1;
+		m_Generation++;
+
+		// κŻʱĿܱΪЧһ
+		if (m_Generation == 0)
+		{
+			m_Entries.fill(Entry());
+			m_Generation = 1;
+		}
+	}
+
+	int32_t TextureSlotTable::FindOrAdd(const Ref<Texture2D>& texture)
+	{
+		uint32_t rendererID = texture->GetRendererID();
+
+		// Fibonacci ϣȡλΪʼλã̽
+		uint32_t index = (rendererID * 2654435769u) >> 26;
+		while (true)
+		{
+			Entry& entry = m_Entries[index];
+			if (entry.Generation != m_Generation)
+			{
+				if (m_Count >= MaxSlots)
+					return -1;
+
+				entry.RendererID = rendererID;
+				entry.Slot = m_Count;
+				entry.Generation = m_Generation;
+				m_Slots[m_Count] = texture;
+				return (int32_t)m_Count++;
+			}
+
+			if (entry.RendererID == rendererID)
+				return (int32_t)entry.Slot;
+
+			index = (index + 1) & (TableSize - 1);
+		}
+	}
+
+	void TextureSlotTable::BindAll() const
+	{
+		for (uint32_t i = 0; i < m_Count; i++)
+			m_Slots[i]->Bind(i);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel
+{
+	// ÿελ0Ųλ̶Ϊɫ
+	//  RendererID ΪĿѰַϣ/Ϊ O(1)ÿĿκţReset ֻκ
+	class TextureSlotTable
+	{
+	public:
+		static constexpr uint32_t MaxSlots = 32;
+
+		void SetWhiteTexture(const Ref<Texture2D>& texture) { m_Slots[0] = texture; }
+
+		// ʼΣճɫвλ
+		void Reset();
+
+		// ڵĲλδ²λλʱ -1ҪˢΣ
+		int32_t FindOrAdd(const Ref<Texture2D>& texture);
+
+		uint32_t GetCount() const { return m_Count; }
+		const Ref<Texture2D>& GetSlot(uint32_t index) const { return m_Slots[index]; }
+
+		// õ󶨵ӦԪ
+		void BindAll() const;
+
+	private:
+		static constexpr uint32_t TableSize = MaxSlots * 2; // 2ݣӲ 0.5
+
+		struct Entry
+		{
+			uint32_t RendererID = 0;
+			uint32_t Slot = 0;
+			uint32_t Generation = 0; //  m_Generation ͬʾĿ
+		};
+
+		std::array<Ref<Texture2D>, MaxSlots> m_Slots;
+		std::array<Entry, TableSize> m_Entries;
+		uint32_t m_Count = 1;
+		uint32_t m_Generation = 1;
+	};
+}
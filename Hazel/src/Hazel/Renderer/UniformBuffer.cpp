@@ -0,0 +1,24 @@
+#include "hzpch.h"
+#include "UniformBuffer.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+namespace Hazel
+{
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None: HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported! ")
+			return nullptr;
+		case RendererAPI::API::OpenGL:
+			return CreateRef<OpenGLUniformBuffer>(size, binding);
+		case RendererAPI::API::DirectX: HZ_CORE_ASSERT(false, "RendererAPI::DirectX is currently not supported! ")
+			return nullptr;
+		}
+
+		HZ_CORE_ASSERT(false, "UnKnown RendererAPI!");
+		return nullptr;
+	}
+}
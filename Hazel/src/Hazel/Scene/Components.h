@@ -4,6 +4,7 @@
 #include "Hazel/Core/UUID.h"
 #include "Hazel/Renderer/Texture.h"
 #include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Renderer/Font.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -54,12 +55,35 @@ namespace Hazel
 		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
 		Ref<Texture2D> Texture;
 		float TilingFactor = 1.0f;
+		bool Static = false; // ̬Ķ㳣פGPUֻб仯ʱؽ
 
 		SpriteRendererComponent() = default;
 		SpriteRendererComponent(const SpriteRendererComponent&) = default;
 		SpriteRendererComponent(const glm::vec4& color) : Color(color) {}
 	};
 
+	struct CircleRendererComponent
+	{
+		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
+		float Thickness = 1.0f; // ռ뾶ı1 ΪʵԲ
+		float Fade = 0.005f;	// Ե𻯿
+
+		CircleRendererComponent() = default;
+		CircleRendererComponent(const CircleRendererComponent&) = default;
+	};
+
+	struct TextComponent
+	{
+		std::string TextString;
+		Ref<Font> FontAsset = Font::GetDefault();
+		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
+		float Kerning = 0.0f;		// ־ࣨem
+		float LineSpacing = 0.0f;	// оࣨem
+
+		TextComponent() = default;
+		TextComponent(const TextComponent&) = default;
+	};
+
 	struct MeshFilterComponent
 	{
 		enum class GeometryType
@@ -70,6 +94,7 @@ namespace Hazel
 		};
 		GeometryType GType = GeometryType::Cube;
 		Ref<Mesh> MeshObj = MeshLibrary::GetCubeMesh();
+		std::string MeshPath; // Custom  MeshImporter ļ
 
 		MeshFilterComponent() = default;
 		MeshFilterComponent(const MeshFilterComponent&) = default;
@@ -81,9 +106,11 @@ namespace Hazel
 			{
 			case GeometryType::Cube:
 				MeshObj = MeshLibrary::GetCubeMesh();
+				MeshPath.clear();
 				break;
 			case GeometryType::Sphere:
 				MeshObj = MeshLibrary::GetSphereMesh();
+				MeshPath.clear();
 				break;
 			case GeometryType::Custom:
 				break;
@@ -98,6 +125,7 @@ namespace Hazel
 		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
 		Ref<Texture2D> Texture;
 		float TilingFactor = 1.0f;
+		bool Occluder = false; // դCPUڵ壬ڵʺǽȴ򵥵
 
 		MeshRendererComponent() = default;
 		MeshRendererComponent(const MeshRendererComponent&) = default;
@@ -172,7 +200,7 @@ namespace Hazel
 	};
 
 	using AllComponents =
-		ComponentGroup<TransformComponent, SpriteRendererComponent,
+		ComponentGroup<TransformComponent, SpriteRendererComponent, CircleRendererComponent, TextComponent,
 		MeshFilterComponent, MeshRendererComponent,
 		CameraComponent, ScriptComponent, NativeScriptComponent,
 		Rigidbody2DComponent, BoxCollider2DComponent>;
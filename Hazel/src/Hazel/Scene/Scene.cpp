@@ -7,7 +7,9 @@
 #include "Hazel/Renderer/Renderer2D.h"
 #include "Hazel/Renderer/Renderer3D.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/RenderStats.h"
 #include "Hazel/Renderer/Mesh.h"
+#include "Hazel/Renderer/OcclusionCuller.h"
 
 // Box2D
 #include "box2d/b2_world.h"
@@ -147,12 +149,82 @@ namespace Hazel
 		for (auto child : tf.Children)
 			DestroyEntity({ m_EntityMap.at(child), this });
 
+		DestroyMeshProxy(entity);
+
 		// ɾи壬ҪӸɾ
 		entity.UnBindParent();
 		m_EntityMap.erase(entity.GetUUID());
 		m_Registry.destroy(entity);
 	}
 
+	void Scene::QueryAABB(const Math::AABB& box, std::vector<Entity>& result)
+	{
+		m_MeshTree.Query(box, [&](uint32_t userData)
+			{
+				result.push_back({ (entt::entity)userData, this });
+				return true;
+			});
+	}
+
+	void Scene::QueryFrustum(const Math::Frustum& frustum, std::vector<Entity>& result)
+	{
+		m_MeshTree.Query(frustum, [&](uint32_t userData)
+			{
+				result.push_back({ (entt::entity)userData, this });
+				return true;
+			});
+	}
+
+	// ߱任ģͿռβԣ任ı߲ tоռ
+	static bool RaycastMesh(const Mesh& mesh, const glm::mat4& transform, const Math::Ray& ray, float maxDistance, float& distance)
+	{
+		glm::mat4 inverse = glm::inverse(transform);
+		Math::Ray localRay(glm::vec3(inverse * glm::vec4(ray.Origin, 1.0f)), glm::vec3(inverse * glm::vec4(ray.Direction, 0.0f)));
+
+		const std::vector<glm::vec4>& vertices = mesh.GetVertices();
+		const std::vector<uint32_t>& indices = mesh.GetIndices();
+		bool hit = false;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			float t;
+			if (localRay.Intersects(glm::vec3(vertices[indices[i]]), glm::vec3(vertices[indices[i + 1]]), glm::vec3(vertices[indices[i + 2]]), t)
+				&& t < maxDistance)
+			{
+				maxDistance = t;
+				hit = true;
+			}
+		}
+		if (hit)
+			distance = maxDistance;
+		return hit;
+	}
+
+	Entity Scene::Raycast(const Math::Ray& ray, float maxDistance, float* hitDistance)
+	{
+		Math::Ray worldRay(ray.Origin, glm::normalize(ray.Direction));
+		entt::entity hitEntity = entt::null;
+		float closest = maxDistance;
+		m_MeshTree.Raycast(worldRay, maxDistance, [&](uint32_t userData, float distanceLimit)
+			{
+				entt::entity entity = (entt::entity)userData;
+				auto [transform, mfc] = m_Registry.get<TransformComponent, MeshFilterComponent>(entity);
+				float distance;
+				if (!RaycastMesh(*mfc.MeshObj, transform.WorldTransform, worldRay, distanceLimit, distance))
+					return distanceLimit;
+
+				hitEntity = entity;
+				closest = distance;
+				return distance;
+			});
+
+		if (hitEntity == entt::null)
+			return {};
+
+		if (hitDistance)
+			*hitDistance = closest;
+		return { hitEntity, this };
+	}
+
 	void Scene::OnRuntimeStart()
 	{
 		OnPhysics2DStart();
@@ -250,44 +322,20 @@ namespace Hazel
 			switch (Renderer::s_RendererMode)
 			{
 			case Renderer::Mode::Renderer2D:
-			{
-				auto view = m_Registry.view<TransformComponent>();
-				for (auto entity : view)
-				{
-					auto& transform = view.get<TransformComponent>(entity);
-					if (transform.Parent != 0)
-						continue;
-					ProcessTree2D(transform, entity);
-				}
+				RenderScene2D(mainCamera->GetProjection() * glm::inverse(cameraTransform));
 				break;
-			}
 			case Renderer::Mode::Renderer3D:
-			{
-				for (auto& [_, rrifs] : m_BatchGroups)
-					rrifs.clear();
-				//auto group = m_Registry.group<TransformComponent>(entt::get<MeshRendererComponent>);
-				auto view = m_Registry.view<TransformComponent>();
-				for (auto entity : view)
-				{
-					auto& transform = view.get<TransformComponent>(entity);
-					if (transform.Parent != 0)
-						continue;
-					ProcessTree3D(transform, entity);
-				}
-				for (auto& [_, rrifs] : m_BatchGroups) // ƿɺ
-				{
-					for (auto& rrif : rrifs)
-					{
-						Renderer::Draw(rrif.transform, rrif.mfc, rrif.mrc, rrif.entity);
-					}
-				}
+				RenderScene3D(mainCamera->GetProjection() * glm::inverse(cameraTransform));
 				break;
-			}
 			default:
 				break;
 			}
 			Renderer::EndScene();
 		}
+
+		// űύĵͼԪֻһ֡
+		m_DebugLines.clear();
+		m_DebugCircles.clear();
 	}
 
 	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
@@ -296,40 +344,11 @@ namespace Hazel
 		switch (Renderer::s_RendererMode)
 		{
 		case Renderer::Mode::Renderer2D:
-		{
-			auto view = m_Registry.view<TransformComponent>();
-			for (auto entity : view)
-			{
-				auto& transform = view.get<TransformComponent>(entity);
-				if (transform.Parent != 0)
-					continue;
-				ProcessTree2D(transform, entity);
-			}
+			RenderScene2D(camera.GetViewProjection());
 			break;
-		}
 		case Renderer::Mode::Renderer3D:
-		{
-			for (auto& [_, rrifs] : m_BatchGroups)
-				rrifs.clear();
-			
-			//auto group = m_Registry.group<TransformComponent>(entt::get<MeshRendererComponent>);
-			auto view = m_Registry.view<TransformComponent>();
-			for (auto entity : view)
-			{
-				auto& transform = view.get<TransformComponent>(entity);
-				if (transform.Parent != 0)
-					continue;
-				ProcessTree3D(transform, entity);
-			}
-			for (auto& [_, rrifs] : m_BatchGroups) // ƿɺ
-			{
-				for (auto& rrif : rrifs)
-				{
-					Renderer::Draw(rrif.transform, rrif.mfc, rrif.mrc, rrif.entity);
-				}
-			}
+			RenderScene3D(camera.GetViewProjection());
 			break;
-		}
 		default:
 			break;
 		}
@@ -449,6 +468,14 @@ namespace Hazel
 	{
 	}
 	template<>
+	void Scene::OnComponentAdded<CircleRendererComponent>(Entity entity, CircleRendererComponent& component)
+	{
+	}
+	template<>
+	void Scene::OnComponentAdded<TextComponent>(Entity entity, TextComponent& component)
+	{
+	}
+	template<>
 	void Scene::OnComponentAdded<MeshRendererComponent>(Entity entity, MeshRendererComponent& component)
 	{
 	}
@@ -469,6 +496,60 @@ namespace Hazel
 	{
 	}
 
+	void Scene::RenderScene2D(const glm::mat4& viewProjection)
+	{
+		m_SpriteNodes.clear();
+		m_StaticSpritePackets.clear();
+		m_CirclePackets.clear();
+		m_TextPackets.clear();
+		auto view = m_Registry.view<TransformComponent>();
+		for (auto entity : view)
+		{
+			auto& transform = view.get<TransformComponent>(entity);
+			if (transform.Parent != 0)
+				continue;
+			ProcessTree2D(transform, entity);
+		}
+		CullSprites2D(viewProjection);
+		Renderer::DrawStaticSprites(m_StaticSpritePackets); // ֻؽб仯ĳפ
+		Renderer::DrawSprites(m_SpritePackets); // ̳߳в
+
+		// ԲΡ߶ΡָԳEndScene ʱͳһύ
+		for (const CircleDrawPacket& packet : m_CirclePackets)
+			Renderer::DrawCircle(packet.Transform, packet.Circle->Color, packet.Circle->Thickness, packet.Circle->Fade, packet.EntityID);
+		for (const TextDrawPacket& packet : m_TextPackets)
+			Renderer::DrawString(packet.Text->TextString, packet.Text->FontAsset, packet.Transform, packet.Text->Color,
+				packet.Text->Kerning, packet.Text->LineSpacing, packet.EntityID);
+
+		for (const DebugCircle& circle : m_DebugCircles)
+			Renderer::DrawCircle(circle.Transform, circle.Color, circle.Thickness, circle.Fade);
+		for (const DebugLine& line : m_DebugLines)
+			Renderer::DrawLine(line.P0, line.P1, line.Color);
+
+		if (m_ShowPhysicsColliders)
+		{
+			auto colliders = m_Registry.view<TransformComponent, BoxCollider2DComponent>();
+			for (auto entity : colliders)
+			{
+				auto [transform, bc2d] = colliders.get<TransformComponent, BoxCollider2DComponent>(entity);
+				glm::mat4 colliderTransform = transform.WorldTransform
+					* glm::translate(glm::mat4(1.0f), glm::vec3(bc2d.Offset, 0.001f))
+					* glm::scale(glm::mat4(1.0f), glm::vec3(bc2d.Size * 2.0f, 1.0f));
+				Renderer::DrawRect(colliderTransform, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+			}
+		}
+	}
+
+	void Scene::DrawDebugLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color)
+	{
+		m_DebugLines.push_back({ p0, p1, color });
+	}
+
+	void Scene::DrawDebugCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade)
+	{
+		m_DebugCircles.push_back({ transform, color, thickness, fade });
+	}
+
 	void Scene::ProcessTree2D(TransformComponent& transform, entt::entity& entity)
 	{
 		// ڵ任Ǳر任Ǹڵ任Ϊڵ任Լıر任
@@ -480,17 +561,75 @@ namespace Hazel
 		else
 			transform.WorldTransform = transform.LocalTransform();
 
-		// ʵSpriteRendererһ
+		// ʵSpriteRendererһ̬ʹóפ壬޳
+		uint32_t index = (uint32_t)m_SpriteNodes.size();
+		m_SpriteNodes.push_back({});
 		if (m_Registry.all_of<SpriteRendererComponent>(entity))
 		{
-			auto src = m_Registry.get<SpriteRendererComponent>(entity);
-			Renderer::Draw(transform, src, entity);
+			auto& src = m_Registry.get<SpriteRendererComponent>(entity);
+			if (src.Static)
+				m_StaticSpritePackets.push_back({ transform.WorldTransform, &src, (int)entity });
+			else
+			{
+				static const Math::AABB quadBounds = { { -0.5f, -0.5f, 0.0f }, { 0.5f, 0.5f, 0.0f } };
+				SpriteNode& node = m_SpriteNodes[index];
+				node.Packet = { transform.WorldTransform, &src, (int)entity };
+				node.Bounds = quadBounds.Transform(transform.WorldTransform);
+				node.SpriteCount = 1;
+			}
 		}
+		if (m_Registry.all_of<CircleRendererComponent>(entity))
+			m_CirclePackets.push_back({ transform.WorldTransform, &m_Registry.get<CircleRendererComponent>(entity), (int)entity });
+		if (m_Registry.all_of<TextComponent>(entity))
+			m_TextPackets.push_back({ transform.WorldTransform, &m_Registry.get<TextComponent>(entity), (int)entity });
 		for (auto& child : transform.Children)
 		{
 			auto& childTransform = m_Registry.get<TransformComponent>(m_EntityMap.at(child));
 			ProcessTree2D(childTransform, m_EntityMap.at(child));
 		}
+
+		// ӽڵ㴦ٺϲΧУݹ m_SpriteNodes ݣǰã
+		SpriteNode& node = m_SpriteNodes[index];
+		node.SubtreeEnd = (uint32_t)m_SpriteNodes.size();
+		node.SubtreeBounds = node.Bounds;
+		for (uint32_t i = index + 1; i < node.SubtreeEnd; i = m_SpriteNodes[i].SubtreeEnd)
+		{
+			node.SubtreeBounds.Merge(m_SpriteNodes[i].SubtreeBounds);
+			node.SpriteCount += m_SpriteNodes[i].SpriteCount;
+		}
+	}
+
+	void Scene::CullSprites2D(const glm::mat4& viewProjection)
+	{
+		Math::Frustum frustum(viewProjection);
+		uint32_t culled = 0;
+
+		m_SpritePackets.clear();
+		for (uint32_t i = 0; i < (uint32_t)m_SpriteNodes.size();)
+		{
+			const SpriteNode& node = m_SpriteNodes[i];
+
+			// ׶⣨ûо飩ʱȫ
+			if (!frustum.Intersects(node.SubtreeBounds))
+			{
+				culled += node.SpriteCount;
+				i = node.SubtreeEnd;
+				continue;
+			}
+
+			if (!node.Bounds.IsEmpty())
+			{
+				if (frustum.Intersects(node.Bounds))
+					m_SpritePackets.push_back(node.Packet);
+				else
+					culled++;
+			}
+			i++;
+		}
+
+		RenderStats* stats = Renderer::GetStats();
+		stats->CulledCount += culled;
+		stats->SubmittedCount += (uint32_t)(m_SpritePackets.size() + m_StaticSpritePackets.size());
 	}
 
 	void Scene::ProcessTree3D(TransformComponent& transform, entt::entity& entity)
@@ -507,16 +646,14 @@ namespace Hazel
 		// ʵMeshFilterMeshRendererһ
 		if (m_Registry.all_of<MeshFilterComponent, MeshRendererComponent>(entity))
 		{
-			auto [mfc, mrc] = m_Registry.get<MeshFilterComponent, MeshRendererComponent>(entity);
-			Mesh* meshptr = mfc.MeshObj.get();
+			auto& mfc = m_Registry.get<MeshFilterComponent>(entity);
 			switch (mfc.MeshObj->GetMeshType())
 			{
-			case MeshType::StaticBatchable:
-			{
-				auto meshptr = mfc.MeshObj.get();
-				m_BatchGroups[meshptr].emplace_back(transform, mfc, mrc, entity);
+			case MeshType::StaticBatchable: // ΧнΧǷ׶ѯ
+				UpdateMeshProxy(entity, mfc.MeshObj->GetBounds().Transform(transform.WorldTransform));
+				if (m_Registry.get<MeshRendererComponent>(entity).Occluder)
+					m_Occluders.push_back(entity);
 				break;
-			}
 			case MeshType::StaticUnique: // δֱӵȾ
 				break;
 			case MeshType::SkinnedMesh:
@@ -531,4 +668,109 @@ namespace Hazel
 			ProcessTree3D(childTransform, m_EntityMap.at(child));
 		}
 	}
+
+	void Scene::RenderScene3D(const glm::mat4& viewProjection)
+	{
+		m_MeshTreeFrame++;
+		m_Occluders.clear();
+		auto view = m_Registry.view<TransformComponent>();
+		for (auto entity : view)
+		{
+			auto& transform = view.get<TransformComponent>(entity);
+			if (transform.Parent != 0)
+				continue;
+			ProcessTree3D(transform, entity);
+		}
+
+		// αûиµĴʵѲ
+		for (auto it = m_MeshProxies.begin(); it != m_MeshProxies.end();)
+		{
+			if (it->second.Frame != m_MeshTreeFrame)
+			{
+				m_MeshTree.DestroyProxy(it->second.Proxy);
+				it = m_MeshProxies.erase(it);
+			}
+			else
+				++it;
+		}
+
+		for (auto& [_, packets] : m_BatchGroups)
+			packets.clear();
+
+		// ׶ڵڵդCPUȻ壬֮׶ѯãŴģΧڵ
+		Math::Frustum frustum(viewProjection);
+		bool occlusion = OcclusionCuller::IsEnabled() && !m_Occluders.empty();
+		if (occlusion)
+		{
+			OcclusionCuller::Begin(viewProjection);
+			for (entt::entity entity : m_Occluders)
+			{
+				auto it = m_MeshProxies.find(entity); // ûжûд
+				if (it == m_MeshProxies.end() || !frustum.Intersects(m_MeshTree.GetBounds(it->second.Proxy)))
+					continue;
+
+				auto [transform, mfc] = m_Registry.get<TransformComponent, MeshFilterComponent>(entity);
+				OcclusionCuller::AddOccluder(transform.WorldTransform, *mfc.MeshObj);
+			}
+			OcclusionCuller::Rasterize();
+		}
+
+		uint32_t visible = 0, occluded = 0;
+		m_MeshTree.Query(frustum, [&](uint32_t userData)
+			{
+				entt::entity entity = (entt::entity)userData;
+				MeshProxy& proxy = m_MeshProxies.at(entity);
+				if (occlusion && OcclusionCuller::IsOccluded(m_MeshTree.GetBounds(proxy.Proxy)))
+				{
+					occluded++;
+					return true;
+				}
+
+				auto [transform, mfc, mrc] = m_Registry.get<TransformComponent, MeshFilterComponent, MeshRendererComponent>(entity);
+				proxy.LOD = Renderer3D::SelectLOD(*mfc.MeshObj, transform.WorldTransform, proxy.LOD);
+				m_BatchGroups[Mesh::GetLOD(mfc.MeshObj, proxy.LOD).get()].push_back({ transform.WorldTransform, &mfc, &mrc, (int)entity, proxy.LOD });
+				visible++;
+				return true;
+			});
+
+		m_MeshPackets.clear();
+		for (auto& [_, packets] : m_BatchGroups) // ƿɺ
+			m_MeshPackets.insert(m_MeshPackets.end(), packets.begin(), packets.end());
+
+		// GPU޳ʱȾͳͨ޳ʵ
+		RenderStats* stats = Renderer::GetStats();
+		stats->CulledCount += m_MeshTree.GetProxyCount() - visible - occluded;
+		stats->OccludedCount += occluded;
+		if (occlusion)
+			stats->OcclusionTime += OcclusionCuller::GetRasterTime();
+		if (Renderer3D::GetMeshSubmission() != Renderer3D::MeshSubmission::Instanced || !Renderer3D::IsGPUCullingEnabled())
+			stats->SubmittedCount += visible;
+
+		Renderer::DrawMeshes(m_MeshPackets); // ̳߳в
+	}
+
+	void Scene::UpdateMeshProxy(entt::entity entity, const Math::AABB& bounds)
+	{
+		// ûж񲻲ѯ
+		if (bounds.IsEmpty())
+			return;
+
+		auto [it, inserted] = m_MeshProxies.try_emplace(entity);
+		MeshProxy& proxy = it->second;
+		if (inserted)
+			proxy.Proxy = m_MeshTree.CreateProxy(bounds, (uint32_t)entity);
+		else
+			m_MeshTree.MoveProxy(proxy.Proxy, bounds); // ڷŴΧʱֻҶڵ
+		proxy.Frame = m_MeshTreeFrame;
+	}
+
+	void Scene::DestroyMeshProxy(entt::entity entity)
+	{
+		auto it = m_MeshProxies.find(entity);
+		if (it == m_MeshProxies.end())
+			return;
+
+		m_MeshTree.DestroyProxy(it->second.Proxy);
+		m_MeshProxies.erase(it);
+	}
 }
\ No newline at end of file
@@ -5,7 +5,10 @@
 #include "Hazel/Core/Timestep.h"
 #include "Hazel/Core/UUID.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Math/DynamicAABBTree.h"
 #include "Hazel/Scene/Components.h"
+#include "Hazel/Renderer/Renderer2D.h"
+#include "Hazel/Renderer/Renderer3D.h"
 
 class b2World;
 
@@ -36,6 +39,19 @@ namespace Hazel
 		Entity GetEntityByUUID(UUID uuid);
 		Entity GetPrimaryCameraEntity();
 
+		// ͼԪű OnUpdate ύڱ֡Ⱦʱ
+		void DrawDebugLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color);
+		void DrawDebugCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f);
+
+		void SetShowPhysicsColliders(bool show) { m_ShowPhysicsColliders = show; }
+		bool GetShowPhysicsColliders() const { return m_ShowPhysicsColliders; }
+
+		// 3DʵĿռѯʹһΣ3Dģʽ³ʱΧ
+		void QueryAABB(const Math::AABB& box, std::vector<Entity>& result);
+		void QueryFrustum(const Math::Frustum& frustum, std::vector<Entity>& result);
+		// еʵ壨βԣδʱؿʵ
+		Entity Raycast(const Math::Ray& ray, float maxDistance = std::numeric_limits<float>::max(), float* hitDistance = nullptr);
+
 	private:
 		void OnPhysics2DStart();
 		void OnPhysics2DStop();
@@ -43,31 +59,77 @@ namespace Hazel
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
 
+		void RenderScene2D(const glm::mat4& viewProjection);
 		void ProcessTree2D(TransformComponent& transform, entt::entity& entity);
+		void CullSprites2D(const glm::mat4& viewProjection);
+		void RenderScene3D(const glm::mat4& viewProjection);
 		void ProcessTree3D(TransformComponent& transform, entt::entity& entity);
+		void UpdateMeshProxy(entt::entity entity, const Math::AABB& bounds);
+		void DestroyMeshProxy(entt::entity entity);
 	private:
-		struct RenderRequiredInfos
-		{
-			TransformComponent transform;
-			MeshFilterComponent mfc;
-			MeshRendererComponent mrc;
-			entt::entity entity;
-
-			RenderRequiredInfos() = default;
-			RenderRequiredInfos(
-				TransformComponent& transform,
-				MeshFilterComponent& mfc,
-				MeshRendererComponent& mrc,
-				entt::entity& entity
-			) : transform(transform), mfc(mfc), mrc(mrc), entity(entity) {}
-		};
-
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
 		b2World* m_PhysicsWorld = nullptr;
 		std::unordered_map<UUID, entt::entity> m_EntityMap;
-		std::unordered_map<Mesh*, std::vector<RenderRequiredInfos>> m_BatchGroups;
+		std::unordered_map<Mesh*, std::vector<MeshDrawPacket>> m_BatchGroups; // ɼ񰴣LOD飬ͬһύ
+
+		// 3DʵΧ㼶ʱ
+		struct MeshProxy
+		{
+			int32_t Proxy;
+			uint32_t Frame; // һαʵ֡ʱɾڵĴ
+			uint32_t LOD = 0; // һλʱ LOD 
+		};
+		Math::DynamicAABBTree m_MeshTree;
+		std::unordered_map<entt::entity, MeshProxy> m_MeshProxies;
+		uint32_t m_MeshTreeFrame = 0;
+		std::vector<entt::entity> m_Occluders; // ֡ڵ
+		std::vector<SpriteDrawPacket> m_SpritePackets; // ֡ռĻƣһԽȾ
+		std::vector<SpriteDrawPacket> m_StaticSpritePackets; // Ϊ̬ľ飬ʹóפ㻺
+
+		// 2DʱչĲ㼶޳ʱ׶ֱ
+		struct SpriteNode
+		{
+			Math::AABB Bounds;			// ΧУûУ̬ʱΪ
+			Math::AABB SubtreeBounds;	// кİΧ
+			uint32_t SubtreeEnd;		// ֮һڵ±
+			uint32_t SpriteCount;		// еľ
+			SpriteDrawPacket Packet;
+		};
+		std::vector<SpriteNode> m_SpriteNodes;
+
+		struct CircleDrawPacket
+		{
+			glm::mat4 Transform;
+			const CircleRendererComponent* Circle;
+			int EntityID;
+		};
+		std::vector<CircleDrawPacket> m_CirclePackets;
+
+		struct TextDrawPacket
+		{
+			glm::mat4 Transform;
+			const TextComponent* Text;
+			int EntityID;
+		};
+		std::vector<TextDrawPacket> m_TextPackets;
+
+		struct DebugLine
+		{
+			glm::vec3 P0, P1;
+			glm::vec4 Color;
+		};
+		struct DebugCircle
+		{
+			glm::mat4 Transform;
+			glm::vec4 Color;
+			float Thickness, Fade;
+		};
+		std::vector<DebugLine> m_DebugLines;
+		std::vector<DebugCircle> m_DebugCircles;
+		bool m_ShowPhysicsColliders = false;
+		std::vector<MeshDrawPacket> m_MeshPackets;
 		std::string m_Name = "Untitled";
 
 		friend class Entity;
@@ -3,6 +3,7 @@
 
 #include "Entity.h"
 #include "Components.h"
+#include "Hazel/Renderer/MeshImporter.h"
 
 #include <fstream>
 
@@ -238,10 +239,38 @@ namespace Hazel
 			if (spriteRendererComponent.Texture)
 				out << YAML::Key << "TexturePath" << YAML::Value << spriteRendererComponent.Texture->GetPath();
 			out << YAML::Key << "TilingFactor" << YAML::Value << spriteRendererComponent.TilingFactor;
+			out << YAML::Key << "Static" << YAML::Value << spriteRendererComponent.Static;
 
 			out << YAML::EndMap; // SpriteRendererComponent
 		}
 
+		if (entity.HasComponent<CircleRendererComponent>())
+		{
+			out << YAML::Key << "CircleRendererComponent";
+			out << YAML::BeginMap; // CircleRendererComponent
+
+			auto& circleRendererComponent = entity.GetComponent<CircleRendererComponent>();
+			out << YAML::Key << "Color" << YAML::Value << circleRendererComponent.Color;
+			out << YAML::Key << "Thickness" << YAML::Value << circleRendererComponent.Thickness;
+			out << YAML::Key << "Fade" << YAML::Value << circleRendererComponent.Fade;
+
+			out << YAML::EndMap; // CircleRendererComponent
+		}
+
+		if (entity.HasComponent<TextComponent>())
+		{
+			out << YAML::Key << "TextComponent";
+			out << YAML::BeginMap; // TextComponent
+
+			auto& textComponent = entity.GetComponent<TextComponent>();
+			out << YAML::Key << "TextString" << YAML::Value << textComponent.TextString;
+			out << YAML::Key << "Color" << YAML::Value << textComponent.Color;
+			out << YAML::Key << "Kerning" << YAML::Value << textComponent.Kerning;
+			out << YAML::Key << "LineSpacing" << YAML::Value << textComponent.LineSpacing;
+
+			out << YAML::EndMap; // TextComponent
+		}
+
 		if (entity.HasComponent<MeshFilterComponent>())
 		{
 			out << YAML::Key << "MeshFilterComponent";
@@ -249,6 +278,8 @@ namespace Hazel
 
 			auto& meshFilterComponent = entity.GetComponent<MeshFilterComponent>();
 			out << YAML::Key << "GType" << YAML::Value << (int)meshFilterComponent.GType;
+			if (meshFilterComponent.GType == MeshFilterComponent::GeometryType::Custom)
+				out << YAML::Key << "MeshPath" << YAML::Value << meshFilterComponent.MeshPath;
 			out << YAML::Key << "MType" << YAML::Value << (int)meshFilterComponent.MeshObj->GetMeshType();
 
 			out << YAML::EndMap; // MeshFilterComponent
@@ -264,6 +295,7 @@ namespace Hazel
 			if (meshRendererComponent.Texture)
 				out << YAML::Key << "TexturePath" << YAML::Value << meshRendererComponent.Texture->GetPath();
 			out << YAML::Key << "TilingFactor" << YAML::Value << meshRendererComponent.TilingFactor;
+			out << YAML::Key << "Occluder" << YAML::Value << meshRendererComponent.Occluder;
 
 			out << YAML::EndMap; // MeshRendererComponent
 		}
@@ -404,6 +436,16 @@ namespace Hazel
 					int meshType = meshFilterComponent["MType"].as<int>();
 					auto& mfc = deserializedEntity.AddComponent<MeshFilterComponent>();
 					mfc.SetType((MeshFilterComponent::GeometryType)geometryType);
+					if (mfc.GType == MeshFilterComponent::GeometryType::Custom && meshFilterComponent["MeshPath"]
+						&& !meshFilterComponent["MeshPath"].as<std::string>().empty())
+					{
+						// к決ʱֱӳ仺棬Դļ
+						mfc.MeshPath = meshFilterComponent["MeshPath"].as<std::string>();
+						if (Ref<Mesh> mesh = MeshImporter::Load(mfc.MeshPath))
+							mfc.MeshObj = mesh;
+						else
+							HZ_CORE_WARN("Could not load mesh {0}", mfc.MeshPath);
+					}
 					mfc.MeshObj->SetMeshType((MeshType)meshType);
 				}
 
@@ -416,6 +458,8 @@ namespace Hazel
 						mrc.Texture = Texture2D::Create(meshRendererComponent["TexturePath"].as<std::string>());
 					if (meshRendererComponent["TilingFactor"])
 						mrc.TilingFactor = meshRendererComponent["TilingFactor"].as<float>();
+					if (meshRendererComponent["Occluder"])
+						mrc.Occluder = meshRendererComponent["Occluder"].as<bool>();
 				}
 
 				auto spriteRendererComponent = entity["SpriteRendererComponent"];
@@ -427,6 +471,27 @@ namespace Hazel
 						src.Texture = Texture2D::Create(spriteRendererComponent["TexturePath"].as<std::string>());
 					if (spriteRendererComponent["TilingFactor"])
 						src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
+					if (spriteRendererComponent["Static"])
+						src.Static = spriteRendererComponent["Static"].as<bool>();
+				}
+
+				auto circleRendererComponent = entity["CircleRendererComponent"];
+				if (circleRendererComponent)
+				{
+					auto& crc = deserializedEntity.AddComponent<CircleRendererComponent>();
+					crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
+					crc.Thickness = circleRendererComponent["Thickness"].as<float>();
+					crc.Fade = circleRendererComponent["Fade"].as<float>();
+				}
+
+				auto textComponent = entity["TextComponent"];
+				if (textComponent)
+				{
+					auto& tc = deserializedEntity.AddComponent<TextComponent>();
+					tc.TextString = textComponent["TextString"].as<std::string>();
+					tc.Color = textComponent["Color"].as<glm::vec4>();
+					tc.Kerning = textComponent["Kerning"].as<float>();
+					tc.LineSpacing = textComponent["LineSpacing"].as<float>();
 				}
 
 				auto rigidbody2DComponent = entity["Rigidbody2DComponent"];
@@ -101,6 +101,39 @@ namespace Hazel
 		return Input::IsKeyPressed(keycode);
 	}
 
+	static void Debug_DrawLine(glm::vec3* p0, glm::vec3* p1, glm::vec4* color)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene, "");
+		scene->DrawDebugLine(*p0, *p1, *color);
+	}
+
+	static void Debug_DrawRect(glm::vec3* center, glm::vec2* size, glm::vec4* color)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene, "");
+
+		glm::vec3 halfSize = { size->x * 0.5f, size->y * 0.5f, 0.0f };
+		glm::vec3 corners[4] = {
+			*center + glm::vec3(-halfSize.x, -halfSize.y, 0.0f),
+			*center + glm::vec3( halfSize.x, -halfSize.y, 0.0f),
+			*center + glm::vec3( halfSize.x,  halfSize.y, 0.0f),
+			*center + glm::vec3(-halfSize.x,  halfSize.y, 0.0f)
+		};
+		for (int i = 0; i < 4; i++)
+			scene->DrawDebugLine(corners[i], corners[(i + 1) % 4], *color);
+	}
+
+	static void Debug_DrawCircle(glm::vec3* center, float radius, glm::vec4* color, float thickness, float fade)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene, "");
+
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), *center)
+			* glm::scale(glm::mat4(1.0f), { radius * 2.0f, radius * 2.0f, 1.0f });
+		scene->DrawDebugCircle(transform, *color, thickness, fade);
+	}
+
 	template<typename... Component>
 	static void RegisterComponent()
 	{
@@ -149,5 +182,9 @@ namespace Hazel
 		HZ_ADD_INTERNAL_CALL(Rigidbody2DComponent_ApplyLinearImpulseToCenter);
 
 		HZ_ADD_INTERNAL_CALL(Input_IsKeyDown);
+
+		HZ_ADD_INTERNAL_CALL(Debug_DrawLine);
+		HZ_ADD_INTERNAL_CALL(Debug_DrawRect);
+		HZ_ADD_INTERNAL_CALL(Debug_DrawCircle);
 	}
 }
\ No newline at end of file
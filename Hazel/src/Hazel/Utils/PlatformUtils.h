@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <string>
 
 namespace Hazel 
@@ -17,4 +18,30 @@ namespace Hazel
 	public:
 		static float GetTime();
 	};
+
+	// ֻӳļӳڼļݿֱӰָ
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const std::filesystem::path& path) { Open(path); }
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// ļڻΪʱ false
+		bool Open(const std::filesystem::path& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return (const uint8_t*)m_Data; }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+		void* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
 }
\ No newline at end of file
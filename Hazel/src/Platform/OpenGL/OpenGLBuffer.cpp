@@ -44,14 +44,116 @@ namespace Hazel
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 	}
 
+	void OpenGLVertexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset) const
+	{
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	/* ===================StreamingVertexBuffer==================== */
+
+	OpenGLStreamingVertexBuffer::OpenGLStreamingVertexBuffer(uint32_t regionSize, uint32_t regionCount, bool readable)
+		: m_RegionSize(regionSize), m_Fences(regionCount, nullptr)
+	{
+		// ־ + һӳ䣺дʽˢ£֮ύĻɿ
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		if (readable)
+			flags |= GL_MAP_READ_BIT;
+		GLsizeiptr size = (GLsizeiptr)regionSize * regionCount;
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, size, nullptr, flags);
+		m_MappedData = (uint8_t*)glMapNamedBufferRange(m_RendererID, 0, size, flags);
+		HZ_CORE_ASSERT(m_MappedData, "Failed to map streaming vertex buffer!");
+	}
+
+	OpenGLStreamingVertexBuffer::~OpenGLStreamingVertexBuffer()
+	{
+		for (void* fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync((GLsync)fence);
+		}
+		glUnmapNamedBuffer(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStreamingVertexBuffer::Bind() const
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+	}
+
+	void OpenGLStreamingVertexBuffer::Unbind() const
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	// SetData/SetSubData дڵǰдλ֮󣬺 Map صĵַͬ
+	void OpenGLStreamingVertexBuffer::SetData(const void* data, uint32_t size) const
+	{
+		HZ_CORE_ASSERT(m_Offset + size <= m_RegionSize, "Data size exceeds streaming buffer region!");
+		memcpy(m_MappedData + GetWriteOffset(), data, size);
+	}
+
+	void OpenGLStreamingVertexBuffer::SetSubData(const void* data, uint32_t size, uint32_t offset) const
+	{
+		HZ_CORE_ASSERT(m_Offset + offset + size <= m_RegionSize, "Data size exceeds streaming buffer region!");
+		memcpy(m_MappedData + GetWriteOffset() + offset, data, size);
+	}
+
+	void* OpenGLStreamingVertexBuffer::Map(uint32_t minSize, uint32_t& available)
+	{
+		HZ_CORE_ASSERT(minSize <= m_RegionSize, "Requested size exceeds streaming buffer region!");
+		if (m_Offset + minSize > m_RegionSize)
+			NextRegion();
+
+		void*& fence = m_Fences[m_RegionIndex];
+		if (fence)
+		{
+			// ȲȴزѯһΣδʱˢвͨǼ֡ǰդ
+			GLenum result = glClientWaitSync((GLsync)fence, 0, 0);
+			while (result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1ms
+			glDeleteSync((GLsync)fence);
+			fence = nullptr;
+		}
+
+		available = m_RegionSize - m_Offset;
+		return m_MappedData + GetWriteOffset();
+	}
+
+	uint32_t OpenGLStreamingVertexBuffer::Commit(uint32_t size)
+	{
+		HZ_CORE_ASSERT(m_Offset + size <= m_RegionSize, "Data size exceeds streaming buffer region!");
+		uint32_t offset = GetWriteOffset();
+		m_Offset += size;
+		return offset;
+	}
+
+	void OpenGLStreamingVertexBuffer::EndFrame()
+	{
+		// ֡ûдĻ岻դҲ
+		if (m_Offset > 0)
+			NextRegion();
+	}
+
+	void OpenGLStreamingVertexBuffer::NextRegion()
+	{
+		if (m_Offset > 0)
+			m_Fences[m_RegionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_RegionIndex = (m_RegionIndex + 1) % (uint32_t)m_Fences.size();
+		m_Offset = 0;
+	}
+
 	/* ===================IndexBuffer==================== */
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		: m_Count(count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count, IndexFormat format)
+		: m_Count(count), m_Format(format)
 	{
 		glCreateBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * GetIndexSize(), nullptr, GL_STATIC_DRAW);
+		if (indices)
+			SetSubData(indices, count, 0);
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
@@ -59,6 +161,24 @@ namespace Hazel
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
+	void OpenGLIndexBuffer::SetSubData(const uint32_t* indices, uint32_t count, uint32_t offset)
+	{
+		HZ_CORE_ASSERT(offset + count <= m_Count, "Index data exceeds index buffer!");
+		if (m_Format == IndexFormat::UInt32)
+		{
+			glNamedBufferSubData(m_RendererID, offset * sizeof(uint32_t), count * sizeof(uint32_t), indices);
+			return;
+		}
+
+		std::vector<uint16_t> narrowed(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			HZ_CORE_ASSERT(indices[i] <= UINT16_MAX, "Index does not fit in a 16-bit index buffer!");
+			narrowed[i] = (uint16_t)indices[i];
+		}
+		glNamedBufferSubData(m_RendererID, offset * sizeof(uint16_t), count * sizeof(uint16_t), narrowed.data());
+	}
+
 	void OpenGLIndexBuffer::Bind() const
 	{
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
@@ -15,27 +15,76 @@ namespace Hazel
 		virtual void Unbind() const override;
 
 		void SetData(const void* data, uint32_t size) const override;
+		void SetSubData(const void* data, uint32_t size, uint32_t offset) const override;
 		const BufferLayout& GetLayout() const override { return m_Layout; };
 		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; };
 
+		uint32_t GetRendererID() const override { return m_RendererID; }
+
 	private:
 		uint32_t m_RendererID;
 		BufferLayout m_Layout;
 	};
 
+	class OpenGLStreamingVertexBuffer : public StreamingVertexBuffer
+	{
+	public:
+		OpenGLStreamingVertexBuffer(uint32_t regionSize, uint32_t regionCount, bool readable);
+		virtual ~OpenGLStreamingVertexBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		void SetData(const void* data, uint32_t size) const override;
+		void SetSubData(const void* data, uint32_t size, uint32_t offset) const override;
+		const BufferLayout& GetLayout() const override { return m_Layout; };
+		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; };
+
+		uint32_t GetRendererID() const override { return m_RendererID; }
+
+		void* Map(uint32_t minSize, uint32_t& available) override;
+		uint32_t Commit(uint32_t size) override;
+		void EndFrame() override;
+
+		uint32_t GetRegionIndex() const override { return m_RegionIndex; }
+		uint32_t GetRegionSize() const override { return m_RegionSize; }
+		uint32_t GetWriteOffset() const override { return m_RegionIndex * m_RegionSize + m_Offset; }
+
+	private:
+		// Ϊǰդһ
+		void NextRegion();
+
+	private:
+		uint32_t m_RendererID;
+		BufferLayout m_Layout;
+
+		uint8_t* m_MappedData = nullptr;
+		uint32_t m_RegionSize;
+		uint32_t m_RegionIndex = 0;
+		uint32_t m_Offset = 0;		 // ǰдֽ
+		std::vector<void*> m_Fences; // GLsync
+	};
+
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
 	public:
-		OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
+		OpenGLIndexBuffer(uint32_t* indices, uint32_t count, IndexFormat format);
 		virtual ~OpenGLIndexBuffer();
 
 		virtual void Bind() const;
 		virtual void Unbind() const;
 
 		virtual uint32_t GetCount() const { return m_Count; }
+		virtual IndexFormat GetFormat() const { return m_Format; }
+
+		void SetSubData(const uint32_t* indices, uint32_t count, uint32_t offset) override;
+
+	private:
+		uint32_t GetIndexSize() const { return m_Format == IndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t); }
 
 	private:
 		uint32_t m_RendererID;
 		uint32_t m_Count;
+		IndexFormat m_Format;
 	};
 }
\ No newline at end of file
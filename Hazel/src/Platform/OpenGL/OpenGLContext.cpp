@@ -1,5 +1,6 @@
 #include "hzpch.h"
 #include "OpenGLContext.h"
+#include "OpenGLShader.h"
 
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
@@ -32,6 +33,8 @@ namespace Hazel
 				HZ_CORE_ASSERT((versionMajor > 4 || (versionMajor == 4 && versionMinor >= 5)), 
 					"Hazel requires at least OpenGL Version 4.5!");
 		#endif
+
+		OpenGLShader::InitParallelCompile((void* (*)(const char*))glfwGetProcAddress);
 	}
 
 	void OpenGLContext::SwapBuffers()
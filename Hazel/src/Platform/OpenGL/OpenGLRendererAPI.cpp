@@ -57,11 +57,83 @@ namespace Hazel
 		glClearColor(color.r, color.g, color.b, color.a);
 	}
 
+	static GLenum GetIndexType(const Ref<VertexArray>& vertexArray)
+	{
+		return vertexArray->GetIndexBuffer()->GetFormat() == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
 	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
 	{
 		vertexArray->Bind();
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		glDrawElements(GL_TRIANGLES, count, GetIndexType(vertexArray), nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedBaseVertex(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		vertexArray->Bind();
+		glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GetIndexType(vertexArray), nullptr, baseVertex);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		vertexArray->Bind();
+		// baseInstance ֻƫʵԵĶȡλ
+		glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, indexCount, GetIndexType(vertexArray), nullptr, instanceCount, 0, baseInstance);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex)
+	{
+		vertexArray->Bind();
+		glDrawArrays(GL_LINES, firstVertex, vertexCount);
+	}
+
+	void OpenGLRendererAPI::MultiDrawIndexedIndirect(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& commandBuffer, uint32_t commandOffset, uint32_t drawCount)
+	{
+		vertexArray->Bind();
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer->GetRendererID());
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GetIndexType(vertexArray), (const void*)(uintptr_t)commandOffset, drawCount, sizeof(DrawElementsIndirectCommand));
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
+
+	void OpenGLRendererAPI::BindStorageBuffer(uint32_t binding, const Ref<VertexBuffer>& buffer, uint32_t offset, uint32_t size)
+	{
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, buffer->GetRendererID(), offset, size);
+	}
+
+	void OpenGLRendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		glDispatchCompute(groupsX, groupsY, groupsZ);
+		// ֮ΪԡӻȡCPUͨӳڴض
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+	}
+
+	void OpenGLRendererAPI::SetDepthFunction(DepthFunction function)
+	{
+		glDepthFunc(function == DepthFunction::Equal ? GL_EQUAL : GL_LESS);
+	}
+
+	void OpenGLRendererAPI::SetDepthWrite(bool enabled)
+	{
+		glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
+	void OpenGLRendererAPI::SetColorWrite(bool enabled)
+	{
+		// ɫЧʵID
+		GLboolean mask = enabled ? GL_TRUE : GL_FALSE;
+		glColorMask(mask, mask, mask, mask);
+	}
+
+	void OpenGLRendererAPI::SetBlendMode(BlendMode mode)
+	{
+		if (mode == BlendMode::Additive)
+			glBlendFunc(GL_ONE, GL_ONE);
+		else
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
 }
\ No newline at end of file
@@ -14,5 +14,16 @@ namespace Hazel
 		void Clear() override;
 
 		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		void DrawIndexedBaseVertex(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex) override;
+		void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) override;
+		void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex) override;
+		void MultiDrawIndexedIndirect(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& commandBuffer, uint32_t commandOffset, uint32_t drawCount) override;
+		void BindStorageBuffer(uint32_t binding, const Ref<VertexBuffer>& buffer, uint32_t offset, uint32_t size) override;
+		void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+
+		void SetDepthFunction(DepthFunction function) override;
+		void SetDepthWrite(bool enabled) override;
+		void SetColorWrite(bool enabled) override;
+		void SetBlendMode(BlendMode mode) override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "hzpch.h"
+#include "OpenGLSampleQuery.h"
+
+#include <glad/glad.h>
+
+namespace Hazel
+{
+	OpenGLSampleQuery::OpenGLSampleQuery()
+	{
+		glCreateQueries(GL_SAMPLES_PASSED, 1, &m_RendererID);
+	}
+
+	OpenGLSampleQuery::~OpenGLSampleQuery()
+	{
+		glDeleteQueries(1, &m_RendererID);
+	}
+
+	void OpenGLSampleQuery::Begin()
+	{
+		glBeginQuery(GL_SAMPLES_PASSED, m_RendererID);
+	}
+
+	void OpenGLSampleQuery::End()
+	{
+		glEndQuery(GL_SAMPLES_PASSED);
+	}
+
+	bool OpenGLSampleQuery::TryGetResult(uint64_t& samples)
+	{
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(m_RendererID, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			return false;
+
+		GLuint64 result = 0;
+		glGetQueryObjectui64v(m_RendererID, GL_QUERY_RESULT, &result);
+		samples = result;
+		return true;
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Hazel/Renderer/SampleQuery.h"
+
+namespace Hazel
+{
+	class OpenGLSampleQuery : public SampleQuery
+	{
+	public:
+		OpenGLSampleQuery();
+		virtual ~OpenGLSampleQuery();
+
+		virtual void Begin() override;
+		virtual void End() override;
+
+		virtual bool TryGetResult(uint64_t& samples) override;
+	private:
+		uint32_t m_RendererID;
+	};
+}
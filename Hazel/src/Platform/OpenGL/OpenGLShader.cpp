@@ -1,36 +1,269 @@
 #include "hzpch.h"
 #include "OpenGLShader.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <fstream>
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace Hazel 
 {
+	static bool s_ParallelCompile = false;	// KHR/ARB_parallel_shader_compile ʱѯ״̬ڵһѯʱȴ
+
 	GLenum ShaderTypeFromString(const std::string& type)
 	{
 		if (type == "vertex")
 			return GL_VERTEX_SHADER;
 		else if (type == "fragment" || type == "pixel")
 			return GL_FRAGMENT_SHADER;
+		else if (type == "compute")
+			return GL_COMPUTE_SHADER;
 
 		HZ_CORE_ASSERT(false, "Unknown shader type!");
 		return 0;
 	}
 
-	OpenGLShader::OpenGLShader(const std::string& filepath)
+	namespace Utils
 	{
-		std::string source = ReadFile(filepath);
-		std::unordered_map<GLenum, std::string> shaderSources = PreProcess(source);
-		Compile(shaderSources);
+		// 뷴õ GL Ƿƥ䣻int Ҳ bool Ͳ
+		template<typename T>
+		bool IsUniformType(GLenum type);
+
+		template<>
+		bool IsUniformType<int>(GLenum type)
+		{
+			return type != GL_FLOAT && type != GL_FLOAT_VEC2 && type != GL_FLOAT_VEC3 && type != GL_FLOAT_VEC4
+				&& type != GL_FLOAT_MAT3 && type != GL_FLOAT_MAT4;
+		}
+
+		template<> bool IsUniformType<float>(GLenum type) { return type == GL_FLOAT; }
+		template<> bool IsUniformType<glm::vec2>(GLenum type) { return type == GL_FLOAT_VEC2; }
+		template<> bool IsUniformType<glm::vec3>(GLenum type) { return type == GL_FLOAT_VEC3; }
+		template<> bool IsUniformType<glm::vec4>(GLenum type) { return type == GL_FLOAT_VEC4; }
+		template<> bool IsUniformType<glm::mat4>(GLenum type) { return type == GL_FLOAT_MAT4; }
+
+		// FNV-1a 64 λ
+		static uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		// ׶ΰ̶˳ϣ unordered_map ı˳޹
+		static uint64_t HashSources(const std::unordered_map<GLenum, std::string>& shaderSources)
+		{
+			uint64_t hash = HashBytes(nullptr, 0);
+			for (GLenum type : { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_COMPUTE_SHADER })
+			{
+				auto it = shaderSources.find(type);
+				if (it == shaderSources.end())
+					continue;
+				hash = HashBytes(&type, sizeof(type), hash);
+				hash = HashBytes(it->second.data(), it->second.size(), hash);
+			}
+			return hash;
+		}
+
+		// ֻͬһʹãԿ󻺴ʧЧ
+		static uint64_t GetDriverHash()
+		{
+			uint64_t hash = HashBytes(nullptr, 0);
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				if (value)
+					hash = HashBytes(value, strlen(value), hash);
+			}
+			return hash;
+		}
+
+		static bool IsProgramBinarySupported()
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			return formatCount > 0;
+		}
+
+		//  from һ uniform ĵǰֵ to ĬϿ飬Ԫأ
+		static void CopyUniformValue(GLuint from, GLint fromLocation, GLuint to, GLint toLocation, GLenum type)
+		{
+			switch (type)
+			{
+			case GL_FLOAT:
+			case GL_FLOAT_VEC2:
+			case GL_FLOAT_VEC3:
+			case GL_FLOAT_VEC4:
+			case GL_FLOAT_MAT3:
+			case GL_FLOAT_MAT4:
+			{
+				float value[16] = {};
+				glGetUniformfv(from, fromLocation, value);
+				switch (type)
+				{
+				case GL_FLOAT:		glProgramUniform1fv(to, toLocation, 1, value); break;
+				case GL_FLOAT_VEC2:	glProgramUniform2fv(to, toLocation, 1, value); break;
+				case GL_FLOAT_VEC3:	glProgramUniform3fv(to, toLocation, 1, value); break;
+				case GL_FLOAT_VEC4:	glProgramUniform4fv(to, toLocation, 1, value); break;
+				case GL_FLOAT_MAT3:	glProgramUniformMatrix3fv(to, toLocation, 1, GL_FALSE, value); break;
+				case GL_FLOAT_MAT4:	glProgramUniformMatrix4fv(to, toLocation, 1, GL_FALSE, value); break;
+				}
+				return;
+			}
+			case GL_UNSIGNED_INT:
+			{
+				GLuint value = 0;
+				glGetUniformuiv(from, fromLocation, &value);
+				glProgramUniform1ui(to, toLocation, value);
+				return;
+			}
+			case GL_INT_VEC2:
+			case GL_INT_VEC3:
+			case GL_INT_VEC4:
+			{
+				GLint value[4] = {};
+				glGetUniformiv(from, fromLocation, value);
+				if (type == GL_INT_VEC2)
+					glProgramUniform2iv(to, toLocation, 1, value);
+				else if (type == GL_INT_VEC3)
+					glProgramUniform3iv(to, toLocation, 1, value);
+				else
+					glProgramUniform4iv(to, toLocation, 1, value);
+				return;
+			}
+			default:
+			{
+				// intbool Ͳ
+				GLint value = 0;
+				glGetUniformiv(from, fromLocation, &value);
+				glProgramUniform1i(to, toLocation, value);
+				return;
+			}
+			}
+		}
+
+		static float GetMilliseconds(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	/* ===================ƻ==================== */
+
+	// ļ֣ProgramBinaryHeader֮ glGetProgramBinary 
+	struct ProgramBinaryHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		uint64_t DriverHash;
+		uint32_t BinaryFormat;
+		uint32_t BinarySize;
+	};
+	static_assert(sizeof(ProgramBinaryHeader) == 32, "ProgramBinaryHeader must be tightly packed");
+
+	static constexpr char ProgramBinaryMagic[4] = { 'H', 'Z', 'S', 'B' };
+	static constexpr uint32_t ProgramBinaryVersion = 1;
+
+	static std::filesystem::path GetCachePath(const std::string& name)
+	{
+		return std::filesystem::path(Shader::CacheDirectory) / "opengl" / (name + ".glbin");
+	}
+
+	// һιǰ󶨵ռλ򣺰 Camera 任λãƷɫʵ ID Ϊ -1
+	static GLuint GetPlaceholderProgram()
+	{
+		static GLuint program = 0;
+		if (program != 0)
+			return program;
+
+		const char* vertexSrc = R"(
+			#version 450 core
+			layout(location = 0) in vec3 a_Position;
+			layout(std140, binding = 0) uniform Camera
+			{
+				mat4 u_ViewProjection;
+			};
+			void main()
+			{
+				gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+			}
+		)";
+		const char* fragmentSrc = R"(
+			#version 450 core
+			layout(location = 0) out vec4 o_Color;
+			layout(location = 1) out int o_EntityID;
+			void main()
+			{
+				o_Color = vec4(1.0, 0.0, 1.0, 1.0);
+				o_EntityID = -1;
+			}
+		)";
+
+		program = glCreateProgram();
+		for (auto [type, source] : { std::make_pair(GL_VERTEX_SHADER, vertexSrc), std::make_pair(GL_FRAGMENT_SHADER, fragmentSrc) })
+		{
+			GLuint shader = glCreateShader(type);
+			glShaderSource(shader, 1, &source, nullptr);
+			glCompileShader(shader);
+			glAttachShader(program, shader);
+			glDeleteShader(shader);
+		}
+		glLinkProgram(program);
+		return program;
+	}
+
+	void OpenGLShader::InitParallelCompile(void* (*getProcAddress)(const char*))
+	{
+		const char* function = nullptr;
+		GLint extensionCount = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+		for (GLint i = 0; i < extensionCount && !function; i++)
+		{
+			const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+			if (strcmp(extension, "GL_KHR_parallel_shader_compile") == 0)
+				function = "glMaxShaderCompilerThreadsKHR";
+			else if (strcmp(extension, "GL_ARB_parallel_shader_compile") == 0)
+				function = "glMaxShaderCompilerThreadsARB";
+		}
+
+		s_ParallelCompile = function != nullptr;
+		if (!s_ParallelCompile)
+		{
+			HZ_CORE_INFO("OpenGL: parallel shader compile not supported, shader builds finish on the next poll");
+			return;
+		}
 
+		// 0xFFFFFFFF߳
+		typedef void (APIENTRYP MaxShaderCompilerThreadsFn)(GLuint count);
+		MaxShaderCompilerThreadsFn maxShaderCompilerThreads = (MaxShaderCompilerThreadsFn)getProcAddress(function);
+		if (maxShaderCompilerThreads)
+			maxShaderCompilerThreads(0xFFFFFFFF);
+		HZ_CORE_INFO("OpenGL: parallel shader compile enabled ({0})", function);
+	}
+
+	OpenGLShader::OpenGLShader(const std::string& filepath)
+	{
 		// Extract name from filepath
 		auto lastSlash = filepath.find_last_of("/\\");
 		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
 		auto lastDot = filepath.rfind('.');
 		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
 		m_Name = filepath.substr(lastSlash, count);
+
+		std::string source = ReadFile(filepath);
+		std::unordered_map<GLenum, std::string> shaderSources = PreProcess(source);
+		Load(shaderSources);
 	};
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -39,11 +272,12 @@ namespace Hazel
 		std::unordered_map<GLenum, std::string> sources;
 		sources[GL_VERTEX_SHADER] = vertexSrc;
 		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
-		Compile(sources);
+		Load(sources);
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
+		DiscardPending();
 		glDeleteProgram(m_RendererID);
 	}
 
@@ -97,12 +331,188 @@ namespace Hazel
 		return shaderSources;
 	}
 
-	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
+	void OpenGLShader::Load(const std::unordered_map<GLenum, std::string>& shaderSources)
+	{
+		auto start = std::chrono::steady_clock::now();
+		uint64_t sourceHash = Utils::HashSources(shaderSources);
+
+		const char* missReason = nullptr;
+		if (LoadProgramBinary(GetCachePath(m_Name), sourceHash, missReason))
+		{
+			m_SourceHash = sourceHash;
+			Reflect(0);
+
+			float elapsed = Utils::GetMilliseconds(start);
+			s_LoadStats.CacheHits++;
+			s_LoadStats.LoadTime += elapsed;
+			HZ_CORE_INFO("Shader '{0}': loaded program binary in {1:.2f} ms", m_Name, elapsed);
+			return;
+		}
+
+		Compile(shaderSources, sourceHash, missReason);
+	}
+
+	void OpenGLShader::Reload(const std::string& source)
+	{
+		std::unordered_map<GLenum, std::string> shaderSources = PreProcess(source);
+		if (shaderSources.empty())
+		{
+			HZ_CORE_ERROR("Shader '{0}': no #type found, keeping the current program", m_Name);
+			return;
+		}
+
+		uint64_t sourceHash = Utils::HashSources(shaderSources);
+		if (sourceHash == m_SourceHash && m_Pending.Program == 0)
+			return;
+
+		Compile(shaderSources, sourceHash, "reloaded");
+	}
+
+	bool OpenGLShader::Poll()
+	{
+		if (m_Pending.Program == 0)
+			return false;
+
+		if (s_ParallelCompile)
+		{
+			GLint completed = GL_FALSE;
+			glGetProgramiv(m_Pending.Program, GL_COMPLETION_STATUS_KHR, &completed);
+			if (completed == GL_FALSE)
+				return false;
+		}
+		return FinishCompile();
+	}
+
+	void OpenGLShader::Wait()
+	{
+		if (m_Pending.Program != 0)
+			FinishCompile();
+	}
+
+	void OpenGLShader::DiscardPending()
+	{
+		if (m_Pending.Program == 0)
+			return;
+
+		for (uint32_t i = 0; i < m_Pending.ShaderCount; i++)
+			glDeleteShader(m_Pending.Shaders[i]);
+		glDeleteProgram(m_Pending.Program);
+		m_Pending = {};
+	}
+
+	bool OpenGLShader::LoadProgramBinary(const std::filesystem::path& cachePath, uint64_t sourceHash, const char*& missReason)
+	{
+		if (!Utils::IsProgramBinarySupported())
+		{
+			missReason = "program binaries not supported";
+			return false;
+		}
+
+		std::ifstream stream(cachePath, std::ios::binary);
+		if (!stream)
+		{
+			missReason = "not cached";
+			return false;
+		}
+
+		ProgramBinaryHeader header = {};
+		stream.read((char*)&header, sizeof(header));
+		if (!stream || std::memcmp(header.Magic, ProgramBinaryMagic, sizeof(ProgramBinaryMagic)) != 0 || header.Version != ProgramBinaryVersion)
+		{
+			missReason = "unknown cache format";
+			return false;
+		}
+		if (header.SourceHash != sourceHash)
+		{
+			missReason = "source changed";
+			return false;
+		}
+		if (header.DriverHash != Utils::GetDriverHash())
+		{
+			missReason = "driver changed";
+			return false;
+		}
+
+		std::vector<char> binary(header.BinarySize);
+		stream.read(binary.data(), binary.size());
+		if (!stream)
+		{
+			missReason = "truncated cache";
+			return false;
+		}
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.BinaryFormat, binary.data(), (GLsizei)binary.size());
+
+		// Ծܾκζƣڲ汾仯ʱ˵
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			glDeleteProgram(program);
+			missReason = "binary rejected by driver";
+			return false;
+		}
+
+		m_RendererID = program;
+		return true;
+	}
+
+	void OpenGLShader::SaveProgramBinary(uint32_t program, const std::filesystem::path& cachePath, uint64_t sourceHash)
 	{
+		if (!Utils::IsProgramBinarySupported())
+			return;
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		ProgramBinaryHeader header = {};
+		std::memcpy(header.Magic, ProgramBinaryMagic, sizeof(ProgramBinaryMagic));
+		header.Version = ProgramBinaryVersion;
+		header.SourceHash = sourceHash;
+		header.DriverHash = Utils::GetDriverHash();
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+		header.BinaryFormat = format;
+		header.BinarySize = (uint32_t)length;
+
+		std::error_code error;
+		std::filesystem::create_directories(cachePath.parent_path(), error);
+
+		// дʱļ滻дһʧܲ𻵵Ļ
+		std::filesystem::path tempPath = cachePath;
+		tempPath += ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			stream.write((const char*)&header, sizeof(header));
+			stream.write(binary.data(), header.BinarySize);
+			if (!stream)
+			{
+				HZ_CORE_WARN("Shader '{0}': could not write program binary '{1}'", m_Name, cachePath.string());
+				return;
+			}
+		}
+
+		std::filesystem::rename(tempPath, cachePath, error);
+		if (error)
+			HZ_CORE_WARN("Shader '{0}': could not write program binary '{1}': {2}", m_Name, cachePath.string(), error.message());
+	}
+
+	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources, uint64_t sourceHash, const char* reason)
+	{
+		//  + ƬԪ򵥶һɫ
+		HZ_CORE_ASSERT((shaderSources.size() == 2 || (shaderSources.size() == 1 && shaderSources.count(GL_COMPUTE_SHADER))),
+			"We only support a vertex/fragment pair or a single compute shader for now");
+
+		// һλûɵĹֱӶ
+		DiscardPending();
+
+		// ֻύӣѯ״ֲ̬֧бں̨߳ɣ Poll 
 		GLuint program = glCreateProgram();
-		HZ_CORE_ASSERT((shaderSources.size() == 2), "We only support 2 shaders for now");
-		std::array<GLenum, 2> glShaderIDs;
-		int glShaderIDIndex = 0;
 		for (auto& kv : shaderSources)
 		{
 			GLenum type = kv.first;
@@ -115,65 +525,227 @@ namespace Hazel
 
 			glCompileShader(shader);
 
+			glAttachShader(program, shader);
+			m_Pending.Shaders[m_Pending.ShaderCount++] = shader;
+		}
+
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(program);
+
+		m_Pending.Program = program;
+		m_Pending.SourceHash = sourceHash;
+		m_Pending.Reason = reason;
+		m_Pending.StartTime = std::chrono::steady_clock::now();
+	}
+
+	bool OpenGLShader::FinishCompile()
+	{
+		PendingProgram pending = m_Pending;
+		m_Pending = {};
+		bool initial = m_RendererID == 0;
+
+		bool compiled = true;
+		for (uint32_t i = 0; i < pending.ShaderCount; i++)
+		{
 			GLint isCompiled = 0;
-			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+			glGetShaderiv(pending.Shaders[i], GL_COMPILE_STATUS, &isCompiled);
 			if (isCompiled == GL_FALSE)
 			{
 				GLint maxLength = 0;
-				glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
-
-				std::vector<GLchar> infoLog(maxLength);
-				glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
+				glGetShaderiv(pending.Shaders[i], GL_INFO_LOG_LENGTH, &maxLength);
 
-				glDeleteShader(shader);
+				std::vector<GLchar> infoLog(std::max(maxLength, 1));
+				glGetShaderInfoLog(pending.Shaders[i], (GLsizei)infoLog.size(), &maxLength, &infoLog[0]);
 
-				HZ_CORE_ERROR("{0}", infoLog.data());
-				HZ_CORE_ASSERT(false, "Shader compilation failure!");
-				break;
+				HZ_CORE_ERROR("Shader '{0}': {1}", m_Name, infoLog.data());
+				compiled = false;
 			}
-
-			glAttachShader(program, shader);
-			glShaderIDs[glShaderIDIndex++] = shader;
 		}
 
-		m_RendererID = program;
-
-		// Link our program
-		glLinkProgram(program);
-
 		// Note the different functions here: glGetProgram* instead of glGetShader*.
 		GLint isLinked = 0;
-		glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
-		if (isLinked == GL_FALSE)
+		glGetProgramiv(pending.Program, GL_LINK_STATUS, &isLinked);
+		if (compiled && isLinked == GL_FALSE)
 		{
 			GLint maxLength = 0;
-			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+			glGetProgramiv(pending.Program, GL_INFO_LOG_LENGTH, &maxLength);
 
 			// The maxLength includes the NULL character
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
+			std::vector<GLchar> infoLog(std::max(maxLength, 1));
+			glGetProgramInfoLog(pending.Program, (GLsizei)infoLog.size(), &maxLength, &infoLog[0]);
+
+			HZ_CORE_ERROR("Shader '{0}': {1}", m_Name, infoLog.data());
+		}
+
+		for (uint32_t i = 0; i < pending.ShaderCount; i++)
+		{
+			glDetachShader(pending.Program, pending.Shaders[i]);
+			glDeleteShader(pending.Shaders[i]);
+		}
 
+		if (!compiled || isLinked == GL_FALSE)
+		{
 			// We don't need the program anymore.
-			glDeleteProgram(program);
+			glDeleteProgram(pending.Program);
+
+			// ʧʱɳ򣬸Դٴ±
+			HZ_CORE_ASSERT(!initial, "Shader compilation failure!");
+			if (!initial)
+				HZ_CORE_ERROR("Shader '{0}': reload failed, keeping the previous program", m_Name);
+			return false;
+		}
+
+		// ڿɳ uniform ֵ֮ǰ棬ĳƻϵǰ uniform ֵ
+		SaveProgramBinary(pending.Program, GetCachePath(m_Name), pending.SourceHash);
 
-			for (auto id : glShaderIDs)
-				glDeleteShader(id);
+		// ֮֡任³ͬһ Shader ĳ߶õ³ѷ uniform Ч
+		uint32_t previous = m_RendererID;
+		m_RendererID = pending.Program;
+		m_SourceHash = pending.SourceHash;
+		Reflect(previous);
+		if (previous != 0)
+			glDeleteProgram(previous);
+
+		// ʱύɣбʱȴѯʱ
+		float elapsed = Utils::GetMilliseconds(pending.StartTime);
+		if (initial)
+		{
+			s_LoadStats.CacheMisses++;
+			s_LoadStats.LoadTime += elapsed;
+		}
+		HZ_CORE_INFO("Shader '{0}': compiled in {1:.2f} ms ({2})", m_Name, elapsed, pending.Reason);
+		return true;
+	}
 
-			HZ_CORE_ERROR("{0}", infoLog.data());
-			HZ_CORE_ASSERT(false, "Shader link failure!");
+	void OpenGLShader::Reflect(uint32_t previousProgram)
+	{
+		// ±е uniform ԭ±꣬ѷ UniformHandle Ч³ûе uniform λΪ -1
+		std::vector<UniformInfo> previousUniforms = m_Uniforms;
+		for (UniformInfo& uniform : m_Uniforms)
+		{
+			uniform.Location = -1;
+			uniform.Block = -1;
+			uniform.Offset = -1;
+		}
+		m_UniformBlocks.clear();
+		if (m_RendererID == 0)
 			return;
+
+		auto addUniform = [&](const UniformInfo& uniform)
+		{
+			auto it = m_UniformIndices.find(uniform.Name);
+			if (it == m_UniformIndices.end())
+			{
+				m_UniformIndices[uniform.Name] = (int32_t)m_Uniforms.size();
+				m_Uniforms.push_back(uniform);
+				return (int32_t)m_Uniforms.size() - 1;
+			}
+
+			// أɳùֵ³ʼʱõĲԪ
+			const UniformInfo& previous = previousUniforms[it->second];
+			if (previousProgram != 0 && previous.Location >= 0 && uniform.Location >= 0 && previous.Type == uniform.Type)
+				Utils::CopyUniformValue(previousProgram, previous.Location, m_RendererID, uniform.Location, uniform.Type);
+			m_Uniforms[it->second] = uniform;
+			return it->second;
+		};
+
+		std::vector<GLchar> nameBuffer;
+		auto getResourceName = [&](GLenum programInterface, GLuint index, GLint length)
+		{
+			nameBuffer.resize(std::max(length, 1));
+			glGetProgramResourceName(m_RendererID, programInterface, index, (GLsizei)nameBuffer.size(), nullptr, nameBuffer.data());
+			return std::string(nameBuffer.data());
+		};
+
+		GLint blockCount = 0;
+		glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &blockCount);
+		for (GLint i = 0; i < blockCount; i++)
+		{
+			const GLenum properties[] = { GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+			GLint values[3] = {};
+			glGetProgramResourceiv(m_RendererID, GL_UNIFORM_BLOCK, i, 3, properties, 3, nullptr, values);
+
+			UniformBlockInfo& block = m_UniformBlocks.emplace_back();
+			block.Name = getResourceName(GL_UNIFORM_BLOCK, i, values[0]);
+			block.Binding = values[1];
+			block.Size = values[2];
+
+			// Ⱦÿ֡дһΣֱ Renderer::CameraData һ
+			if (block.Name == "Camera")
+			{
+				HZ_CORE_ASSERT(block.Binding == Renderer::CameraBinding && block.Size == sizeof(Renderer::CameraData),
+					"Camera uniform block layout does not match Renderer::CameraData!");
+			}
 		}
 
-		for (auto id : glShaderIDs)
+		GLint uniformCount = 0;
+		glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+		for (GLint i = 0; i < uniformCount; i++)
 		{
-			glDetachShader(program, id);
-			glDeleteShader(id);
+			const GLenum properties[] = { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE, GL_BLOCK_INDEX, GL_OFFSET };
+			GLint values[6] = {};
+			glGetProgramResourceiv(m_RendererID, GL_UNIFORM, i, 6, properties, 6, nullptr, values);
+			std::string name = getResourceName(GL_UNIFORM, i, values[0]);
+
+			// Աֻ¼ֵ֣ͨ uniform д
+			if (values[4] >= 0)
+			{
+				addUniform({ name, -1, (GLenum)values[1], values[3], values[4], values[5] });
+				continue;
+			}
+
+			//  "u_Textures[0]"ÿԪصǼǣȥ "[0]" ָ 0 Ԫ
+			const std::string arraySuffix = "[0]";
+			if (name.size() > arraySuffix.size() && name.compare(name.size() - arraySuffix.size(), arraySuffix.size(), arraySuffix) == 0)
+			{
+				std::string baseName = name.substr(0, name.size() - arraySuffix.size());
+				for (GLint element = 0; element < values[3]; element++)
+				{
+					std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					GLint location = element == 0 ? values[2] : glGetUniformLocation(m_RendererID, elementName.c_str());
+					int32_t index = addUniform({ elementName, location, (GLenum)values[1], values[3] - element, -1, -1 });
+					if (element == 0)
+						m_UniformIndices[baseName] = index;
+				}
+				continue;
+			}
+
+			addUniform({ name, values[2], (GLenum)values[1], values[3], -1, -1 });
 		}
 	}
 
+	int32_t OpenGLShader::FindUniform(const std::string& name)
+	{
+		// Ҫӽһιûʱȴ
+		if (m_RendererID == 0)
+			Wait();
+
+		auto it = m_UniformIndices.find(name);
+		return it != m_UniformIndices.end() ? it->second : -1;
+	}
+
+	int32_t OpenGLShader::GetUniformLocation(const std::string& name)
+	{
+		int32_t index = FindUniform(name);
+		return index >= 0 ? m_Uniforms[index].Location : -1;
+	}
+
+	template<typename T>
+	int32_t OpenGLShader::GetUniformLocation(UniformHandle<T> uniform) const
+	{
+		if (!uniform.IsValid())
+			return -1;
+
+		HZ_CORE_ASSERT(uniform.Index < (int32_t)m_Uniforms.size(), "Uniform handle does not belong to this shader!");
+		const UniformInfo& info = m_Uniforms[uniform.Index];
+		HZ_CORE_ASSERT(Utils::IsUniformType<T>(info.Type), "Uniform type mismatch!");
+		return info.Location;
+	}
+
 	void OpenGLShader::Bind() const
 	{
-		glUseProgram(m_RendererID);
+		// һιǰռλڼþɳ
+		glUseProgram(m_RendererID != 0 ? m_RendererID : GetPlaceholderProgram());
 	}
 
 	void OpenGLShader::Unbind() const
@@ -183,50 +755,50 @@ namespace Hazel
 
 	void OpenGLShader::UploadUniformInt(const std::string& name, const int& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1i(location, value);
+		GLint location = GetUniformLocation(name);
+		glProgramUniform1i(m_RendererID, location, value);
 	}
 
 	void OpenGLShader::UploadUniformIntArray(const std::string& name, int* values, uint32_t count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1iv(location, count, values);
+		GLint location = GetUniformLocation(name);
+		glProgramUniform1iv(m_RendererID, location, count, values);
 	}
 
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1f(location, value);
+		GLint location = GetUniformLocation(name);
+		glProgramUniform1f(m_RendererID, location, value);
 	}
 
 	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform2f(location, value.x, value.y);
+		GLint location = GetUniformLocation(name);
+		glProgramUniform2f(m_RendererID, location, value.x, value.y);
 	}
 
 	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform3f(location, value.x, value.y, value.z);
+		GLint location = GetUniformLocation(name);
+		glProgramUniform3f(m_RendererID, location, value.x, value.y, value.z);
 	}
 
 	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform4f(location, value.x, value.y, value.z, value.w);
+		GLint location = GetUniformLocation(name);
+		glProgramUniform4f(m_RendererID, location, value.x, value.y, value.z, value.w);
 	}
 
 	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		GLint location = GetUniformLocation(name);
+		glProgramUniformMatrix3fv(m_RendererID, location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		GLint location = GetUniformLocation(name);
+		glProgramUniformMatrix4fv(m_RendererID, location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, int value)
@@ -263,4 +835,34 @@ namespace Hazel
 	{
 		UploadUniformMat4(name, value);
 	}
+
+	void OpenGLShader::Set(UniformHandle<int> uniform, int value)
+	{
+		glProgramUniform1i(m_RendererID, GetUniformLocation(uniform), value);
+	}
+
+	void OpenGLShader::Set(UniformHandle<float> uniform, float value)
+	{
+		glProgramUniform1f(m_RendererID, GetUniformLocation(uniform), value);
+	}
+
+	void OpenGLShader::Set(UniformHandle<glm::vec2> uniform, const glm::vec2& value)
+	{
+		glProgramUniform2f(m_RendererID, GetUniformLocation(uniform), value.x, value.y);
+	}
+
+	void OpenGLShader::Set(UniformHandle<glm::vec3> uniform, const glm::vec3& value)
+	{
+		glProgramUniform3f(m_RendererID, GetUniformLocation(uniform), value.x, value.y, value.z);
+	}
+
+	void OpenGLShader::Set(UniformHandle<glm::vec4> uniform, const glm::vec4& value)
+	{
+		glProgramUniform4f(m_RendererID, GetUniformLocation(uniform), value.x, value.y, value.z, value.w);
+	}
+
+	void OpenGLShader::Set(UniformHandle<glm::mat4> uniform, const glm::mat4& value)
+	{
+		glProgramUniformMatrix4fv(m_RendererID, GetUniformLocation(uniform), 1, GL_FALSE, glm::value_ptr(value));
+	}
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "Hazel/Renderer/Shader.h"
 #include <glm/glm.hpp>
 
+#include <filesystem>
+#include <chrono>
+
 // TODO: REMOVE!
 typedef unsigned int GLenum;
 
@@ -20,6 +23,13 @@ namespace Hazel
 
 		const std::string& GetName() const override { return m_Name; }
 
+		bool IsReady() const override { return m_RendererID != 0; }
+		bool Poll() override;
+		void Reload(const std::string& source) override;
+
+		//  glad ֮ã KHR/ARB_parallel_shader_compileʱں̨̱߳
+		static void InitParallelCompile(void* (*getProcAddress)(const char*));
+
 		void UploadUniformInt(const std::string& name, const int& value);
 		void UploadUniformIntArray(const std::string& name, int* values, uint32_t count);
 		void UploadUniformFloat(const std::string& name, float value);
@@ -37,13 +47,68 @@ namespace Hazel
 		void SetFloat4(const std::string& name, const glm::vec4& value) override;
 		void SetMat4(const std::string& name, const glm::mat4& value) override;
 
+		void Set(UniformHandle<int> uniform, int value) override;
+		void Set(UniformHandle<float> uniform, float value) override;
+		void Set(UniformHandle<glm::vec2> uniform, const glm::vec2& value) override;
+		void Set(UniformHandle<glm::vec3> uniform, const glm::vec3& value) override;
+		void Set(UniformHandle<glm::vec4> uniform, const glm::vec4& value) override;
+		void Set(UniformHandle<glm::mat4> uniform, const glm::mat4& value) override;
+
+	protected:
+		int32_t FindUniform(const std::string& name) override;
+
 	private:
 		std::string ReadFile(const std::string& filepath);										//ļһַвԹʹ
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
-		void Compile(const std::unordered_map<GLenum, std::string>& shaderSource);
+		void Load(const std::unordered_map<GLenum, std::string>& shaderSources);					//ȳԶȡƻ棬δʱʼ
+		void Compile(const std::unordered_map<GLenum, std::string>& shaderSources, uint64_t sourceHash, const char* reason);	//ֻύӣȴ
+		bool FinishCompile();																	//ɹʱ³д뻺
+		void Wait();
+		void DiscardPending();
+		bool LoadProgramBinary(const std::filesystem::path& cachePath, uint64_t sourceHash, const char*& missReason);
+		void SaveProgramBinary(uint32_t program, const std::filesystem::path& cachePath, uint64_t sourceHash);
+		void Reflect(uint32_t previousProgram);													//Ӻ uniform  uniform 飬 uniform 
+
+		int32_t GetUniformLocation(const std::string& name);
+		template<typename T>
+		int32_t GetUniformLocation(UniformHandle<T> uniform) const;
 
 	private:
-		uint32_t m_RendererID;
+		// uniform еһÿԪظռһ
+		struct UniformInfo
+		{
+			std::string Name;
+			int32_t Location;	// uniform Աû locationΪ -1
+			GLenum Type;
+			int32_t Count;		// ӸԪصĩβԪظ
+			int32_t Block;		//  uniform  m_UniformBlocks е±꣬ĬϿΪ -1
+			int32_t Offset;		// ֽƫƣstd140ĬϿΪ -1
+		};
+
+		struct UniformBlockInfo
+		{
+			std::string Name;
+			int32_t Binding;
+			int32_t Size;
+		};
+
+		// ڱӵĳɺ m_RendererID
+		struct PendingProgram
+		{
+			uint32_t Program = 0;
+			std::array<uint32_t, 2> Shaders = {};
+			uint32_t ShaderCount = 0;
+			uint64_t SourceHash = 0;
+			const char* Reason = nullptr;	// ԭд־
+			std::chrono::steady_clock::time_point StartTime;
+		};
+
+		uint32_t m_RendererID = 0;
+		uint64_t m_SourceHash = 0;
+		PendingProgram m_Pending;
 		std::string m_Name;
+		std::vector<UniformInfo> m_Uniforms;
+		std::vector<UniformBlockInfo> m_UniformBlocks;
+		std::unordered_map<std::string, int32_t> m_UniformIndices;	//  -> m_Uniforms ±
 	};
 }
\ No newline at end of file
@@ -6,16 +6,27 @@
 
 namespace Hazel 
 {
-	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
-		: m_Width(width), m_Height(height)
+	// ɨ RGBA ص alpha ͨ
+	static bool ContainsTranslucentPixels(const uint8_t* data, uint32_t pixelCount)
+	{
+		for (uint32_t i = 0; i < pixelCount; i++)
+		{
+			if (data[i * 4 + 3] != 0xFF)
+				return true;
+		}
+		return false;
+	}
+
+	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, uint32_t mipLevels)
+		: m_Width(width), m_Height(height), m_MipLevels(mipLevels)
 	{
 		m_InternalFormat = GL_RGBA8;
 		m_DataFormat = GL_RGBA;
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);	
+		glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width, m_Height);	
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -65,6 +76,9 @@ namespace Hazel
 
 			glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
 
+			if (channels == 4)
+				m_HasTranslucency = ContainsTranslucentPixels(data, m_Width * m_Height);
+
 			stbi_image_free(data);
 		}
 	}
@@ -79,10 +93,97 @@ namespace Hazel
 		uint32_t bpp = (m_DataFormat == GL_RGBA ? 4 : 3);
 		HZ_CORE_ASSERT((size == m_Width * m_Height * bpp), "Data must contain the full texture! Please check that the size of the data matches the format of the data");
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		m_Revision++;
+
+		m_HasTranslucency = bpp == 4 && ContainsTranslucentPixels((const uint8_t*)data, m_Width * m_Height);
+	}
+
+	void OpenGLTexture2D::SetSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		HZ_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region is out of the texture bounds!");
+		glTextureSubImage2D(m_RendererID, 0, x, y, width, height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		m_Revision++;
+
+		if (m_DataFormat == GL_RGBA && !m_HasTranslucency)
+			m_HasTranslucency = ContainsTranslucentPixels((const uint8_t*)data, width * height);
+	}
+
+	void OpenGLTexture2D::GenerateMipmaps()
+	{
+		if (m_MipLevels > 1)
+		{
+			glGenerateTextureMipmap(m_RendererID);
+			m_Revision++;
+		}
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		glBindTextureUnit(slot, m_RendererID);
 	}
+
+	/* ===================Texture2DArray==================== */
+
+	OpenGLTexture2DArray::OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t format, uint32_t mipLevels, uint32_t layerCount)
+		: m_Width(width), m_Height(height), m_MipLevels(mipLevels), m_LayerCount(layerCount), m_InternalFormat(format)
+	{
+		m_RendererID = CreateStorage(m_LayerCount);
+	}
+
+	OpenGLTexture2DArray::~OpenGLTexture2DArray()
+	{
+		glDeleteTextures(1, &m_RendererID);
+	}
+
+	uint32_t OpenGLTexture2DArray::CreateStorage(uint32_t layerCount) const
+	{
+		uint32_t rendererID;
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &rendererID);
+		glTextureStorage3D(rendererID, m_MipLevels, m_InternalFormat, m_Width, m_Height, layerCount);
+
+		//  OpenGLTexture2D Ĳһ
+		glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		return rendererID;
+	}
+
+	void OpenGLTexture2DArray::Resize(uint32_t layerCount)
+	{
+		if (layerCount <= m_LayerCount)
+			return;
+
+		// 洢ɱ䣬½鲢GPUϸеĲ
+		uint32_t rendererID = CreateStorage(layerCount);
+		for (uint32_t level = 0; level < m_MipLevels; level++)
+		{
+			glCopyImageSubData(m_RendererID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+				rendererID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+				std::max(m_Width >> level, 1u), std::max(m_Height >> level, 1u), m_LayerCount);
+		}
+		glDeleteTextures(1, &m_RendererID);
+
+		m_RendererID = rendererID;
+		m_LayerCount = layerCount;
+	}
+
+	void OpenGLTexture2DArray::CopyToLayer(uint32_t layer, const Ref<Texture2D>& texture)
+	{
+		HZ_CORE_ASSERT(layer < m_LayerCount, "Texture array layer out of range!");
+		HZ_CORE_ASSERT(texture->GetWidth() == m_Width && texture->GetHeight() == m_Height && texture->GetFormat() == m_InternalFormat
+			&& texture->GetMipLevelCount() == m_MipLevels, "Texture does not match the texture array!");
+
+		for (uint32_t level = 0; level < m_MipLevels; level++)
+		{
+			glCopyImageSubData(texture->GetRendererID(), GL_TEXTURE_2D, level, 0, 0, 0,
+				m_RendererID, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+				std::max(m_Width >> level, 1u), std::max(m_Height >> level, 1u), 1);
+		}
+	}
+
+	void OpenGLTexture2DArray::Bind(uint32_t slot) const
+	{
+		glBindTextureUnit(slot, m_RendererID);
+	}
 }
\ No newline at end of file
@@ -9,20 +9,26 @@ namespace Hazel
 	class OpenGLTexture2D : public Texture2D
 	{
 	public:
-		OpenGLTexture2D(uint32_t width, uint32_t height);
+		OpenGLTexture2D(uint32_t width, uint32_t height, uint32_t mipLevels = 1);
 		OpenGLTexture2D(const std::string& path);
 		~OpenGLTexture2D();
 
 		uint32_t GetWidth() const override { return m_Width; }
 		uint32_t GetHeight() const override { return m_Height; }
 		uint32_t GetRendererID() const override { return m_RendererID; }
+		uint32_t GetFormat() const override { return m_InternalFormat; }
 		const std::string& GetPath() const override { return m_Path; }
+		uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+		uint32_t GetRevision() const override { return m_Revision; }
 
 		void SetData(void* data, uint32_t size) override;
+		void SetSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		void GenerateMipmaps() override;
 
 		void Bind(uint32_t slot = 0) const override;
 
 		bool IsLoaded() const override { return m_IsLoaded; }
+		bool HasTranslucency() const override { return m_HasTranslucency; }
 
 		bool operator==(const Texture& other) const override
 		{
@@ -32,12 +38,46 @@ namespace Hazel
 	private:
 		std::string m_Path;
 		bool m_IsLoaded = false;
+		bool m_HasTranslucency = false;
 
 		uint32_t m_Width;
 		uint32_t m_Height;
+		uint32_t m_MipLevels = 1;
+		uint32_t m_Revision = 0;
 		uint32_t m_RendererID;
 
 		GLenum m_InternalFormat, m_DataFormat;
 	};
 
+	class OpenGLTexture2DArray : public Texture2DArray
+	{
+	public:
+		OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t format, uint32_t mipLevels, uint32_t layerCount);
+		~OpenGLTexture2DArray();
+
+		uint32_t GetWidth() const override { return m_Width; }
+		uint32_t GetHeight() const override { return m_Height; }
+		uint32_t GetFormat() const override { return m_InternalFormat; }
+		uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+		uint32_t GetLayerCount() const override { return m_LayerCount; }
+		uint32_t GetRendererID() const override { return m_RendererID; }
+
+		void Resize(uint32_t layerCount) override;
+		void CopyToLayer(uint32_t layer, const Ref<Texture2D>& texture) override;
+
+		void Bind(uint32_t slot = 0) const override;
+
+	private:
+		uint32_t CreateStorage(uint32_t layerCount) const;
+
+	private:
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_MipLevels;
+		uint32_t m_LayerCount;
+		uint32_t m_RendererID;
+
+		GLenum m_InternalFormat;
+	};
+
 }
\ No newline at end of file
@@ -20,6 +20,11 @@ namespace Hazel
 			case ShaderDataType::Int3:     return GL_INT;
 			case ShaderDataType::Int4:     return GL_INT;
 			case ShaderDataType::Bool:     return GL_BOOL;
+			case ShaderDataType::Half:     return GL_HALF_FLOAT;
+			case ShaderDataType::Half2:    return GL_HALF_FLOAT;
+			case ShaderDataType::Half4:    return GL_HALF_FLOAT;
+			case ShaderDataType::UByte4:   return GL_UNSIGNED_BYTE;
+			case ShaderDataType::UShort:   return GL_UNSIGNED_SHORT;
 		}
 		return 0;
 	}
@@ -60,6 +65,11 @@ namespace Hazel
 			case ShaderDataType::Float2:
 			case ShaderDataType::Float3:
 			case ShaderDataType::Float4:
+			case ShaderDataType::Half:
+			case ShaderDataType::Half2:
+			case ShaderDataType::Half4:
+			case ShaderDataType::UByte4:
+			case ShaderDataType::UShort:
 			{
 				glEnableVertexAttribArray(m_VertexBufferIndex);
 				glVertexAttribPointer(m_VertexBufferIndex,
@@ -68,6 +78,8 @@ namespace Hazel
 					element.Normalized ? GL_TRUE : GL_FALSE,
 					layout.GetStride(),
 					(const void*)element.Offset);
+				if (layout.GetDivisor())
+					glVertexAttribDivisor(m_VertexBufferIndex, layout.GetDivisor());
 				m_VertexBufferIndex++;
 				break;
 			}
@@ -83,6 +95,8 @@ namespace Hazel
 					ShaderDataTypeToOpenGLBaseType(element.Type),
 					layout.GetStride(),
 					(const void*)element.Offset);
+				if (layout.GetDivisor())
+					glVertexAttribDivisor(m_VertexBufferIndex, layout.GetDivisor());
 				m_VertexBufferIndex++;
 				break;
 			}